@@ -79,6 +79,24 @@ int cg_get_num_edges(ColouredGraph graph);
  */
 bool cg_is_edge(ColouredGraph graph, int source, int target);
 
+/**
+ * @brief Gets the number of neighbours of @p node in @p graph.
+ *
+ * @param graph A ColouredGraph.
+ * @param node A node.
+ * @return int Its number of neighbours.
+ */
+int cg_get_num_neighbours(ColouredGraph graph, int node);
+
+/**
+ * @brief Gets the neighbours of @p node in @p graph, sorted increasingly. The array has size cg_get_num_neighbours(@p graph, @p node) and must not be modified.
+ *
+ * @param graph A ColouredGraph.
+ * @param node A node.
+ * @return int* Its neighbours.
+ */
+int *cg_get_neighbours(ColouredGraph graph, int node);
+
 /**
  * @brief Gets the name of @p node in @p graph. The name is what appears in the .dot file, while its number is local to this program.
  *
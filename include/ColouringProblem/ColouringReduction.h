@@ -15,6 +15,7 @@
 
 #include "Graph.h"
 #include "ColouredGraph.h"
+#include "SATSolver.h"
 #include <z3.h>
 
 /**
@@ -52,4 +53,35 @@ void colour_graph_from_model(Z3_context ctx, Z3_model model, ColouredGraph graph
  */
 void colouring_print_model(Z3_context ctx, Z3_model model, ColouredGraph graph, int num_colours);
 
+/**
+ * @brief Same as colouring_reduction, written directly as clauses of @p solver: a variable per pair node, colour (the variable of the colour c of the node n is the returned variable + n * @p num_colours + c), exactly one colour per node and the two ends of each edge not of the same colour.
+ *
+ * @param solver A solver created by cnf_create_solver.
+ * @param graph A ColouredGraph.
+ * @param num_colours The number of colours available for colouring the graph.
+ * @return int The variable of the colour 0 of the node 0.
+ * @pre @p graph must be initialized.
+ */
+int colouring_reduction_cnf(SatSolver solver, const ColouredGraph graph, int num_colours);
+
+/**
+ * @brief Colours @p graph according to the model found by @p solver for the clauses of colouring_reduction_cnf.
+ *
+ * @param solver A solver whose last call to sat_solve returned true.
+ * @param first_variable The variable returned by colouring_reduction_cnf.
+ * @param graph A ColouredGraph.
+ * @param num_colours The number of expected colours.
+ */
+void colour_graph_from_solver(SatSolver solver, int first_variable, ColouredGraph graph, int num_colours);
+
+/**
+ * @brief Same as colouring_print_model, for the model found by @p solver for the clauses of colouring_reduction_cnf.
+ *
+ * @param solver A solver whose last call to sat_solve returned true.
+ * @param first_variable The variable returned by colouring_reduction_cnf.
+ * @param graph A ColouredGraph.
+ * @param num_colours The number of expected colours.
+ */
+void colouring_print_solver_model(SatSolver solver, int first_variable, ColouredGraph graph, int num_colours);
+
 #endif
\ No newline at end of file
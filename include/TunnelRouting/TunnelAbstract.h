@@ -0,0 +1,81 @@
+/**
+ * @file TunnelAbstract.h
+ * @brief An abstract interpretation of the stack along the paths of a Tunnel Network. The stack is abstracted by its top symbol and the symbol just below it (or the fact that the top is the bottom cell), which is all the information an action reads.
+ * A forward dataflow analysis from the initial node computes the abstract stacks possible when entering each node. The actions that are never enabled and the edges that never lead to an enabled action (or to the end of a path) are then useless for every algorithm.
+ * @version 1
+ * @date 2026-10-17
+ *
+ * @copyright Creative Commons
+ *
+ */
+
+#ifndef TUNNEL_ABSTRACT_H
+#define TUNNEL_ABSTRACT_H
+
+#include "TunnelNetwork.h"
+
+/**
+ * @brief An abstract stack: the top symbol (0 for 4, 1 for 6) and what is below it (0 if the top is the bottom cell, 1 for 4, 2 for 6), encoded as 3 * top + below. The initial stack is tn_abstract_state(0, 0).
+ *
+ */
+#define tn_abstract_state(top, below) (3 * (top) + (below))
+
+/**
+ * @brief Number of abstract stacks.
+ *
+ */
+#define NumAbstractStates 6
+
+/**
+ * @brief The result of the analysis of a network.
+ *
+ */
+typedef struct TunnelAbstraction_s *TunnelAbstraction;
+
+/**
+ * @brief Analyses @p network, restricted to the nodes @p node such that @p kept[node] is true. The abstract stacks at entry of the nodes are computed up to a fixpoint from the initial stack at the initial node, and the useful abstract stacks of the nodes (the ones from which the final node can be reached with the initial stack) up to a fixpoint backward from the final node. An action of u is then enabled if it leads from a stack at entry of u to a useful stack of one of its successors, and an edge is enabled if such an action can follow it.
+ *
+ * @param network The network.
+ * @param kept An array of size tn_get_num_nodes(@p network), or NULL to keep all the nodes.
+ * @return TunnelAbstraction The analysis (where nothing is enabled if @p network has no node), to be freed with tn_abstract_delete.
+ * @pre @p network must be an initialized TunnelNetwork.
+ */
+TunnelAbstraction tn_abstract_analyse(TunnelNetwork network, bool *kept);
+
+/**
+ * @brief Frees @p abstraction.
+ *
+ * @param abstraction
+ */
+void tn_abstract_delete(TunnelAbstraction abstraction);
+
+/**
+ * @brief Gets the abstract stacks possible at entry of @p node.
+ *
+ * @param abstraction
+ * @param node
+ * @return int A mask (bit tn_abstract_state(top, below) set for each possible abstract stack).
+ */
+int tn_abstract_get_entry_states(TunnelAbstraction abstraction, int node);
+
+/**
+ * @brief Gets the enabled actions of @p node.
+ *
+ * @param abstraction
+ * @param node
+ * @return int A mask of actions, included in tn_get_actions(network, @p node).
+ */
+int tn_abstract_get_enabled_actions(TunnelAbstraction abstraction, int node);
+
+/**
+ * @brief Tells if the edge from @p node to its successor number @p index (in tn_get_successors) is enabled.
+ *
+ * @param abstraction
+ * @param node
+ * @param index Between 0 and tn_get_num_successors(network, @p node)-1.
+ * @return true If the edge may be used by a path.
+ * @return false If no path can use it.
+ */
+bool tn_abstract_is_edge_enabled(TunnelAbstraction abstraction, int node, int index);
+
+#endif
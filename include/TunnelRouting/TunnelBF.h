@@ -27,4 +27,52 @@
  */
 int tn_brute_force(TunnelNetwork network, int length, tn_step *path);
 
+/**
+ * @brief Parallel version of tn_brute_force with @p num_threads threads. The search tree is split at a shallow depth into tasks (a prefix of the path and the stack after it), dealt to per-thread queues from which idle threads steal. The path returned is the one tn_brute_force would return (the first one in its exploration order), whatever the scheduling: a thread stops as soon as a task explored before its own has found a path.
+ *
+ * @param network The network.
+ * @param length The max length of the path sought
+ * @param path Array to return a path if one is found.
+ * @param num_threads The number of threads. With 1 or less, tn_brute_force is called.
+ * @return int The length of the path found. Returns 0 if no path has been found.
+ * @pre @p path must be an array of size at least @p length.
+ * @pre @p network must be an initialized TunnelNetwork.
+ * @post @p path contains the path found from cell 0 to returned value -1.
+ */
+int tn_brute_force_parallel(TunnelNetwork network, int length, tn_step *path, int num_threads);
+
+/**
+ * @brief Brute force that finds, in a single traversal of the paths of length at most @p length, every length at which there is a valid simple path in @p network. For each such length l, the first path of length l met is stored in @p paths[l] (it is the one tn_brute_force would return for l). The traversal stops early once every length has a path, and skips the subtrees that can only lead to lengths already found.
+ *
+ * @param network The network.
+ * @param length The max length of the paths sought.
+ * @param paths An array of @p length + 1 arrays, @p paths[l] receiving the path of length l.
+ * @param found An array of size @p length + 1, @p found[l] is set to true if there is a valid path of length l, false otherwise.
+ * @return int The smallest length of a valid path. Returns 0 if no path has been found.
+ * @pre @p paths[l] must be an array of size at least l, for l from 1 to @p length.
+ * @pre @p network must be an initialized TunnelNetwork.
+ */
+int tn_brute_force_all_lengths(TunnelNetwork network, int length, tn_step **paths, bool *found);
+
+/**
+ * @brief Enumerates the valid simple paths of length at most @p length in @p network, by increasing length and in the order of tn_brute_force for each length. Each path is given to @p callback as soon as it is found, and the search goes on from there: only the current path is stored, so the first paths are available immediately whatever the number of paths.
+ *
+ * @param network The network.
+ * @param length The max length of the paths sought.
+ * @param max_paths The max number of paths given to @p callback.
+ * @param callback The function receiving the paths. The enumeration stops when it returns false.
+ * @param data Given to @p callback.
+ * @return int The number of paths given to @p callback.
+ * @pre @p network must be an initialized TunnelNetwork.
+ */
+int tn_brute_force_enumerate(TunnelNetwork network, int length, int max_paths, tn_path_callback callback, void *data);
+
+/**
+ * @brief Gets the numbers of subtrees cut by the last call to tn_brute_force, tn_brute_force_parallel, tn_brute_force_all_lengths or tn_brute_force_enumerate. A subtree is cut as soon as the steps left are fewer than the distance from its node to the final node (computed once by a backward breadth-first search), or fewer than the number of cells above the bottom of the stack (which must all be popped).
+ *
+ * @param distance_cuts Set to the number of subtrees cut because the final node is too far.
+ * @param stack_cuts Set to the number of subtrees cut because the stack cannot be emptied in time.
+ */
+void tn_brute_force_get_cuts(long *distance_cuts, long *stack_cuts);
+
 #endif
\ No newline at end of file
@@ -0,0 +1,29 @@
+/**
+ * @file TunnelBFS.h
+ * @brief A breadth-first search on the configurations (node, stack) of a Tunnel Network. The configurations reached after the same number of steps are stored once, whatever the number of paths reaching them.
+ * @version 1
+ * @date 2026-10-17
+ *
+ * @copyright Creative Commons
+ *
+ */
+
+#ifndef TUNNEL_BFS_H
+#define TUNNEL_BFS_H
+
+#include "TunnelNetwork.h"
+
+/**
+ * @brief Decides if there is a valid simple path of length at most @p length in @p network, by expanding the configurations position after position. Each layer is deduplicated on (node, height, stack content), and each configuration keeps its parent to rebuild the path. If there is such a path, a shortest one will be present in @p path after the call, otherwise, path is not modified.
+ *
+ * @param network The network.
+ * @param length The max length of the path sought
+ * @param path Array to return a path if one is found.
+ * @return int The length of the path found (the shortest valid length). Returns 0 if no path has been found.
+ * @pre @p path must be an array of size at least @p length.
+ * @pre @p network must be an initialized TunnelNetwork.
+ * @post @p path contains the path found from cell 0 to returned value -1.
+ */
+int tn_bfs(TunnelNetwork network, int length, tn_step *path);
+
+#endif
@@ -0,0 +1,51 @@
+/**
+ * @file TunnelBatch.h
+ * @brief Answers many (initial, final, max size) questions on the same Tunnel Network. The network is built once, and the questions sharing an initial node share a single exploration of the configurations reachable from it (see TunnelReach.h).
+ * @version 1
+ * @date 2026-10-17
+ *
+ * @copyright Creative Commons
+ *
+ */
+
+#ifndef TUNNEL_BATCH_H
+#define TUNNEL_BATCH_H
+
+#include "TunnelNetwork.h"
+
+/**
+ * @brief A question on a network: is there a valid simple path of size at most length from initial to final?
+ *
+ */
+typedef struct
+{
+    int initial; ///< The node where the path starts.
+    int final;   ///< The node where the path ends.
+    int length;  ///< The max size of the path.
+} tn_query;
+
+/**
+ * @brief Reads the questions of the file @p file_name. Each line holds the name of the initial node, the name of the final node and the max size, separated by spaces. The empty lines and the ones starting with '#' are ignored, and the ones naming an unknown node or not following this format are reported and ignored.
+ *
+ * @param network The network the questions are about.
+ * @param file_name The name of the file.
+ * @param queries Set to an array of the questions read, to be freed with free.
+ * @return int The number of questions read, -1 if the file could not be opened (@p queries is then not modified).
+ */
+int tn_batch_read_queries(TunnelNetwork network, char *file_name, tn_query **queries);
+
+/**
+ * @brief Answers the questions @p queries on @p network. The questions are grouped by initial node, and each group is answered with one exploration of the configurations reachable from its initial node in at most the largest size of the group (tn_reach_create), which gives a shortest valid path to every node at once. Only one exploration is kept in memory at a time. The initial and final nodes of @p network are ignored.
+ *
+ * @param network The network.
+ * @param queries The questions.
+ * @param num_queries The number of questions.
+ * @param results Set to the size of the shortest valid path of each question, 0 if it has none of size at most its max size.
+ * @param paths If not NULL, paths[i] receives a shortest valid path of the question i if there is one.
+ * @return int The number of explorations done (the number of distinct initial nodes).
+ * @pre @p results must be an array of size @p num_queries, and paths[i] of size at least @p queries[i].length.
+ * @pre @p network must be an initialized TunnelNetwork.
+ */
+int tn_batch_solve(TunnelNetwork network, tn_query *queries, int num_queries, int *results, tn_step **paths);
+
+#endif
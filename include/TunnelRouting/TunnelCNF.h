@@ -0,0 +1,120 @@
+/**
+ * @file TunnelCNF.h
+ * @brief The reduction of TunnelReduction.h written directly as clauses of the solver of SATSolver.h (see CNF.h), without building a Z3 formula. The variables and the
+ *        constraints are the same: each family of constraints is emitted position by position, so that a single solver can also be used for all the sizes (the final
+ *        condition of each size being guarded by an assumption literal, as with tn_incremental_create).
+ *        The only difference is in the action constraints: each conjunction "the cells read and written by an action at a position and a height" gets its own
+ *        variable (which implies the conjunction), shared by all the nodes having this action, so that each constraint is a single clause.
+ * @version 1
+ * @date 2026-10-17
+ *
+ * @copyright Creative Commons
+ *
+ */
+
+#ifndef TUNNEL_CNF_H
+#define TUNNEL_CNF_H
+
+#include "TunnelNetwork.h"
+#include "TunnelReduction.h"
+#include "SATSolver.h"
+
+/**
+ * @brief The variables of the reduction and the solver containing its clauses.
+ *
+ */
+typedef struct TunnelCNF_s *TunnelCNF;
+
+/**
+ * @brief Creates a solver containing the clauses of the reduction for the paths of size exactly @p length in @p network.
+ *
+ * @param network A Tunnel Network.
+ * @param length The size of the target path.
+ * @param encoding The encoding of the uniqueness constraints.
+ * @return TunnelCNF To be freed with tn_cnf_delete.
+ * @pre @p network must be initialized.
+ */
+TunnelCNF tn_cnf_create(TunnelNetwork network, int length, tn_encoding encoding);
+
+/**
+ * @brief Creates a single solver for the paths of size at most @p bound in @p network (the counterpart of tn_incremental_create). Only the initial condition is added: the constraints of the positions and the final condition of each size are added by tn_cnf_add_length.
+ *
+ * @param network A Tunnel Network.
+ * @param bound The largest size of path that will be asked.
+ * @param encoding The encoding of the uniqueness constraints.
+ * @return TunnelCNF To be freed with tn_cnf_delete.
+ * @pre @p network must be initialized.
+ */
+TunnelCNF tn_cnf_incremental_create(TunnelNetwork network, int bound, tn_encoding encoding);
+
+/**
+ * @brief Adds to @p cnf the clauses of the positions up to @p length that are not added yet, and the final condition of @p length guarded by its assumption literal (does nothing for a solver created by tn_cnf_create).
+ *
+ * @param cnf
+ * @param length A size of path, at most the bound of @p cnf (equal to it for a solver created by tn_cnf_create).
+ */
+void tn_cnf_add_length(TunnelCNF cnf, int length);
+
+/**
+ * @brief Checks if there is a well-formed path of size @p length (calls tn_cnf_add_length first). With a solver created by tn_cnf_incremental_create, the final condition of @p length is an assumption, and its negation is added if there is no path.
+ *
+ * @param cnf
+ * @param length A size of path, at most the bound of @p cnf (equal to it for a solver created by tn_cnf_create).
+ * @return true if there is a path (it can then be read with tn_cnf_get_path), false otherwise.
+ */
+bool tn_cnf_solve(TunnelCNF cnf, int length);
+
+/**
+ * @brief Gets the well-formed path of size @p length found by the last call to tn_cnf_solve.
+ *
+ * @param cnf
+ * @param length The size of the path.
+ * @param path The path
+ * @pre @p path must be an array of size @p length+1.
+ */
+void tn_cnf_get_path(TunnelCNF cnf, int length, tn_step *path);
+
+/**
+ * @brief Prints, as tn_print_model, the positions 0 to @p length of the model found by the last call to tn_cnf_solve.
+ *
+ * @param cnf
+ * @param length The size of the path.
+ */
+void tn_cnf_print_model(TunnelCNF cnf, int length);
+
+/**
+ * @brief Forbids the path @p path of size @p length, as tn_incremental_block_path.
+ *
+ * @param cnf
+ * @param length The size of the path.
+ * @param path A path given by tn_cnf_get_path for @p length.
+ */
+void tn_cnf_block_path(TunnelCNF cnf, int length, tn_step *path);
+
+/**
+ * @brief Enumerates the distinct valid paths of size at most the bound of @p cnf by increasing size, as tn_incremental_enumerate.
+ *
+ * @param cnf A solver created by tn_cnf_incremental_create.
+ * @param max_paths The max number of paths given to @p callback.
+ * @param callback The function receiving the paths. The enumeration stops when it returns false.
+ * @param data Given to @p callback.
+ * @return int The number of paths given to @p callback.
+ */
+int tn_cnf_enumerate(TunnelCNF cnf, int max_paths, tn_path_callback callback, void *data);
+
+/**
+ * @brief Gets the solver containing the clauses of @p cnf (to write them or read its statistics).
+ *
+ * @param cnf
+ * @return SatSolver
+ */
+SatSolver tn_cnf_get_solver(TunnelCNF cnf);
+
+/**
+ * @brief Frees @p cnf and its solver.
+ *
+ * @param cnf
+ */
+void tn_cnf_delete(TunnelCNF cnf);
+
+#endif
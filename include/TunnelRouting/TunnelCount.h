@@ -0,0 +1,54 @@
+/**
+ * @file TunnelCount.h
+ * @brief Counting of the valid paths of a Tunnel Network, for each length up to a bound. The paths are never enumerated: they are counted by dynamic programming, either over the summaries of the network (the well-nested segments between two nodes) or over the configurations (node, stack) reached position by position.
+ * @version 1
+ * @date 2026-10-17
+ *
+ * @copyright Creative Commons
+ *
+ */
+
+#ifndef TUNNEL_COUNT_H
+#define TUNNEL_COUNT_H
+
+#include "TunnelNetwork.h"
+
+/**
+ * @brief A number of paths. The additions saturate at TN_COUNT_MAX instead of wrapping around.
+ *
+ */
+typedef unsigned __int128 tn_count;
+
+/**
+ * @brief The largest count, also meaning "at least this number" once reached.
+ *
+ */
+#define TN_COUNT_MAX (~(tn_count)0)
+
+/**
+ * @brief Size of a buffer large enough for tn_count_to_string (39 digits and the terminating character).
+ *
+ */
+#define TN_COUNT_STRING_SIZE 40
+
+/**
+ * @brief Counts the valid paths of @p network of each length from 1 to @p length: sequences of steps (action, source, target) following the edges, starting at the initial node with the stack [4], ending at the final node with the stack [4], each action being possible on the stack. Two paths are different if one of their steps differs, even if they visit the same nodes.
+ * When the tables of all pairs of nodes fit in memory (and the time to fill them is reasonable), the paths are counted over summaries: a path splits uniquely into transmits and "push ... pop" blocks, so the number of well-nested paths of k steps between two nodes on a given top follows from the ones of fewer steps, in polynomial time whatever the stacks. Otherwise, the configurations (node, stack) are expanded position by position, the ones of a position with the same node and stack being merged and their counts added, and the ones whose stack cannot be emptied or whose node is too far from the final node in the remaining steps being dropped. The number of configurations may grow exponentially with the length.
+ *
+ * @param network The network.
+ * @param length The max length of the paths counted.
+ * @param counts An array of size @p length + 1. @p counts[l] receives the number of valid paths of length l (TN_COUNT_MAX if it is not smaller), and @p counts[0] is set to 0.
+ * @pre @p network must be an initialized TunnelNetwork.
+ */
+void tn_count_paths(TunnelNetwork network, int length, tn_count *counts);
+
+/**
+ * @brief Writes @p count in decimal in @p buffer.
+ *
+ * @param count
+ * @param buffer An array of size at least TN_COUNT_STRING_SIZE.
+ * @return char* @p buffer.
+ */
+char *tn_count_to_string(tn_count count, char *buffer);
+
+#endif
@@ -0,0 +1,30 @@
+/**
+ * @file TunnelMeet.h
+ * @brief A bidirectional search on the configurations (node, stack) of a Tunnel Network: a forward search from the initial configuration and a backward search (with the actions applied in reverse) from the final one meet in the middle, so that each side only explores about half of the length.
+ * @version 1
+ * @date 2026-10-17
+ *
+ * @copyright Creative Commons
+ *
+ */
+
+#ifndef TUNNEL_MEET_H
+#define TUNNEL_MEET_H
+
+#include "TunnelNetwork.h"
+
+/**
+ * @brief Decides if there is a valid simple path of length at most @p length in @p network, by a bidirectional breadth-first search. The forward side starts from the initial node with the stack [4], the backward side from the final node with the stack [4], and each side keeps the configurations it reached in a hash table on (node, stack) with their distance. At each round, the side with the smaller frontier is expanded by one layer, and each new configuration is looked up in the table of the other side: the first round finding a common configuration gives a shortest path, which is rebuilt from both halves. If there is such a path, a shortest one will be present in @p path after the call, otherwise, path is not modified.
+ * When the initial node is the final one, the common configuration would be the initial one, and tn_bfs is used instead.
+ *
+ * @param network The network.
+ * @param length The max length of the path sought
+ * @param path Array to return a path if one is found.
+ * @return int The length of the path found (the shortest valid length). Returns 0 if no path has been found.
+ * @pre @p path must be an array of size at least @p length.
+ * @pre @p network must be an initialized TunnelNetwork.
+ * @post @p path contains the path found from cell 0 to returned value -1.
+ */
+int tn_meet_in_the_middle(TunnelNetwork network, int length, tn_step *path);
+
+#endif
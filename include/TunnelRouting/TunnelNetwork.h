@@ -44,6 +44,79 @@ typedef enum
  */
 #define NumActions 10
 
+/**
+ * @brief The semantics of a stack action. Protocols are written 4 and 6.
+ * A push keeps the required top below the pushed symbol (result_top), and a pop removes the required top, the required second symbol becoming the new top.
+ *
+ */
+typedef struct
+{
+    int top;        ///< The symbol required on top of the stack.
+    int second;     ///< The symbol required just below the top (0 if nothing is required).
+    int delta;      ///< The variation of the height of the stack (-1, 0 or 1).
+    int result_top; ///< The symbol on top of the stack after the action.
+} tn_action_semantics;
+
+/**
+ * @brief The semantics of each stack action, indexed by stack_action. All the algorithms on Tunnel Networks read the actions from this table.
+ *
+ */
+static const tn_action_semantics tn_action_table[NumActions] = {
+    [transmit_4] = {4, 0, 0, 4},
+    [transmit_6] = {6, 0, 0, 6},
+    [push_4_4] = {4, 0, 1, 4},
+    [push_4_6] = {4, 0, 1, 6},
+    [push_6_4] = {6, 0, 1, 4},
+    [push_6_6] = {6, 0, 1, 6},
+    [pop_4_4] = {4, 4, -1, 4},
+    [pop_4_6] = {6, 4, -1, 4},
+    [pop_6_4] = {4, 6, -1, 6},
+    [pop_6_6] = {6, 6, -1, 6},
+};
+
+/**
+ * @brief The classes of stack actions, given by their variation of height.
+ *
+ */
+typedef enum
+{
+    tn_transmit_class, //< height unchanged
+    tn_push_class,     //< height + 1
+    tn_pop_class       //< height - 1
+} tn_action_class;
+
+/**
+ * @brief Number of classes of actions.
+ *
+ */
+#define NumActionClasses 3
+
+/**
+ * @brief Returns the class of @p action.
+ *
+ * @param action
+ * @return tn_action_class
+ */
+static inline tn_action_class tn_class_of_action(stack_action action)
+{
+    int delta = tn_action_table[action].delta;
+    return delta == 0 ? tn_transmit_class : (delta > 0 ? tn_push_class : tn_pop_class);
+}
+
+/**
+ * @brief Iterates over the actions of a mask: returns the smallest action of @p mask greater than or equal to @p from, or NumActions if there is none.
+ * Use as: for (int action = tn_next_action(mask, 0); action < NumActions; action = tn_next_action(mask, action + 1)).
+ *
+ * @param mask A mask of actions (bit action set for each action).
+ * @param from An action, or NumActions.
+ * @return int
+ */
+static inline int tn_next_action(int mask, int from)
+{
+    unsigned int rest = (unsigned int)mask >> from;
+    return rest == 0 ? NumActions : from + __builtin_ctz(rest);
+}
+
 /**
  * @brief Structure to store a step of an execution path over a tunnel network.
  *
@@ -55,8 +128,19 @@ typedef struct tn_step
     stack_action action; ///< The action code of this step.
 } tn_step;
 
+/**
+ * @brief A function receiving the paths found by an enumeration, one at a time, as soon as they are found.
+ *
+ * @param path The path found. It belongs to the enumeration and must not be modified (copy it if needed).
+ * @param size_path The number of steps of @p path.
+ * @param data The data given to the enumeration.
+ * @return bool true to continue the enumeration, false to stop it.
+ */
+typedef bool (*tn_path_callback)(tn_step *path, int size_path, void *data);
+
 /**
  * @brief Initializes a Tunnel Network from a Graph for use in the project. Parses node parameters to determine which are initial, final, and their actions.
+ * If @p graph was loaded from a snapshot containing node masks, these masks are used as the actions of the nodes instead of parsing their labels.
  * The graph is NOT copied (it is not supposed to be modified).
  * TODO: format of parsed parameters
  *
@@ -65,6 +149,16 @@ typedef struct tn_step
  */
 TunnelNetwork tn_initialize(Graph graph);
 
+/**
+ * @brief Writes the graph of @p network in a snapshot file (see graph_save_snapshot), with the action mask of each node, so that the network can be reloaded without parsing.
+ *
+ * @param network
+ * @param file_name The name of the snapshot file.
+ * @return true If the snapshot has been written.
+ * @return false Otherwise.
+ */
+bool tn_save_snapshot(TunnelNetwork network, char *file_name);
+
 /**
  * @brief Deallocates memory used by @p network. Does NOT deallocates the graph.
  *
@@ -86,6 +180,14 @@ char *tn_string_of_stack_action(stack_action action);
  */
 void tn_print(TunnelNetwork network);
 
+/**
+ * @brief Returns the graph supporting @p network.
+ *
+ * @param network
+ * @return Graph
+ */
+Graph tn_get_graph(TunnelNetwork network);
+
 /**
  * @brief Returns the number of nodes of @p network.
  *
@@ -114,6 +216,54 @@ int tn_get_num_edges(TunnelNetwork network);
  */
 bool tn_is_edge(TunnelNetwork network, int source, int target);
 
+/**
+ * @brief Returns the number of successors of @p node in @p network.
+ *
+ * @pre @p node must be between 0 and tn_get_num_nodes(@p network)-1.
+ * @param network
+ * @param node
+ * @return int
+ */
+int tn_get_num_successors(TunnelNetwork network, int node);
+
+/**
+ * @brief Returns the successors of @p node in @p network, sorted increasingly. The array has size tn_get_num_successors(@p network, @p node) and must not be modified.
+ *
+ * @pre @p node must be between 0 and tn_get_num_nodes(@p network)-1.
+ * @param network
+ * @param node
+ * @return int*
+ */
+int *tn_get_successors(TunnelNetwork network, int node);
+
+/**
+ * @brief Returns the number of predecessors of @p node in @p network.
+ *
+ * @pre @p node must be between 0 and tn_get_num_nodes(@p network)-1.
+ * @param network
+ * @param node
+ * @return int
+ */
+int tn_get_num_predecessors(TunnelNetwork network, int node);
+
+/**
+ * @brief Returns the predecessors of @p node in @p network, sorted increasingly. The array is computed once in tn_initialize, has size tn_get_num_predecessors(@p network, @p node) and must not be modified.
+ *
+ * @pre @p node must be between 0 and tn_get_num_nodes(@p network)-1.
+ * @param network
+ * @param node
+ * @return int*
+ */
+int *tn_get_predecessors(TunnelNetwork network, int node);
+
+/**
+ * @brief Computes the distance (in number of edges, whatever the actions) from each node of @p network to its final node, by a breadth-first search on the predecessors. No path of fewer steps can lead from a node to the final node, which gives a lower bound for the searches.
+ *
+ * @param network
+ * @return int* An array of size tn_get_num_nodes(@p network), with INT_MAX for the nodes that cannot reach the final node. It must be freed by the caller.
+ */
+int *tn_compute_distances_to_final(TunnelNetwork network);
+
 /**
  * @brief Returns the name of @p node in @p network.
  *
@@ -170,6 +320,22 @@ int tn_get_final(TunnelNetwork network);
  */
 void tn_set_final(TunnelNetwork network, int final);
 
+/**
+ * @brief Gets the number of nodes drawn as final nodes (invtriangle) in the input of @p network. The final node of @p network is the last of them.
+ *
+ * @param network
+ * @return int
+ */
+int tn_get_num_finals(TunnelNetwork network);
+
+/**
+ * @brief Gets the nodes drawn as final nodes (invtriangle) in the input of @p network, in increasing order. They are not changed by tn_set_final.
+ *
+ * @param network
+ * @return int* An array of size tn_get_num_finals(@p network).
+ */
+int *tn_get_finals(TunnelNetwork network);
+
 /**
  * @brief Gets the name of the network
  *
@@ -197,6 +363,16 @@ void tn_print_path(TunnelNetwork network, tn_step *path, int size_path);
  */
 void tn_create_dot(TunnelNetwork network, tn_step *path, int size_path, char *name);
 
+/**
+ * @brief Writes the path @p path in @p file as a JSON object {"size": .., "steps": [{"source": .., "action": .., "target": ..}, ..]}, the nodes being given by their names. No newline is written.
+ *
+ * @param file
+ * @param network
+ * @param path
+ * @param size_path
+ */
+void tn_fprint_path_json(FILE *file, TunnelNetwork network, tn_step *path, int size_path);
+
 /**
  * @brief Creates a tn_step with values given in argument.
  *
@@ -221,4 +397,36 @@ tn_step tn_step_empty();
  */
 int tn_get_actions(TunnelNetwork network, int node);
 
+/**
+ * @brief Gets the mask of the actions of @p node whose required top (see tn_action_table) is @p top. Computed once in tn_initialize.
+ *
+ * @pre @p node must be between 0 and tn_get_num_nodes(@p network)-1.
+ * @param network
+ * @param node
+ * @param top 4 or 6.
+ * @return int The mask (bit @p action set iff @p node can perform @p action).
+ */
+int tn_get_actions_by_top(TunnelNetwork network, int node, int top);
+
+/**
+ * @brief Gets the mask of the actions of @p node of class @p action_class. Computed once in tn_initialize.
+ *
+ * @pre @p node must be between 0 and tn_get_num_nodes(@p network)-1.
+ * @param network
+ * @param node
+ * @param action_class
+ * @return int The mask (bit @p action set iff @p node can perform @p action).
+ */
+int tn_get_actions_of_class(TunnelNetwork network, int node, tn_action_class action_class);
+
+/**
+ * @brief Gets the classes of actions that @p node can perform (bit @p action_class set iff @p node has an action of class @p action_class).
+ *
+ * @pre @p node must be between 0 and tn_get_num_nodes(@p network)-1.
+ * @param network
+ * @param node
+ * @return int
+ */
+int tn_get_action_classes(TunnelNetwork network, int node);
+
 #endif
\ No newline at end of file
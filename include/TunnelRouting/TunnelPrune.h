@@ -0,0 +1,88 @@
+/**
+ * @file TunnelPrune.h
+ * @brief A preprocessing of Tunnel Networks removing the nodes, edges and actions that cannot lie on a path from the initial node to the final node. The solvers are then run on the reduced network, and the paths they find are translated back to the original one.
+ * @version 1
+ * @date 2026-10-17
+ *
+ * @copyright Creative Commons
+ *
+ */
+
+#ifndef TUNNEL_PRUNE_H
+#define TUNNEL_PRUNE_H
+
+#include "TunnelNetwork.h"
+
+/**
+ * @brief A reduced network, with the correspondence between its nodes and the ones of the original network.
+ *
+ */
+typedef struct TunnelPruning_s *TunnelPruning;
+
+/**
+ * @brief Computes the reduced network of @p network, from the abstract interpretation of TunnelAbstract.h. The reduced network only contains the enabled edges and actions, and the nodes having an enabled action (which are reachable from the initial node and can reach the final node, as the analysis follows the edges). The initial and final nodes are always kept, and the kept nodes are renumbered in increasing order (so that the successors stay sorted and the searches explore them in the same order).
+ *
+ * @param network The network.
+ * @return TunnelPruning The reduced network (without nodes if @p network has none), to be freed with tn_pruning_delete.
+ * @pre @p network must be an initialized TunnelNetwork.
+ */
+TunnelPruning tn_prune(TunnelNetwork network);
+
+/**
+ * @brief Frees @p pruning, including its reduced network. The original network is not freed.
+ *
+ * @param pruning
+ */
+void tn_pruning_delete(TunnelPruning pruning);
+
+/**
+ * @brief Gets the reduced network of @p pruning.
+ *
+ * @param pruning
+ * @return TunnelNetwork
+ */
+TunnelNetwork tn_pruning_get_network(TunnelPruning pruning);
+
+/**
+ * @brief Gets the node of the original network corresponding to @p node of the reduced network.
+ *
+ * @param pruning
+ * @param node A node of the reduced network.
+ * @return int
+ */
+int tn_pruning_get_original_node(TunnelPruning pruning, int node);
+
+/**
+ * @brief Gets the number of nodes of the original network that are not in the reduced network.
+ *
+ * @param pruning
+ * @return int
+ */
+int tn_pruning_get_num_removed_nodes(TunnelPruning pruning);
+
+/**
+ * @brief Gets the number of edges of the original network that are not in the reduced network.
+ *
+ * @param pruning
+ * @return int
+ */
+int tn_pruning_get_num_removed_edges(TunnelPruning pruning);
+
+/**
+ * @brief Gets the number of actions of the kept nodes that are not enabled in the reduced network.
+ *
+ * @param pruning
+ * @return int
+ */
+int tn_pruning_get_num_removed_actions(TunnelPruning pruning);
+
+/**
+ * @brief Translates the nodes of the steps of @p path, found on the reduced network, to the nodes of the original network.
+ *
+ * @param pruning
+ * @param path A path of the reduced network.
+ * @param size_path The number of steps of @p path.
+ */
+void tn_pruning_restore_path(TunnelPruning pruning, tn_step *path, int size_path);
+
+#endif
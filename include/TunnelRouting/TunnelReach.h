@@ -0,0 +1,67 @@
+/**
+ * @file TunnelReach.h
+ * @brief The configurations (node, stack) of a Tunnel Network reachable from a source node, explored once by a breadth-first search. The table gives, for every node at once, the shortest valid path from the source to it, so that the questions sharing a source do not search again.
+ * @version 1
+ * @date 2026-10-17
+ *
+ * @copyright Creative Commons
+ *
+ */
+
+#ifndef TUNNEL_REACH_H
+#define TUNNEL_REACH_H
+
+#include "TunnelNetwork.h"
+
+/**
+ * @brief The configurations reached from a source node by the paths of size at most a bound, each one stored once with its distance and the configuration it was first reached from.
+ *
+ */
+typedef struct TunnelReach_s *TunnelReach;
+
+/**
+ * @brief Explores the configurations of @p network reachable from @p source in at most @p length steps, starting with the stack [4]. Each configuration is stored the first time it is reached (which is at its distance from the source), and the ones whose cells above the bottom cannot all be popped in the remaining steps are dropped. The initial and final nodes of @p network are ignored.
+ *
+ * @param network The network.
+ * @param source The node where the paths start.
+ * @param length The max size of the paths.
+ * @return TunnelReach The table, to be freed with tn_reach_delete.
+ * @pre @p network must be an initialized TunnelNetwork.
+ */
+TunnelReach tn_reach_create(TunnelNetwork network, int source, int length);
+
+/**
+ * @brief Frees @p reach.
+ *
+ * @param reach
+ */
+void tn_reach_delete(TunnelReach reach);
+
+/**
+ * @brief Gets the number of configurations stored in @p reach.
+ *
+ * @param reach
+ * @return int
+ */
+int tn_reach_get_num_configurations(TunnelReach reach);
+
+/**
+ * @brief Gets the size of a shortest valid path from the source of @p reach to @p node: a path of at least one step ending in @p node with the stack [4].
+ *
+ * @param reach
+ * @param node A node of the network.
+ * @return int The size of the path, 0 if there is none of size at most the bound of @p reach.
+ */
+int tn_reach_get_length(TunnelReach reach, int node);
+
+/**
+ * @brief Builds a shortest valid path from the source of @p reach to @p node.
+ *
+ * @param reach
+ * @param node A node with tn_reach_get_length(@p reach, @p node) > 0.
+ * @param path Array to return the path.
+ * @pre @p path must be an array of size at least tn_reach_get_length(@p reach, @p node).
+ */
+void tn_reach_get_path(TunnelReach reach, int node, tn_step *path);
+
+#endif
@@ -16,6 +16,96 @@
 #include "TunnelNetwork.h"
 #include <z3.h>
 
+/**
+ * @brief The encodings of the constraint "exactly one (node, height) per position".
+ *
+ */
+typedef enum
+{
+    tn_pairwise_encoding, //< One variable x_{node,pos,height} per triple, pairwise exclusion of the N*H triples of each position.
+    tn_factored_encoding  //< Separate one-hot variables for the node and the height of each position (sequential counter at-most-one), x_{node,pos,height} being defined as their conjunction.
+} tn_encoding;
+
+/**
+ * @brief The number of cells of the stack in the reduction for paths of size @p length (a stack of a valid path never gets higher).
+ *
+ * @param length The length of the sought path.
+ * @return int
+ */
+int get_stack_size(int length);
+
+/**
+ * @brief Computes which nodes can be at each position of a path of size @p length, with a forward BFS layer by layer from the initial node (the nodes reached in exactly pos steps) and, if @p backward, a backward one from the final node (the nodes from which the final node is reached in exactly length-pos steps).
+ *
+ * @param network A Tunnel Network.
+ * @param length The size of the path.
+ * @param backward If false, the final position is not known yet and only the forward layers are used.
+ * @param alive An array of size (length+1)*(number of nodes), filled by the function.
+ */
+void tn_compute_alive(TunnelNetwork network, int length, bool backward, bool *alive);
+
+/**
+ * @brief The table of the variables of the reduction for a network and a path length. Each variable is created once, and the encoder, the decoder and the model printer all read it from the table.
+ *
+ */
+typedef struct TunnelVariables_s *TunnelVariables;
+
+/**
+ * @brief Creates the variables of the reduction for paths of size @p length in @p network.
+ *
+ * @param ctx The solver context.
+ * @param network A Tunnel Network.
+ * @param length The size of the target path.
+ * @param encoding The encoding of the uniqueness constraints used by tn_reduction_with_variables.
+ * @return TunnelVariables The table, to be freed with tn_variables_delete (before the context is deleted).
+ * @pre @p network must be initialized.
+ */
+TunnelVariables tn_variables_create(Z3_context ctx, TunnelNetwork network, int length, tn_encoding encoding);
+
+/**
+ * @brief Gets the number of variables created in @p variables. The variables that are false whatever the path (nodes not reachable from the initial node in pos steps or not reaching the final node in length-pos steps, cells too high to be pushed and popped in time) are not created.
+ *
+ * @param variables A table created by tn_variables_create.
+ * @return long
+ */
+long tn_variables_get_num_variables(TunnelVariables variables);
+
+/**
+ * @brief Frees the table @p variables.
+ *
+ * @param variables A table created by tn_variables_create.
+ */
+void tn_variables_delete(TunnelVariables variables);
+
+/**
+ * @brief Same as tn_reduction, with the network, the size of the path and the variables given by @p variables.
+ *
+ * @param ctx The solver context.
+ * @param variables The variables of the reduction.
+ * @return Z3_ast The formula
+ */
+Z3_ast tn_reduction_with_variables(Z3_context ctx, TunnelVariables variables);
+
+/**
+ * @brief Same as tn_get_path_from_model, with the network, the size of the path and the variables given by @p variables.
+ *
+ * @param ctx The solver context.
+ * @param model A variable assignment.
+ * @param variables The variables used to build the formula satisfied by @p model.
+ * @param path The path
+ * @pre @p path must be an array of size (the size of the path)+1.
+ */
+void tn_get_path_from_variables(Z3_context ctx, Z3_model model, TunnelVariables variables, tn_step *path);
+
+/**
+ * @brief Same as tn_print_model, with the network, the size of the path and the variables given by @p variables.
+ *
+ * @param ctx The solver context.
+ * @param model A variable assignment.
+ * @param variables The variables used to build the formula satisfied by @p model.
+ */
+void tn_print_model_from_variables(Z3_context ctx, Z3_model model, TunnelVariables variables);
+
 /**
  * @brief Generates a propositional formula satisfiable if and only if there is a well-formed simple path of size @p bound from the initial node of @p network to its final node.
  *
@@ -27,6 +117,98 @@
  */
 Z3_ast tn_reduction(Z3_context ctx, const TunnelNetwork network, int length);
 
+/**
+ * @brief A single solver used for all the lengths up to a bound. The constraints of each position are asserted once, and the final condition of each length is guarded by an assumption literal, so that learned clauses are kept from one length to the next.
+ *
+ */
+typedef struct TunnelIncremental_s *TunnelIncremental;
+
+/**
+ * @brief Creates an incremental solver for the paths of size at most @p bound in @p network. Only the initial condition is asserted.
+ *
+ * @param ctx The solver context.
+ * @param network A Tunnel Network.
+ * @param bound The largest size of path that will be asked.
+ * @param encoding The encoding of the uniqueness constraints.
+ * @return TunnelIncremental The solver, to be freed with tn_incremental_delete (before the context is deleted).
+ * @pre @p network must be initialized.
+ */
+TunnelIncremental tn_incremental_create(Z3_context ctx, TunnelNetwork network, int bound, tn_encoding encoding);
+
+/**
+ * @brief Asserts in @p incremental the constraints of the positions up to @p length that are not asserted yet, and the final condition of @p length guarded by its assumption literal.
+ *
+ * @param ctx The solver context.
+ * @param incremental An incremental solver.
+ * @param length A size of path, at most the bound of @p incremental.
+ * @return Z3_ast The formula that was added to the solver.
+ */
+Z3_ast tn_incremental_add_length(Z3_context ctx, TunnelIncremental incremental, int length);
+
+/**
+ * @brief Checks if there is a well-formed path of size @p length, under the assumption of its final condition (calls tn_incremental_add_length first if needed). If there is none, the negation of the assumption is asserted.
+ *
+ * @param ctx The solver context.
+ * @param incremental An incremental solver.
+ * @param length A size of path, at most the bound of @p incremental.
+ * @param model Will contain a model if the answer is Z3_L_TRUE (otherwise, will not be modified).
+ * @return Z3_lbool The answer of the solver.
+ */
+Z3_lbool tn_incremental_solve(Z3_context ctx, TunnelIncremental incremental, int length, Z3_model *model);
+
+/**
+ * @brief Gets the well-formed path of size @p length from a model given by tn_incremental_solve.
+ *
+ * @param ctx The solver context.
+ * @param model A variable assignment.
+ * @param incremental The incremental solver that produced @p model.
+ * @param length The size of the path.
+ * @param path The path
+ * @pre @p path must be an array of size @p length+1.
+ */
+void tn_incremental_get_path(Z3_context ctx, Z3_model model, TunnelIncremental incremental, int length, tn_step *path);
+
+/**
+ * @brief Same as tn_print_model_from_variables, for the positions 0 to @p length of a model given by tn_incremental_solve.
+ *
+ * @param ctx The solver context.
+ * @param model A variable assignment.
+ * @param incremental The incremental solver that produced @p model.
+ * @param length The size of the path.
+ */
+void tn_incremental_print_model(Z3_context ctx, Z3_model model, TunnelIncremental incremental, int length);
+
+/**
+ * @brief Forbids in @p incremental the path @p path of size @p length: the clause saying that one of its positions (node, height, top) differs is asserted, guarded by the assumption literal of @p length so that the longer paths are not constrained. The next calls to tn_incremental_solve for @p length can only give other paths, and keep what the solver learned.
+ *
+ * @param ctx The solver context.
+ * @param incremental An incremental solver.
+ * @param length The size of the path.
+ * @param path A path given by tn_incremental_get_path for @p length.
+ * @pre tn_incremental_add_length must have been called for @p length.
+ */
+void tn_incremental_block_path(Z3_context ctx, TunnelIncremental incremental, int length, tn_step *path);
+
+/**
+ * @brief Enumerates the distinct valid paths of size at most the bound of @p incremental, by increasing size: while the solver finds a path of the current size, it is decoded, blocked with tn_incremental_block_path and given to @p callback, before the solver is called again.
+ *
+ * @param ctx The solver context.
+ * @param incremental An incremental solver.
+ * @param max_paths The max number of paths given to @p callback.
+ * @param callback The function receiving the paths. The enumeration stops when it returns false.
+ * @param data Given to @p callback.
+ * @return int The number of paths given to @p callback.
+ */
+int tn_incremental_enumerate(Z3_context ctx, TunnelIncremental incremental, int max_paths, tn_path_callback callback, void *data);
+
+/**
+ * @brief Frees @p incremental and its solver.
+ *
+ * @param ctx The solver context.
+ * @param incremental An incremental solver.
+ */
+void tn_incremental_delete(Z3_context ctx, TunnelIncremental incremental);
+
 /**
  * @brief Gets the well-formed path from the model @p model.
  *
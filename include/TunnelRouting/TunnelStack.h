@@ -0,0 +1,239 @@
+/**
+ * @file TunnelStack.h
+ * @brief A bit-packed stack of protocols for the searches on Tunnel Networks. As there are only two protocols, a cell is a bit (1 for 6, 0 for 4): the 64 lowest cells are stored in a single word, and the deeper ones in extra words allocated only when the capacity asks for it.
+ * The functions are inlined, as they are called at each step of the searches.
+ * @version 1
+ * @date 2026-10-17
+ *
+ * @copyright Creative Commons
+ *
+ */
+
+#ifndef TUNNEL_STACK_H
+#define TUNNEL_STACK_H
+
+#include "TunnelNetwork.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+/**
+ * @brief A stack of protocols. Cell 0 is the bottom, and the cells at or above the height are always 0, so that two stacks can be compared and hashed word by word.
+ *
+ */
+typedef struct
+{
+    int height;     ///< The number of cells.
+    int capacity;   ///< The max number of cells.
+    uint64_t low;   ///< The cells 0 to 63.
+    uint64_t *high; ///< The cells 64 and above, (capacity - 1) / 64 words (NULL if capacity <= 64).
+} tn_stack;
+
+/**
+ * @brief Number of words of @p high for a stack of capacity @p capacity.
+ */
+static inline int tn_stack_num_high_words(int capacity)
+{
+    return capacity > 64 ? (capacity - 1) / 64 : 0;
+}
+
+/**
+ * @brief Initializes @p stack to the initial stack of the problem (a single 4), able to contain @p capacity cells.
+ *
+ * @param stack
+ * @param capacity The max number of cells (at least 1).
+ */
+static inline void tn_stack_init(tn_stack *stack, int capacity)
+{
+    stack->height = 1;
+    stack->capacity = capacity;
+    stack->low = 0;
+    stack->high = NULL;
+    int num_words = tn_stack_num_high_words(capacity);
+    if (num_words > 0)
+    {
+        stack->high = calloc(num_words, sizeof(uint64_t));
+        if (stack->high == NULL)
+        {
+            printf("Malloc failed\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+}
+
+/**
+ * @brief Frees the extra words of @p stack.
+ *
+ * @param stack
+ */
+static inline void tn_stack_free(tn_stack *stack)
+{
+    free(stack->high);
+    stack->high = NULL;
+}
+
+/**
+ * @brief Copies @p source in @p target.
+ *
+ * @pre @p target and @p source must have been initialized with the same capacity.
+ */
+static inline void tn_stack_copy(tn_stack *target, const tn_stack *source)
+{
+    target->height = source->height;
+    target->low = source->low;
+    if (source->high != NULL)
+        memcpy(target->high, source->high, tn_stack_num_high_words(source->capacity) * sizeof(uint64_t));
+}
+
+/**
+ * @brief Returns the cell @p cell of @p stack: 0 for 4, 1 for 6.
+ */
+static inline int tn_stack_cell(const tn_stack *stack, int cell)
+{
+    if (cell < 64)
+        return (stack->low >> cell) & 1;
+    cell -= 64;
+    return (stack->high[cell / 64] >> (cell % 64)) & 1;
+}
+
+/**
+ * @brief Writes @p bit (0 for 4, 1 for 6) in the cell @p cell of @p stack.
+ */
+static inline void tn_stack_set_cell(tn_stack *stack, int cell, int bit)
+{
+    uint64_t *word = &stack->low;
+    if (cell >= 64)
+    {
+        cell -= 64;
+        word = &stack->high[cell / 64];
+        cell %= 64;
+    }
+    *word = (*word & ~((uint64_t)1 << cell)) | ((uint64_t)bit << cell);
+}
+
+/**
+ * @brief Returns the bit of the protocol @p symbol (4 or 6, as in tn_action_table): 0 for 4, 1 for 6.
+ */
+static inline int tn_stack_bit(int symbol)
+{
+    return symbol == 6;
+}
+
+/**
+ * @brief Returns the top of @p stack: 0 for 4, 1 for 6.
+ */
+static inline int tn_stack_top(const tn_stack *stack)
+{
+    return tn_stack_cell(stack, stack->height - 1);
+}
+
+/**
+ * @brief Returns the protocol on top of @p stack (4 or 6), to be used with tn_get_actions_by_top.
+ */
+static inline int tn_stack_top_symbol(const tn_stack *stack)
+{
+    return tn_stack_top(stack) ? 6 : 4;
+}
+
+/**
+ * @brief Applies @p action to @p stack if it is possible.
+ *
+ * @return true if the action was applied, false if the top of the stack does not allow it, if it would pop the bottom cell, or if it would push above the capacity (in which case nothing is modified).
+ */
+static inline bool tn_stack_apply(tn_stack *stack, stack_action action)
+{
+    const tn_action_semantics *semantics = &tn_action_table[action];
+    if (tn_stack_top(stack) != tn_stack_bit(semantics->top))
+        return false;
+    if (semantics->delta == 0)
+        return true;
+    if (semantics->delta > 0)
+    {
+        if (stack->height == stack->capacity)
+            return false;
+        tn_stack_set_cell(stack, stack->height, tn_stack_bit(semantics->result_top));
+        stack->height++;
+        return true;
+    }
+    if (stack->height < 2 || tn_stack_cell(stack, stack->height - 2) != tn_stack_bit(semantics->second))
+        return false;
+    stack->height--;
+    tn_stack_set_cell(stack, stack->height, 0);
+    return true;
+}
+
+/**
+ * @brief Cancels @p action on @p stack.
+ *
+ * @pre @p action must be the last action successfully applied to @p stack by tn_stack_apply.
+ */
+static inline void tn_stack_undo(tn_stack *stack, stack_action action)
+{
+    const tn_action_semantics *semantics = &tn_action_table[action];
+    if (semantics->delta > 0)
+    {
+        stack->height--;
+        tn_stack_set_cell(stack, stack->height, 0);
+    }
+    else if (semantics->delta < 0)
+    {
+        tn_stack_set_cell(stack, stack->height, tn_stack_bit(semantics->top));
+        stack->height++;
+    }
+}
+
+/**
+ * @brief Applies @p action backward to @p stack if it is possible: @p stack is seen as the stack after the action, and is replaced by the stack before it.
+ *
+ * @return true if @p stack can result from @p action (its top is the resulting top of the action, and for a push, the cell below is the required top), false otherwise or if the stack before the action would exceed the capacity (in which case nothing is modified).
+ */
+static inline bool tn_stack_unapply(tn_stack *stack, stack_action action)
+{
+    const tn_action_semantics *semantics = &tn_action_table[action];
+    if (tn_stack_top(stack) != tn_stack_bit(semantics->result_top))
+        return false;
+    if (semantics->delta == 0)
+        return true;
+    if (semantics->delta > 0)
+    {
+        if (stack->height < 2 || tn_stack_cell(stack, stack->height - 2) != tn_stack_bit(semantics->top))
+            return false;
+        stack->height--;
+        tn_stack_set_cell(stack, stack->height, 0);
+        return true;
+    }
+    if (stack->height == stack->capacity)
+        return false;
+    tn_stack_set_cell(stack, stack->height, tn_stack_bit(semantics->top));
+    stack->height++;
+    return true;
+}
+
+/**
+ * @brief Tells if @p stack1 and @p stack2 contain the same cells.
+ *
+ * @pre @p stack1 and @p stack2 must have the same capacity.
+ */
+static inline bool tn_stack_equal(const tn_stack *stack1, const tn_stack *stack2)
+{
+    if (stack1->height != stack2->height || stack1->low != stack2->low)
+        return false;
+    return stack1->high == NULL || memcmp(stack1->high, stack2->high, tn_stack_num_high_words(stack1->capacity) * sizeof(uint64_t)) == 0;
+}
+
+/**
+ * @brief A hash of the cells of @p stack.
+ */
+static inline uint64_t tn_stack_hash(const tn_stack *stack)
+{
+    uint64_t hash = stack->low ^ ((uint64_t)stack->height << 57);
+    for (int i = 0; i < tn_stack_num_high_words(stack->capacity); i++)
+        hash ^= stack->high[i] + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+#endif
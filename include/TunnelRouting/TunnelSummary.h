@@ -0,0 +1,74 @@
+/**
+ * @file TunnelSummary.h
+ * @brief A polynomial decision procedure for the Tunnel Network Routing problem, seen as a bounded pushdown reachability problem.
+ * A summary (u, v, k, t) states that there is a path of exactly k steps from u to v which, starting with a stack whose top is t, never goes below that top and ends with the same stack. Summaries are computed bottom-up on k: a summary is either a transmit followed by a summary, or a push, a summary on the pushed top, the matching pop, and a summary.
+ * A valid path of size k is exactly a summary (initial, final, k, 4).
+ * @version 1
+ * @date 2026-10-17
+ *
+ * @copyright Creative Commons
+ *
+ */
+
+#ifndef TUNNEL_SUMMARY_H
+#define TUNNEL_SUMMARY_H
+
+#include "TunnelNetwork.h"
+
+/**
+ * @brief The summaries of a network for all the sizes up to a bound.
+ *
+ */
+typedef struct TunnelSummary_s *TunnelSummary;
+
+/**
+ * @brief Computes the summaries of @p network for all the sizes from 0 to @p bound. Takes O(bound² · N³ / 64) operations in the worst case, N being the number of nodes.
+ *
+ * @param network The network.
+ * @param bound The max size of the paths.
+ * @return TunnelSummary The summaries, to be freed with tn_summary_delete.
+ * @pre @p network must be an initialized TunnelNetwork.
+ */
+TunnelSummary tn_summary_create(TunnelNetwork network, int bound);
+
+/**
+ * @brief Frees @p summary.
+ *
+ * @param summary
+ */
+void tn_summary_delete(TunnelSummary summary);
+
+/**
+ * @brief Tells if there is a valid simple path of size exactly @p length.
+ *
+ * @param summary The summaries of the network.
+ * @param length A size between 0 and the bound of @p summary.
+ * @return true If there is such a path.
+ * @return false Otherwise.
+ */
+bool tn_summary_has_path(TunnelSummary summary, int length);
+
+/**
+ * @brief Builds a valid simple path of size exactly @p length from the summaries.
+ *
+ * @param summary The summaries of the network.
+ * @param length A size between 0 and the bound of @p summary.
+ * @param path Array to return the path.
+ * @pre tn_summary_has_path(@p summary, @p length) must be true.
+ * @pre @p path must be an array of size at least @p length.
+ */
+void tn_summary_get_path(TunnelSummary summary, int length, tn_step *path);
+
+/**
+ * @brief Decides if there is a valid simple path of length at most @p length in @p network with the summaries. If there is such a path, a shortest one will be present in @p path after the call, otherwise, path is not modified.
+ *
+ * @param network The network.
+ * @param length The max length of the path sought
+ * @param path Array to return a path if one is found.
+ * @return int The length of the path found (the shortest valid length). Returns 0 if no path has been found.
+ * @pre @p path must be an array of size at least @p length.
+ * @pre @p network must be an initialized TunnelNetwork.
+ */
+int tn_summary_solve(TunnelNetwork network, int length, tn_step *path);
+
+#endif
@@ -0,0 +1,39 @@
+/**
+ * @file TunnelSymbolic.h
+ * @brief A symbolic breadth-first search on the configurations (node, stack) of a Tunnel Network: the sets of configurations are BDDs (see BDD.h) over the bits of the node, of the height and of the cells of the stack, and each layer is computed from the previous one at once, by an image computation, whatever its number of configurations.
+ * @version 1
+ * @date 2026-10-17
+ *
+ * @copyright Creative Commons
+ *
+ */
+
+#ifndef TUNNEL_SYMBOLIC_H
+#define TUNNEL_SYMBOLIC_H
+
+#include "TunnelNetwork.h"
+
+/**
+ * @brief Decides if there is a valid simple path of length at most @p length in @p network, with BDDs. A configuration is encoded by the bits of its node (each one followed by the matching bit of the next node, for the edge relation), the bits of the height and one bit per cell. The layer of the configurations first reached after k+1 steps is the image of the layer k: for each height and each action, the configurations of the layer whose node has the action and whose stack allows it get their stack updated (the height is replaced and the cell written or cleared), then the node is moved along the edges by a relational product with the edge relation. The configurations reached before are removed, and the search stops at the first layer meeting the final configuration, or when a layer is empty.
+ * A witness is then rebuilt backward: the final configuration is picked in the last layer, and each previous configuration is found in its layer among the pre-images of the current one (a predecessor of its node, with an action whose reverse application gives its stack).
+ * When the initial node is the final one, the final configuration would be the initial one, and tn_bfs is used instead.
+ *
+ * @param network The network.
+ * @param length The max length of the path sought
+ * @param path Array to return a path if one is found.
+ * @return int The length of the path found (the shortest valid length). Returns 0 if no path has been found.
+ * @pre @p path must be an array of size at least @p length.
+ * @pre @p network must be an initialized TunnelNetwork.
+ * @post @p path contains the path found from cell 0 to returned value -1.
+ */
+int tn_symbolic_solve(TunnelNetwork network, int length, tn_step *path);
+
+/**
+ * @brief Gets the statistics of the last call to tn_symbolic_solve.
+ *
+ * @param peak_nodes Set to the largest number of BDD nodes in use at the same time.
+ * @param num_configurations Set to the number of configurations reached.
+ */
+void tn_symbolic_get_stats(int *peak_nodes, double *num_configurations);
+
+#endif
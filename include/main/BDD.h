@@ -0,0 +1,249 @@
+/**
+ * @file BDD.h
+ * @brief A small package of reduced ordered binary decision diagrams (ROBDD), to represent sets of boolean vectors and compute on them symbolically.
+ *        The nodes live in a manager: a unique table makes sure that each function is represented by a single node (so two BDDs are equal iff their indices are), and the
+ *        results of the operations are remembered in a computed cache. The variables are ordered by their index (variable 0 is at the top of the diagrams).
+ *
+ *        Memory: the nodes no longer used are reclaimed by a garbage collection, run at the beginning of an operation when many nodes were created since the last one.
+ *        Every BDD kept by the caller across calls must be protected with bdd_ref (and released with bdd_deref), the arguments of the current call being protected automatically.
+ * @version 1
+ * @date 2026-10-17
+ *
+ * @copyright Creative Commons
+ *
+ */
+
+#ifndef COCA_BDD_H_
+#define COCA_BDD_H_
+
+#include <stdbool.h>
+
+/**
+ * @brief A manager, containing all the nodes of the BDDs built with it.
+ *
+ */
+typedef struct BDDManager_s *BDDManager;
+
+/**
+ * @brief A BDD: the index of its root node in its manager.
+ *
+ */
+typedef int bdd;
+
+/**
+ * @brief The BDD of the constant false.
+ *
+ */
+#define BDD_FALSE 0
+
+/**
+ * @brief The BDD of the constant true.
+ *
+ */
+#define BDD_TRUE 1
+
+/**
+ * @brief Creates a manager for BDDs over the variables 0 to @p num_vars-1. Must be freed with bdd_manager_delete.
+ *
+ * @param num_vars The number of variables.
+ * @return BDDManager
+ */
+BDDManager bdd_manager_create(int num_vars);
+
+/**
+ * @brief Frees @p manager and all its BDDs.
+ *
+ * @param manager
+ */
+void bdd_manager_delete(BDDManager manager);
+
+/**
+ * @brief Protects @p f from the garbage collection, until the same number of calls to bdd_deref.
+ *
+ * @param manager
+ * @param f
+ * @return bdd @p f.
+ */
+bdd bdd_ref(BDDManager manager, bdd f);
+
+/**
+ * @brief Releases a protection of @p f given by bdd_ref.
+ *
+ * @param manager
+ * @param f
+ */
+void bdd_deref(BDDManager manager, bdd f);
+
+/**
+ * @brief Reclaims the nodes that cannot be reached from a protected BDD, and empties the computed cache.
+ *
+ * @param manager
+ */
+void bdd_gc(BDDManager manager);
+
+/**
+ * @brief Gets the number of nodes in use (including the two terminals).
+ *
+ * @param manager
+ * @return int
+ */
+int bdd_get_num_nodes(BDDManager manager);
+
+/**
+ * @brief Gets the largest number of nodes that were in use at the same time.
+ *
+ * @param manager
+ * @return int
+ */
+int bdd_get_peak_nodes(BDDManager manager);
+
+/**
+ * @brief Gets the number of garbage collections done.
+ *
+ * @param manager
+ * @return int
+ */
+int bdd_get_num_gc(BDDManager manager);
+
+/**
+ * @brief The BDD of the variable @p var.
+ *
+ * @param manager
+ * @param var A variable of @p manager.
+ * @return bdd
+ */
+bdd bdd_var(BDDManager manager, int var);
+
+/**
+ * @brief The BDD of the negation of the variable @p var.
+ *
+ * @param manager
+ * @param var A variable of @p manager.
+ * @return bdd
+ */
+bdd bdd_nvar(BDDManager manager, int var);
+
+/**
+ * @brief If-then-else: the BDD of (@p f and @p g) or (not @p f and @p h). All the other operators are special cases of this one.
+ *
+ * @param manager
+ * @param f
+ * @param g
+ * @param h
+ * @return bdd
+ */
+bdd bdd_ite(BDDManager manager, bdd f, bdd g, bdd h);
+
+/**
+ * @brief The BDD of not @p f.
+ */
+bdd bdd_not(BDDManager manager, bdd f);
+
+/**
+ * @brief The BDD of @p f and @p g.
+ */
+bdd bdd_and(BDDManager manager, bdd f, bdd g);
+
+/**
+ * @brief The BDD of @p f or @p g.
+ */
+bdd bdd_or(BDDManager manager, bdd f, bdd g);
+
+/**
+ * @brief The BDD of @p f and not @p g.
+ */
+bdd bdd_diff(BDDManager manager, bdd f, bdd g);
+
+/**
+ * @brief The conjunction of the variables @p vars, to be given as @p cube to the quantifications.
+ *
+ * @param manager
+ * @param vars Variables of @p manager.
+ * @param num_vars The number of variables.
+ * @return bdd
+ */
+bdd bdd_cube(BDDManager manager, int *vars, int num_vars);
+
+/**
+ * @brief The conjunction of the literals setting the variables @p vars to the values @p values: the set of the vectors agreeing with @p values on @p vars.
+ *
+ * @param manager
+ * @param vars Variables of @p manager.
+ * @param values The value of each variable of @p vars.
+ * @param num_vars The number of variables.
+ * @return bdd
+ */
+bdd bdd_literals(BDDManager manager, int *vars, bool *values, int num_vars);
+
+/**
+ * @brief Existential quantification: the BDD of "there are values of the variables of @p cube making @p f true".
+ *
+ * @param manager
+ * @param f
+ * @param cube A conjunction of variables, built with bdd_cube.
+ * @return bdd
+ */
+bdd bdd_exists(BDDManager manager, bdd f, bdd cube);
+
+/**
+ * @brief Relational product: the same as bdd_exists(@p manager, bdd_and(@p manager, @p f, @p g), @p cube), without building the conjunction.
+ *
+ * @param manager
+ * @param f
+ * @param g
+ * @param cube A conjunction of variables, built with bdd_cube.
+ * @return bdd
+ */
+bdd bdd_and_exists(BDDManager manager, bdd f, bdd g, bdd cube);
+
+/**
+ * @brief Registers a renaming of the variables, to be used with bdd_replace.
+ *
+ * @param manager
+ * @param map An array of size the number of variables: variable v is renamed as map[v]. It is copied.
+ * @return int The identifier of the renaming.
+ */
+int bdd_new_renaming(BDDManager manager, int *map);
+
+/**
+ * @brief The BDD of @p f with each variable renamed by the renaming @p renaming.
+ *
+ * @param manager
+ * @param f
+ * @param renaming A renaming returned by bdd_new_renaming.
+ * @return bdd
+ */
+bdd bdd_replace(BDDManager manager, bdd f, int renaming);
+
+/**
+ * @brief Gets one vector of @p f: a value for each variable making @p f true (the variables that do not matter get false).
+ *
+ * @param manager
+ * @param f
+ * @param values An array of size the number of variables, receiving the values.
+ * @return true if @p f is not false (and @p values was filled), false otherwise.
+ */
+bool bdd_pick_one(BDDManager manager, bdd f, bool *values);
+
+/**
+ * @brief Tells if @p f is true for the values @p values of the variables.
+ *
+ * @param manager
+ * @param f
+ * @param values An array of size the number of variables.
+ * @return bool
+ */
+bool bdd_eval(BDDManager manager, bdd f, bool *values);
+
+/**
+ * @brief Counts the vectors of the variables @p first_var to @p first_var + @p num_vars - 1 making @p f true, @p f depending only on these variables.
+ *
+ * @param manager
+ * @param f
+ * @param first_var The first variable counted.
+ * @param num_vars The number of variables counted.
+ * @return double
+ */
+double bdd_sat_count(BDDManager manager, bdd f, int first_var, int num_vars);
+
+#endif
@@ -0,0 +1,96 @@
+/**
+ * @file CNF.h
+ * @brief Functions to write a reduction directly as clauses of the solver of SATSolver.h, the counterpart of Z3Tools.h for this solver: the constraints used by the
+ *        reductions (implications between a conjunction and a disjunction, at-most-one and exactly-one constraints) are emitted as clauses without building a formula.
+ *
+ *        A solver created by cnf_create_solver has the constants CNF_TRUE and CNF_FALSE, which can be given anywhere a literal is expected (a variable known to be
+ *        false can so be kept in the arrays of the encoder: the clauses are simplified by the solver when they are added).
+ * @version 1
+ * @date 2026-10-17
+ *
+ * @copyright Creative Commons
+ *
+ */
+
+#ifndef COCA_CNF_H_
+#define COCA_CNF_H_
+
+#include "SATSolver.h"
+
+/**
+ * @brief The literal always true in a solver created by cnf_create_solver (its first variable).
+ *
+ */
+#define CNF_TRUE 1
+
+/**
+ * @brief The literal always false in a solver created by cnf_create_solver.
+ *
+ */
+#define CNF_FALSE (-1)
+
+/**
+ * @brief Creates a solver whose first variable is the constant CNF_TRUE. Must be freed with sat_delete.
+ *
+ * @return SatSolver
+ */
+SatSolver cnf_create_solver(void);
+
+/**
+ * @brief Adds the clause @p a or @p b.
+ */
+void cnf_add_binary(SatSolver solver, int a, int b);
+
+/**
+ * @brief Adds the clause @p a or @p b or @p c.
+ */
+void cnf_add_ternary(SatSolver solver, int a, int b, int c);
+
+/**
+ * @brief Adds the constraint "if all the literals of @p premises are true, one of @p conclusions is true", as a single clause.
+ *
+ * @param solver
+ * @param premises The literals of the conjunction (may be empty).
+ * @param num_premises The number of premises.
+ * @param conclusions The literals of the disjunction (may be empty: the premises are then forbidden together).
+ * @param num_conclusions The number of conclusions.
+ */
+void cnf_add_implies(SatSolver solver, const int *premises, int num_premises, const int *conclusions, int num_conclusions);
+
+/**
+ * @brief Adds the constraint "at most one of @p lits is true", with a clause per pair of literals.
+ *
+ * @param solver
+ * @param lits The literals.
+ * @param size The number of literals.
+ */
+void cnf_at_most_one(SatSolver solver, const int *lits, int size);
+
+/**
+ * @brief Adds the constraint "exactly one of @p lits is true", with a clause per pair of literals for the "at most" part.
+ *
+ * @param solver
+ * @param lits The literals.
+ * @param size The number of literals.
+ */
+void cnf_unique(SatSolver solver, const int *lits, int size);
+
+/**
+ * @brief Adds the constraint "at most one of @p lits is true", with the sequential counter encoding: size-1 fresh variables and about 3*size binary clauses.
+ *
+ * @param solver
+ * @param lits The literals.
+ * @param size The number of literals.
+ */
+void cnf_at_most_one_sequential(SatSolver solver, const int *lits, int size);
+
+/**
+ * @brief Adds the constraint "exactly one of @p lits is true", with the sequential counter encoding for the "at most" part.
+ *
+ * @param solver
+ * @param lits The literals.
+ * @param size The number of literals.
+ */
+void cnf_unique_sequential(SatSolver solver, const int *lits, int size);
+
+#endif
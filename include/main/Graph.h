@@ -71,10 +71,16 @@ typedef struct
 	int numNodes; ///< The number of nodes of the graph.
 	int numEdges; ///< The number of edges of the graph.
 	char **nodes; ///< The names of nodes of the graph.
-	bool *edges;  ///< The edges of the graph.
+
+	int *edge_offsets; ///< Compressed sparse rows: the successors of node i are stored in edge_targets[edge_offsets[i]] to edge_targets[edge_offsets[i+1]-1]. Size numNodes+1.
+	int *edge_targets; ///< The targets of the edges, sorted increasingly within each row. Size edge_offsets[numNodes].
 
 	parameterList **parameters;		 ///< Parameters of the nodes.
-	parameterList **edge_parameters; ///< Parameters of the edges
+	parameterList **edge_parameters; ///< Parameters of the edges, stored in the same order as edge_targets.
+
+	int *node_masks;	 ///< Optional integer annotation of each node stored in snapshots (e.g. the actions of a tunnel network). NULL if absent.
+	void *mapping;		 ///< The mapped snapshot file backing the arrays of the graph, or NULL if the graph was built in memory.
+	size_t mapping_size; ///< The size of mapping.
 } Graph;
 
 /**
@@ -87,7 +93,18 @@ typedef struct
 Graph graph_copy(Graph graph);
 
 /**
- * @brief Displays a graph with a list of nodes and a matrix of edges.
+ * @brief Creates the subgraph of @p graph induced by the nodes @p node such that @p kept[node] is true: these nodes, renumbered increasingly, with their names and parameters, and the edges (with their parameters) whose both ends are kept. Node masks are kept too if present.
+ *
+ * @param graph A graph.
+ * @param kept An array of size graph_num_nodes(@p graph).
+ * @param kept_arcs An array of size graph_num_edges(@p graph) telling which edges to keep among the ones whose both ends are kept, indexed in the order of the adjacency lists (the successors of node 0, then of node 1...), or NULL to keep them all.
+ * @return Graph The subgraph, to be freed with graph_delete.
+ * @pre @p graph must be a valid graph.
+ */
+Graph graph_induced_subgraph(Graph graph, bool *kept, bool *kept_arcs);
+
+/**
+ * @brief Displays a graph with a list of nodes and the list of successors of each node.
  *
  * @param graph the graph to display.
  *
@@ -133,7 +150,7 @@ int graph_num_nodes(Graph graph);
 int graph_num_edges(Graph graph);
 
 /**
- * @brief Tells if (@p source, @p target) is an edge in @p graph.
+ * @brief Tells if (@p source, @p target) is an edge in @p graph. Runs a binary search over the successors of @p source.
  *
  * @param graph A graph.
  * @param source The source of the edge.
@@ -146,6 +163,28 @@ int graph_num_edges(Graph graph);
  */
 bool graph_is_edge(Graph graph, int source, int target);
 
+/**
+ * @brief Returns the number of successors of @p node in @p graph.
+ *
+ * @param graph A graph.
+ * @param node A node.
+ * @return int The out-degree of @p node.
+ * @pre @p graph must be a valid graph.
+ * @pre 0 <= @p node < @p graph.numNodes
+ */
+int graph_out_degree(Graph graph, int node);
+
+/**
+ * @brief Returns the successors of @p node in @p graph, sorted increasingly. The array has size graph_out_degree(@p graph, @p node) and belongs to @p graph (it must not be modified nor freed).
+ *
+ * @param graph A graph.
+ * @param node A node.
+ * @return int* The successors of @p node.
+ * @pre @p graph must be a valid graph.
+ * @pre 0 <= @p node < @p graph.numNodes
+ */
+int *graph_get_successors(Graph graph, int node);
+
 /**
  * @brief Returns the parameter list associated to edge (@p source, @p target). Returns NULL if no parameter exists (or the edge doesn't exist).
  *
@@ -180,6 +219,45 @@ parameterList *graph_get_node_parameter(Graph graph, int node);
  */
 char *graph_get_node_name(Graph graph, int node);
 
+/**
+ * @brief Returns the node masks stored with @p graph (see graph_save_snapshot), or NULL if there are none.
+ *
+ * @param graph A graph.
+ * @return int* An array of size graph_num_nodes(@p graph), or NULL.
+ */
+int *graph_get_node_masks(Graph graph);
+
+/**
+ * @brief Writes @p graph in the binary snapshot format in the file @p file_name. The snapshot contains the compressed sparse rows, the parameters (names and values are stored once in a string pool), and optionally an integer mask per node.
+ * The file only contains offsets, so it can be mapped at any address by graph_load_snapshot.
+ *
+ * @param graph A graph.
+ * @param node_masks An array of size graph_num_nodes(@p graph) to store along the graph, or NULL.
+ * @param file_name The name of the file to create.
+ * @return true If the snapshot has been written.
+ * @return false If the file could not be written.
+ * @pre @p graph must be a valid graph.
+ */
+bool graph_save_snapshot(Graph graph, int *node_masks, char *file_name);
+
+/**
+ * @brief Tells if @p file_name is meant to be a snapshot written by graph_save_snapshot, that is if it starts with the magic bytes of snapshots. A truncated or corrupted snapshot is recognised too, and rejected by graph_load_snapshot.
+ *
+ * @param file_name The name of a file.
+ * @return true If @p file_name starts with the magic bytes of snapshots.
+ * @return false Otherwise (including if it does not exist).
+ */
+bool graph_is_snapshot(char *file_name);
+
+/**
+ * @brief Loads a graph from a snapshot written by graph_save_snapshot. The file is mapped in memory, and the edges, node names and node masks of the graph point directly inside it. Exits the program if the file cannot be read or is not a valid snapshot.
+ * The graph must be freed with graph_delete as any other graph.
+ *
+ * @param file_name The name of the snapshot file.
+ * @return Graph The graph stored in @p file_name.
+ */
+Graph graph_load_snapshot(char *file_name);
+
 /**
  * @brief Writes in @p file the content of @p graph (with parameters) in dot format. For undirected graphs only.
  *
@@ -17,6 +17,7 @@
 
 /**
  * @brief Parses a file and return the Graph described by it. If the file with the name given in argument does not exists, it displays an error message and exits the program.
+ * If the file is a snapshot written by graph_save_snapshot, it is loaded directly instead of being parsed.
  * 
  * @param toRead the name of a file in graphviz format.
  * @return GraphList The parsed GraphList.
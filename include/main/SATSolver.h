@@ -0,0 +1,135 @@
+/**
+ * @file SATSolver.h
+ * @brief A small CDCL SAT solver, to decide the clauses produced by the reductions without going through Z3.
+ *        The variables are numbered from 1, and a literal is a variable (positive literal) or its opposite (negative literal), as in the DIMACS format.
+ *        Propagation uses two watched literals per clause, decisions follow the activity of the variables (EVSIDS: the variables of the recent conflicts are bumped, the
+ *        increment growing geometrically) with phase saving, the search restarts according to the Luby sequence, and half of the learnt clauses (the ones with the
+ *        largest LBD) are thrown away periodically.
+ *
+ *        The solver is incremental: clauses can be added between two calls to sat_solve, which keep the learnt clauses, and a call can be given assumptions (literals
+ *        taken as true for this call only), which allows to activate or deactivate groups of clauses guarded by a literal.
+ * @version 1
+ * @date 2026-10-17
+ *
+ * @copyright Creative Commons
+ *
+ */
+
+#ifndef COCA_SATSOLVER_H_
+#define COCA_SATSOLVER_H_
+
+#include <stdbool.h>
+#include <stdio.h>
+
+/**
+ * @brief A solver, containing its variables, its clauses and its learnt clauses.
+ *
+ */
+typedef struct SatSolver_s *SatSolver;
+
+/**
+ * @brief Creates a solver without variables nor clauses. Must be freed with sat_delete.
+ *
+ * @return SatSolver
+ */
+SatSolver sat_create(void);
+
+/**
+ * @brief Frees @p solver and all its clauses.
+ *
+ * @param solver
+ */
+void sat_delete(SatSolver solver);
+
+/**
+ * @brief Creates a fresh variable.
+ *
+ * @param solver
+ * @return int The variable, numbered from 1 in the order of creation.
+ */
+int sat_new_var(SatSolver solver);
+
+/**
+ * @brief Adds the clause made of the literals @p lits (their disjunction). The clause is simplified with the literals fixed so far: it is ignored if it is already satisfied, and its false literals are removed. Adding the empty clause makes the solver unsatisfiable for good.
+ *
+ * @param solver
+ * @param lits The literals, of variables created with sat_new_var. The array is not kept.
+ * @param size The number of literals.
+ * @return false if the clauses of @p solver are now known to be unsatisfiable, true otherwise.
+ */
+bool sat_add_clause(SatSolver solver, const int *lits, int size);
+
+/**
+ * @brief Decides if the clauses of @p solver are satisfiable with the literals @p assumptions true. The clauses learnt are kept for the next calls, the assumptions are not.
+ *
+ * @param solver
+ * @param assumptions The literals assumed true for this call.
+ * @param num_assumptions The number of assumptions (may be 0).
+ * @return true if the clauses are satisfiable with the assumptions (a model can then be read with sat_value), false otherwise.
+ */
+bool sat_solve(SatSolver solver, const int *assumptions, int num_assumptions);
+
+/**
+ * @brief Gets the value of @p var in the model found by the last call to sat_solve.
+ *
+ * @param solver
+ * @param var A variable.
+ * @return bool
+ * @pre The last call to sat_solve must have returned true.
+ */
+bool sat_value(SatSolver solver, int var);
+
+/**
+ * @brief Gets the value of the literal @p lit in the model found by the last call to sat_solve.
+ *
+ * @param solver
+ * @param lit A literal.
+ * @return bool
+ * @pre The last call to sat_solve must have returned true.
+ */
+bool sat_lit_value(SatSolver solver, int lit);
+
+/**
+ * @brief Writes the clauses given to @p solver in the DIMACS format (the clauses simplified away by sat_add_clause are not written, the literals fixed are written as unit clauses).
+ *
+ * @param solver
+ * @param file An open file.
+ */
+void sat_write_dimacs(SatSolver solver, FILE *file);
+
+/**
+ * @brief Gets the number of variables.
+ */
+int sat_get_num_vars(SatSolver solver);
+
+/**
+ * @brief Gets the number of clauses given and kept (not counting the unit ones).
+ */
+long sat_get_num_clauses(SatSolver solver);
+
+/**
+ * @brief Gets the number of learnt clauses currently kept.
+ */
+long sat_get_num_learnts(SatSolver solver);
+
+/**
+ * @brief Gets the number of conflicts met by all the calls to sat_solve.
+ */
+long sat_get_num_conflicts(SatSolver solver);
+
+/**
+ * @brief Gets the number of decisions taken by all the calls to sat_solve.
+ */
+long sat_get_num_decisions(SatSolver solver);
+
+/**
+ * @brief Gets the number of literals propagated by all the calls to sat_solve.
+ */
+long sat_get_num_propagations(SatSolver solver);
+
+/**
+ * @brief Gets the number of restarts done by all the calls to sat_solve.
+ */
+long sat_get_num_restarts(SatSolver solver);
+
+#endif
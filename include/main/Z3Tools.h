@@ -54,6 +54,26 @@ Z3_ast at_most_formula(Z3_context ctx, Z3_ast *formulae, int size);
  */
 Z3_ast uniqueFormula(Z3_context ctx, Z3_ast *formulae, int size);
 
+/**
+ * @brief Generates a formula stating that at most one of the formulae from @p formulae is true, with the sequential counter encoding. Uses size-1 fresh auxiliary variables and about 3*size binary clauses (instead of size*(size-1)/2 for at_most_formula).
+ *
+ * @param ctx The solver context.
+ * @param formulae The formulae.
+ * @param size The number of formulae.
+ * @return Z3_ast The obtained formula.
+ */
+Z3_ast at_most_one_sequential_formula(Z3_context ctx, Z3_ast *formulae, int size);
+
+/**
+ * @brief Generates a formula stating that exactly one of the formulae from @p formulae is true, with the sequential counter encoding for the "at most" part.
+ *
+ * @param ctx The solver context.
+ * @param formulae The formulae.
+ * @param size The number of formulae.
+ * @return Z3_ast The obtained formula.
+ */
+Z3_ast unique_sequential_formula(Z3_context ctx, Z3_ast *formulae, int size);
+
 /**
  * @brief Tells if a formula is satisfiable, unsatisfiable, or cannot be decided.
  * 
@@ -59,6 +59,16 @@ bool cg_is_edge(ColouredGraph graph, int source, int target)
     return (graph_is_edge(graph->graph, source, target));
 }
 
+int cg_get_num_neighbours(ColouredGraph graph, int node)
+{
+    return graph_out_degree(graph->graph, node);
+}
+
+int *cg_get_neighbours(ColouredGraph graph, int node)
+{
+    return graph_get_successors(graph->graph, node);
+}
+
 char *cg_get_node_name(ColouredGraph graph, int node)
 {
     return graph_get_node_name(graph->graph, node);
@@ -154,13 +164,12 @@ void cg_create_dot(ColouredGraph graph, char *name)
 
     for (int node = 0; node < num_nodes; node++)
     {
-        for (int node2 = 0; node2 < node; node2++)
+        int num_neighbours = cg_get_num_neighbours(graph, node);
+        int *neighbours = cg_get_neighbours(graph, node);
+        for (int i = 0; i < num_neighbours && neighbours[i] < node; i++)
         {
-            if (graph_is_edge(graph->graph, node, node2))
-            {
-                fprintf(file, "%s -- %s", graph_get_node_name(graph->graph, node), graph_get_node_name(graph->graph, node2));
-                fprintf(file, ";\n");
-            }
+            fprintf(file, "%s -- %s", graph_get_node_name(graph->graph, node), graph_get_node_name(graph->graph, neighbours[i]));
+            fprintf(file, ";\n");
         }
     }
 
@@ -1,5 +1,6 @@
 #include "ColouringReduction.h"
 #include "Z3Tools.h"
+#include "CNF.h"
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <unistd.h>
@@ -55,19 +56,27 @@ Z3_ast edge_formula(Z3_context ctx, int node1, int node2, int num_colours)
 Z3_ast edges_have_different_colours_formula(Z3_context ctx, const ColouredGraph graph, int num_colours)
 {
     int num_nodes = cg_get_num_nodes(graph);
+    int num_arcs = 0;
+    for (int node1 = 0; node1 < num_nodes; node1++)
+        num_arcs += cg_get_num_neighbours(graph, node1);
     int current = 0;
-    Z3_ast edges_formula[num_nodes * num_nodes];
+    Z3_ast *edges_formula = (Z3_ast *)malloc((num_arcs + 1) * sizeof(Z3_ast));
     for (int node1 = 0; node1 < num_nodes; node1++)
     {
-        for (int node2 = node1 + 1; node2 < num_nodes; node2++)
+        int num_neighbours = cg_get_num_neighbours(graph, node1);
+        int *neighbours = cg_get_neighbours(graph, node1);
+        for (int i = 0; i < num_neighbours; i++)
         {
-            if (!cg_is_edge(graph, node1, node2))
+            int node2 = neighbours[i];
+            if (node2 <= node1)
                 continue;
             edges_formula[current] = edge_formula(ctx, node1, node2, num_colours);
             current++;
         }
     }
-    return Z3_mk_and(ctx, current, edges_formula);
+    Z3_ast result = Z3_mk_and(ctx, current, edges_formula);
+    free(edges_formula);
+    return result;
 }
 
 /**
@@ -125,4 +134,59 @@ void colouring_print_model(Z3_context ctx, Z3_model model, ColouredGraph graph,
     for (int node = 0; node < num_nodes; node++)
         for (int colour = 0; colour < num_colours; colour++)
             printf("[%d:%d] = %d\n", node, colour, value_of_var_in_model(ctx, model, variable_node_color(ctx, node, colour)));
-}
\ No newline at end of file
+}
+
+int colouring_reduction_cnf(SatSolver solver, const ColouredGraph graph, int num_colours)
+{
+    int num_nodes = cg_get_num_nodes(graph);
+    int first_variable = sat_get_num_vars(solver) + 1;
+    for (int i = 0; i < num_nodes * num_colours; i++)
+        sat_new_var(solver);
+
+    int node_color_vars[num_colours];
+    for (int node = 0; node < num_nodes; node++)
+    {
+        for (int colour = 0; colour < num_colours; colour++)
+            node_color_vars[colour] = first_variable + node * num_colours + colour;
+        cnf_unique(solver, node_color_vars, num_colours);
+    }
+
+    for (int node1 = 0; node1 < num_nodes; node1++)
+    {
+        int num_neighbours = cg_get_num_neighbours(graph, node1);
+        int *neighbours = cg_get_neighbours(graph, node1);
+        for (int i = 0; i < num_neighbours; i++)
+        {
+            int node2 = neighbours[i];
+            if (node2 <= node1)
+                continue;
+            for (int colour = 0; colour < num_colours; colour++)
+                cnf_add_binary(solver, -(first_variable + node1 * num_colours + colour), -(first_variable + node2 * num_colours + colour));
+        }
+    }
+    return first_variable;
+}
+
+void colour_graph_from_solver(SatSolver solver, int first_variable, ColouredGraph graph, int num_colours)
+{
+    int num_nodes = cg_get_num_nodes(graph);
+    for (int node = 0; node < num_nodes; node++)
+    {
+        for (int colour = 0; colour < num_colours; colour++)
+        {
+            if (sat_value(solver, first_variable + node * num_colours + colour))
+            {
+                cg_set_node_colour(graph, node, colour);
+                break;
+            }
+        }
+    }
+}
+
+void colouring_print_solver_model(SatSolver solver, int first_variable, ColouredGraph graph, int num_colours)
+{
+    int num_nodes = cg_get_num_nodes(graph);
+    for (int node = 0; node < num_nodes; node++)
+        for (int colour = 0; colour < num_colours; colour++)
+            printf("[%d:%d] = %d\n", node, colour, sat_value(solver, first_variable + node * num_colours + colour));
+}
@@ -22,11 +22,11 @@ bool recursive_bf(ColouredGraph graph, int num_colours, int node)
     {
         cg_set_node_colour(graph, node, col);
         bool same_colour_as_neighbour = false;
-        for (int n = 0; n < node; n++)
+        int num_neighbours = cg_get_num_neighbours(graph, node);
+        int *neighbours = cg_get_neighbours(graph, node);
+        for (int i = 0; i < num_neighbours && neighbours[i] < node; i++)
         {
-            if (!cg_is_edge(graph, node, n))
-                continue;
-            int col_n = cg_get_node_colour(graph, n);
+            int col_n = cg_get_node_colour(graph, neighbours[i]);
             if (col_n == col)
             {
                 same_colour_as_neighbour = true;
@@ -0,0 +1,228 @@
+#include "TunnelAbstract.h"
+#include "TunnelNetwork.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+struct TunnelAbstraction_s
+{
+    int num_nodes;        ///< The number of nodes.
+    int *entry_states;    ///< The abstract stacks possible at entry of each node (masks).
+    int *enabled_actions; ///< The enabled actions of each node (masks).
+    int *edge_offsets;    ///< The edges of node u are indexed from edge_offsets[u] to edge_offsets[u+1]-1.
+    bool *enabled_edges;  ///< Tells if each edge is enabled.
+};
+
+/**
+ * @brief The abstract stacks reached by applying @p action to the abstract stack @p state, as a mask (0 if @p action cannot be applied).
+ * After a pop, the symbol below the new top is unknown, except that it cannot be the bottom if the new top is a 6 (the bottom is always a 4).
+ */
+static int tn_abstract_transition(int state, stack_action action)
+{
+    const tn_action_semantics *semantics = &tn_action_table[action];
+    int top = state / 3;
+    int below = state % 3;
+    if (top != (semantics->top == 6))
+        return 0;
+    if (semantics->delta == 0)
+        return 1 << state;
+    int result_top = semantics->result_top == 6;
+    if (semantics->delta > 0)
+        return 1 << tn_abstract_state(result_top, top + 1);
+    if (below != (semantics->second == 6) + 1)
+        return 0;
+    int result = (1 << tn_abstract_state(result_top, 1)) | (1 << tn_abstract_state(result_top, 2));
+    if (result_top == 0)
+        result |= 1 << tn_abstract_state(0, 0);
+    return result;
+}
+
+/**
+ * @brief The abstract stacks reached from the abstract stacks of @p states by one of the actions of @p actions.
+ *
+ * @param transitions The table of tn_abstract_transition.
+ */
+static int tn_abstract_post(int transitions[NumAbstractStates][NumActions], int states, int actions)
+{
+    int result = 0;
+    for (int state = 0; state < NumAbstractStates; state++)
+    {
+        if ((states & (1 << state)) == 0)
+            continue;
+        for (int action = tn_next_action(actions, 0); action < NumActions; action = tn_next_action(actions, action + 1))
+            result |= transitions[state][action];
+    }
+    return result;
+}
+
+/**
+ * @brief The abstract stacks from which one of the actions of @p actions reaches one of the abstract stacks of @p targets.
+ *
+ * @param transitions The table of tn_abstract_transition.
+ */
+static int tn_abstract_pre(int transitions[NumAbstractStates][NumActions], int actions, int targets)
+{
+    int result = 0;
+    for (int state = 0; state < NumAbstractStates; state++)
+    {
+        for (int action = tn_next_action(actions, 0); action < NumActions; action = tn_next_action(actions, action + 1))
+            if (transitions[state][action] & targets)
+                result |= 1 << state;
+    }
+    return result;
+}
+
+TunnelAbstraction tn_abstract_analyse(TunnelNetwork network, bool *kept)
+{
+    int num_nodes = tn_get_num_nodes(network);
+    int initial = tn_get_initial(network);
+    int final = tn_get_final(network);
+
+    int transitions[NumAbstractStates][NumActions];
+    for (int state = 0; state < NumAbstractStates; state++)
+        for (stack_action action = 0; action < NumActions; action++)
+            transitions[state][action] = tn_abstract_transition(state, action);
+
+    TunnelAbstraction abstraction = malloc(sizeof(*abstraction));
+    abstraction->num_nodes = num_nodes;
+    abstraction->entry_states = calloc(num_nodes + 1, sizeof(int));
+    abstraction->enabled_actions = calloc(num_nodes + 1, sizeof(int));
+    abstraction->edge_offsets = malloc((num_nodes + 1) * sizeof(int));
+    abstraction->enabled_edges = calloc(tn_get_num_edges(network) + 1, sizeof(bool));
+    int *useful_states = calloc(num_nodes + 1, sizeof(int));
+    int *worklist = malloc((num_nodes + 1) * sizeof(int));
+    bool *in_worklist = calloc(num_nodes + 1, sizeof(bool));
+    if (abstraction->entry_states == NULL || abstraction->enabled_actions == NULL || abstraction->edge_offsets == NULL || abstraction->enabled_edges == NULL || useful_states == NULL || worklist == NULL || in_worklist == NULL)
+    {
+        printf("Malloc failed\n");
+        exit(EXIT_FAILURE);
+    }
+    abstraction->edge_offsets[0] = 0;
+    for (int node = 0; node < num_nodes; node++)
+        abstraction->edge_offsets[node + 1] = abstraction->edge_offsets[node] + tn_get_num_successors(network, node);
+
+    // without nodes there is no initial node : nothing is enabled
+    if (num_nodes == 0)
+    {
+        free(useful_states);
+        free(worklist);
+        free(in_worklist);
+        return abstraction;
+    }
+
+    int *entry = abstraction->entry_states;
+    // the worklist is circular : a node is in it at most once
+    int head = 0, size = 0;
+
+    // forward : the abstract stacks at entry of the nodes, from the initial stack at the initial node
+    if (kept == NULL || kept[initial])
+    {
+        entry[initial] = 1 << tn_abstract_state(0, 0);
+        worklist[size++] = initial;
+        in_worklist[initial] = true;
+    }
+    while (size > 0)
+    {
+        int node = worklist[head];
+        head = (head + 1) % num_nodes;
+        size--;
+        in_worklist[node] = false;
+        int post = tn_abstract_post(transitions, entry[node], tn_get_actions(network, node));
+        int *successors = tn_get_successors(network, node);
+        for (int i = 0; i < tn_get_num_successors(network, node); i++)
+        {
+            int next = successors[i];
+            if ((kept != NULL && !kept[next]) || (entry[next] | post) == entry[next])
+                continue;
+            entry[next] |= post;
+            if (!in_worklist[next])
+            {
+                worklist[(head + size++) % num_nodes] = next;
+                in_worklist[next] = true;
+            }
+        }
+    }
+
+    // backward : the abstract stacks from which the final node can be reached with the initial stack
+    if (kept == NULL || kept[final])
+    {
+        useful_states[final] = 1 << tn_abstract_state(0, 0);
+        worklist[(head + size++) % num_nodes] = final;
+        in_worklist[final] = true;
+    }
+    while (size > 0)
+    {
+        int node = worklist[head];
+        head = (head + 1) % num_nodes;
+        size--;
+        in_worklist[node] = false;
+        int *predecessors = tn_get_predecessors(network, node);
+        for (int i = 0; i < tn_get_num_predecessors(network, node); i++)
+        {
+            int previous = predecessors[i];
+            if (kept != NULL && !kept[previous])
+                continue;
+            int pre = tn_abstract_pre(transitions, tn_get_actions(network, previous), useful_states[node]);
+            if ((useful_states[previous] | pre) == useful_states[previous])
+                continue;
+            useful_states[previous] |= pre;
+            if (!in_worklist[previous])
+            {
+                worklist[(head + size++) % num_nodes] = previous;
+                in_worklist[previous] = true;
+            }
+        }
+    }
+
+    // an action (or an edge) is enabled if it leads from a stack at entry to a useful stack of a successor
+    for (int node = 0; node < num_nodes; node++)
+    {
+        if (entry[node] == 0)
+            continue;
+        int actions = tn_get_actions(network, node);
+        int *successors = tn_get_successors(network, node);
+        for (int i = 0; i < tn_get_num_successors(network, node); i++)
+        {
+            int next = successors[i];
+            if ((kept != NULL && !kept[next]) || useful_states[next] == 0)
+                continue;
+            for (int action = tn_next_action(actions, 0); action < NumActions; action = tn_next_action(actions, action + 1))
+            {
+                if (tn_abstract_post(transitions, entry[node], 1 << action) & useful_states[next])
+                {
+                    abstraction->enabled_actions[node] |= 1 << action;
+                    abstraction->enabled_edges[abstraction->edge_offsets[node] + i] = true;
+                }
+            }
+        }
+    }
+
+    free(useful_states);
+    free(worklist);
+    free(in_worklist);
+    return abstraction;
+}
+
+void tn_abstract_delete(TunnelAbstraction abstraction)
+{
+    free(abstraction->entry_states);
+    free(abstraction->enabled_actions);
+    free(abstraction->edge_offsets);
+    free(abstraction->enabled_edges);
+    free(abstraction);
+}
+
+int tn_abstract_get_entry_states(TunnelAbstraction abstraction, int node)
+{
+    return abstraction->entry_states[node];
+}
+
+int tn_abstract_get_enabled_actions(TunnelAbstraction abstraction, int node)
+{
+    return abstraction->enabled_actions[node];
+}
+
+bool tn_abstract_is_edge_enabled(TunnelAbstraction abstraction, int node, int index)
+{
+    return abstraction->enabled_edges[abstraction->edge_offsets[node] + index];
+}
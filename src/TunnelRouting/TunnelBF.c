@@ -1,158 +1,57 @@
 #include "TunnelBF.h"
 #include "TunnelNetwork.h"
+#include "TunnelStack.h"
 #include <stdlib.h>
 #include <stdio.h>
-
-//cette fonction sert à tester si une action est possible en fonction de l'état actuelle de la pile :
-    //si oui, elle effectue cette action en mettant a jour "stack" et "stackHeight" et renvoi true
-    //sinon, elle renvoi false => action non possible sur la stack
-bool doActionOnStack(int action, int stack[], int* stackHeight){
-    //printf("do : stackHeight = %d ; stack[stackHeig-1] = %d ; action = %d\n", *stackHeight, stack[*(stackHeight)-1], action);
-    
-    //switch case un peu redondant pour chaque action possible
-    switch (action) {
-        case transmit_4:
-            return (stack[*(stackHeight)-1] == 4);
-
-        case transmit_6:
-            return (stack[*(stackHeight)-1] == 6);
-
-        case push_4_4:
-            if(stack[*(stackHeight)-1] == 4){
-                (*stackHeight)++;
-                stack[*(stackHeight)-1] = 4;
-                return true;
-            } else {
-                return false;
-            }
-
-        case push_4_6:
-            if(stack[*(stackHeight)-1] == 4){
-                (*stackHeight)++;
-                stack[*(stackHeight)-1] = 6;
-                return true;
-            } else {
-                return false;
-            }
-
-        case push_6_4:
-            if(stack[*(stackHeight)-1] == 6){
-                (*stackHeight)++;
-                stack[*(stackHeight)-1] = 4;
-                return true;
-            } else {
-                return false;
-            }
-
-        case push_6_6:
-            if(stack[*(stackHeight)-1] == 6){
-                (*stackHeight)++;
-                stack[*(stackHeight)-1] = 6;
-                return true;
-            } else {
-                return false;
-            }
-
-        case pop_4_4:
-            if(*stackHeight >= 2 && stack[*(stackHeight)-1] == 4 && stack[*(stackHeight)-2] == 4){
-                stack[*(stackHeight)-1] = -1;
-                (*stackHeight)--;
-                return true;
-            } else {
-                return false;
-            }
-
-        case pop_4_6:
-            if(*stackHeight >= 2 && stack[*(stackHeight)-1] == 6 && stack[*(stackHeight)-2] == 4){
-                stack[*(stackHeight)-1] = -1;
-                (*stackHeight)--;
-                return true;
-            } else {
-                return false;
-            }
-
-        case pop_6_4:
-            if(*stackHeight >= 2 && stack[*(stackHeight)-1] == 4 && stack[*(stackHeight)-2] == 6){
-                stack[*(stackHeight)-1] = -1;
-                (*stackHeight)--;
-                return true;
-            } else {
-                return false;
-            }
-
-        case pop_6_6:
-            if(*stackHeight >= 2 && stack[*(stackHeight)-1] == 6 && stack[*(stackHeight)-2] == 6){
-                stack[*(stackHeight)-1] = -1;
-                (*stackHeight)--;
-                return true;
-            } else {
-                return false;
-            }
-
-        default:
-            printf("Erreur dans doAction\n");
-            exit(EXIT_FAILURE);
-    }    
-}
-
-//undoActionOnStack() annule une action donné en parametre sur la stack
-//pas de test de verification d'action inverse possible sur la pile car non nécessaire ...
-// => elle sera toujours appelé apres un appel de doActionOnStack() pour la meme "action"
-void undoActionOnStack(int action, int stack[], int* stackHeight){
-    //printf("undo : stackHeight = %d ; stack[stackHeig-1] = %d ; action = %d\n", *stackHeight, stack[*(stackHeight)-1], action);
-    
-    //pas besoin de case transmit car rien a faire
-    switch (action) {
-        case push_4_4:
-            stack[*(stackHeight)-1] = -1;
-            (*stackHeight)--;
-            break;
-
-        case push_4_6:
-            stack[*(stackHeight)-1] = -1;
-            (*stackHeight)--;
-            break;
-
-        case push_6_4:
-            stack[*(stackHeight)-1] = -1;
-            (*stackHeight)--;
-            break;
-
-        case push_6_6:
-            stack[*(stackHeight)-1] = -1;
-            (*stackHeight)--;
-            break;
-
-        case pop_4_4:
-            (*stackHeight)++;
-            stack[*(stackHeight)-1] = 4;
-            break;
-
-        case pop_4_6:
-            (*stackHeight)++;
-            stack[*(stackHeight)-1] = 6;
-            break;
-
-        case pop_6_4:
-            (*stackHeight)++;
-            stack[*(stackHeight)-1] = 4;
-            break;
-
-        case pop_6_6:
-            (*stackHeight)++;
-            stack[*(stackHeight)-1] = 6;
-            break;
-    }
-}
+#include <string.h>
+#include <limits.h>
+#include <pthread.h>
+#include <stdatomic.h>
+
+//la pile est representée par un tn_stack (voir TunnelStack.h) : une cellule par bit, ...
+// 0 pour ipv4 et 1 pour ipv6, l'indice 0 etant le bas de la pile
+//tn_stack_apply teste si une action est possible sur la pile et l'effectue si oui, ...
+// tn_stack_undo annule la derniere action effectuée
+
+//bornes inferieures sur le nombre de pas restant a faire, pour couper les branches sans issue
+typedef struct {
+    int *distance;       //distance[n] : nombre minimal de pas de n au noeud final (INT_MAX si inatteignable)
+    long coupesDistance; //nombre de sous-arbres coupés car le noeud final est trop loin
+    long coupesPile;     //nombre de sous-arbres coupés car la pile ne peut plus etre videe a temps
+} tn_bornes;
+
+//coupes de la derniere recherche, pour tn_brute_force_get_cuts
+static long derniereCoupesDistance = 0;
+static long derniereCoupesPile = 0;
 
 //fonction auxiliaire servant à explorer le graphe "network", pour trouver et stocker dans "path" ...
 // un chemin valide de taille "length" qui respectera les condition de pile
-int tn_brute_force_aux(TunnelNetwork network, int length, tn_step *path, int stack[], int* stackHeight, int pas, int node){
+//en mode parallele, "best" est l'indice de la plus petite tache ayant trouvé un chemin :
+// si elle est plus petite que "task", la recherche est abandonnée (NULL en mode sequentiel)
+int tn_brute_force_aux(TunnelNetwork network, int length, tn_step *path, tn_stack *stack, int pas, int node, atomic_int *best, int task, tn_bornes *bornes){
     //printf("Pas = %d, node = %d\n", pas, node);
+
+    if(best != NULL && atomic_load_explicit(best, memory_order_relaxed) < task){
+        return -1;
+    }
+
+    //il reste length-pas pas : il en faut au moins distance[node] pour atteindre le noeud final, ...
+    // et au moins hauteur-1 pour depiler tout sauf le fond de la pile
+    if(pas < length){
+        int restant = length - pas;
+        if(restant < bornes->distance[node]){
+            bornes->coupesDistance++;
+            return -1;
+        }
+        if(restant < stack->height - 1){
+            bornes->coupesPile++;
+            return -1;
+        }
+    }
     
     if(pas == length){
         if(node == tn_get_final(network)){
-            if(*stackHeight == 1 && stack[*(stackHeight)-1] == 4){
+            if(stack->height == 1 && tn_stack_top(stack) == 0){
                 //on a trouvé un chemin valide, respectant les conditions de pile, sa longeur demandé
                 //et on est sur le noeud final du graphe
                 return pas;
@@ -170,24 +69,31 @@ int tn_brute_force_aux(TunnelNetwork network, int length, tn_step *path, int sta
         return -1;
     }
 
-    //on explore les sommet n pour trouver ceux qui sont lié au noeud actuel "node"
-    for(int n=0; n<tn_get_num_nodes(network); n++){
-        if(tn_is_edge(network, node, n)){
+    //on explore uniquement les successeurs n du noeud actuel "node"
+    //on ne garde que les actions du noeud actuel "node" dont le sommet requis est celui de la stack
+    int mask = tn_get_actions_by_top(network, node, tn_stack_top_symbol(stack));
+    if(mask == 0){
+        return -1;
+    }
+    int numSuccessors = tn_get_num_successors(network, node);
+    int* successors = tn_get_successors(network, node);
+    for(int i=0; i<numSuccessors; i++){
+        int n = successors[i];
+        {
             //on explore les action que peuxc faire du noeud actuel "node" avec le mask
             //ces action que possede le noeud actuelle devront etre compatible avec l'état actuelle de la stack
 
-            for(int action=0; action<NumActions; action++){
-                int mask = tn_get_actions(network, node);
-                if((mask & (1 << action)) != 0 
-                    && doActionOnStack(action, stack, stackHeight)){
-                    //on applique l'action possible sur la stack, avec stackHeight possiblement mis a jour
+            //tn_next_action ne parcourt que les actions presentes dans le mask
+            for(int action=tn_next_action(mask, 0); action<NumActions; action=tn_next_action(mask, action+1)){
+                if(tn_stack_apply(stack, action)){
+                    //on applique l'action possible sur la stack, avec sa hauteur possiblement mise a jour
 
                     //on ajouter a path le step actuelle
                     *(path + pas) = tn_step_create(action, node, n);
 
                     //on lance la recursion avec les parametre mis a jour
-                    // (juste le pas car les variable de stack sont mise a jour dans doActionOnStack())
-                    int res = tn_brute_force_aux(network, length, path, stack, stackHeight, pas+1, n);
+                    // (juste le pas car la stack est mise a jour dans tn_stack_apply())
+                    int res = tn_brute_force_aux(network, length, path, stack, pas+1, n, best, task, bornes);
                         
                     if(res != -1){
                         //la recursion a trouvé un chemin valide
@@ -201,7 +107,7 @@ int tn_brute_force_aux(TunnelNetwork network, int length, tn_step *path, int sta
                         *(path + pas) = tn_step_empty();
 
                         //on annule l'action ajouté sur la pile 
-                        undoActionOnStack(action, stack, stackHeight);
+                        tn_stack_undo(stack, action);
                     }
                 }
             }
@@ -216,42 +122,438 @@ int tn_brute_force_aux(TunnelNetwork network, int length, tn_step *path, int sta
 //sert de fonction d'initialisation pour la fonction recursive auxiliaire
 int tn_brute_force(TunnelNetwork network, int length, tn_step *path)
 {
-    //on va representer la stack par la tableau d'entier de taille (length/2)+1 
-    //les valeurs possible sont :
-        //-1 => espace vide
-        //4 => protocole ipv4 empilé
-        //6 => protocole ipv6 empilé
-    //son indice 0 sera un protocole ipv4 et le reste des -1
+    //une pile de hauteur h apres un pas doit etre depilée h-1 fois avant la fin du chemin :
+    // elle ne depasse donc jamais (length/2)+1 cellules dans un chemin valide, ...
+    // et tn_stack_apply refuse les push au dela
+    //par default, elle contient un premier protocole ipv4 empilé (à l'indice 0)
     int maxTaillePile = (length/2)+1;
-    int* stack = malloc(maxTaillePile * sizeof(int));
-    if(stack == NULL){
+    tn_stack stack;
+    tn_stack_init(&stack, maxTaillePile);
+
+    //node stock le numéro du noeu dans lequel on sera au fur et a mesure de l'algo (debute au 1er)
+    int node = tn_get_initial(network);
+    //pas servira a reprenter l'avancement dans le graphe => devra etre de taille length pour un chemin valide
+    int pas = 0;
+
+    tn_bornes bornes = {tn_compute_distances_to_final(network), 0, 0};
+
+    //on lance la fonction recursive auxiliaire, et revoi son resultat
+    int res = tn_brute_force_aux(network, length, path, &stack, pas, node, NULL, 0, &bornes);
+
+    derniereCoupesDistance = bornes.coupesDistance;
+    derniereCoupesPile = bornes.coupesPile;
+    free(bornes.distance);
+    tn_stack_free(&stack);
+    
+    return res;
+}
+
+//variante de tn_brute_force_aux qui ne s'arrete pas au premier chemin : elle parcourt tous les chemins ...
+// de taille au plus "length" et, a chaque passage par le noeud final avec la pile [4] apres "pas" pas, ...
+// copie le chemin dans paths[pas] si aucun chemin de cette taille n'a encore été trouvé
+//"manquants" est le nombre de tailles pas encore trouvées
+static void tn_brute_force_all_aux(TunnelNetwork network, int length, tn_step *path, tn_stack *stack, int pas, int node, tn_bornes *bornes, tn_step **paths, bool *found, int *manquants){
+    if(pas > 0 && node == tn_get_final(network) && stack->height == 1 && !found[pas]){
+        //premier chemin de taille pas dans l'ordre du parcours : c'est celui que tn_brute_force trouverait
+        found[pas] = true;
+        memcpy(paths[pas], path, pas * sizeof(tn_step));
+        (*manquants)--;
+    }
+    if(pas == length || *manquants == 0){
+        return;
+    }
+
+    //memes bornes que tn_brute_force_aux, avec le nombre maximal de pas restant
+    int restant = length - pas;
+    if(restant < bornes->distance[node]){
+        bornes->coupesDistance++;
+        return;
+    }
+    if(restant < stack->height - 1){
+        bornes->coupesPile++;
+        return;
+    }
+    //inutile de continuer si toutes les tailles encore atteignables depuis ici ont deja un chemin
+    int minimum = bornes->distance[node] > stack->height - 1 ? bornes->distance[node] : stack->height - 1;
+    int l = pas + (minimum > 1 ? minimum : 1);
+    while(l <= length && found[l]){
+        l++;
+    }
+    if(l > length){
+        return;
+    }
+
+    int mask = tn_get_actions_by_top(network, node, tn_stack_top_symbol(stack));
+    int numSuccessors = tn_get_num_successors(network, node);
+    int* successors = tn_get_successors(network, node);
+    for(int i=0; i<numSuccessors; i++){
+        for(int action=tn_next_action(mask, 0); action<NumActions; action=tn_next_action(mask, action+1)){
+            if(tn_stack_apply(stack, action)){
+                *(path + pas) = tn_step_create(action, node, successors[i]);
+                tn_brute_force_all_aux(network, length, path, stack, pas+1, successors[i], bornes, paths, found, manquants);
+                *(path + pas) = tn_step_empty();
+                tn_stack_undo(stack, action);
+            }
+        }
+    }
+}
+
+int tn_brute_force_all_lengths(TunnelNetwork network, int length, tn_step **paths, bool *found)
+{
+    int maxTaillePile = (length/2)+1;
+    tn_stack stack;
+    tn_stack_init(&stack, maxTaillePile);
+    tn_step *path = malloc((length + 1) * sizeof(tn_step));
+    if(path == NULL){
+        printf("Malloc failded\n");
+        exit(EXIT_FAILURE);
+    }
+    for(int l=0; l<=length; l++){
+        found[l] = false;
+    }
+
+    tn_bornes bornes = {tn_compute_distances_to_final(network), 0, 0};
+    int manquants = length;
+    tn_brute_force_all_aux(network, length, path, &stack, 0, tn_get_initial(network), &bornes, paths, found, &manquants);
+
+    derniereCoupesDistance = bornes.coupesDistance;
+    derniereCoupesPile = bornes.coupesPile;
+    free(bornes.distance);
+    free(path);
+    tn_stack_free(&stack);
+
+    //la plus petite taille trouvée
+    for(int l=1; l<=length; l++){
+        if(found[l]){
+            return l;
+        }
+    }
+    return 0;
+}
+
+//variante de tn_brute_force_aux pour l'enumeration : chaque chemin valide de taille "length" est donné ...
+// a "callback" des qu'il est trouvé, puis la recherche continue ; seul le chemin courant est stocké
+//renvoi false si l'enumeration doit s'arreter (callback l'a demandé ou "restants" chemins ont été donnés)
+static bool tn_enumerate_aux(TunnelNetwork network, int length, tn_step *path, tn_stack *stack, int pas, int node, tn_bornes *bornes, tn_path_callback callback, void *data, int *restants){
+    if(pas == length){
+        if(node == tn_get_final(network) && stack->height == 1){
+            (*restants)--;
+            return callback(path, length, data) && *restants > 0;
+        }
+        return true;
+    }
+
+    int restant = length - pas;
+    if(restant < bornes->distance[node]){
+        bornes->coupesDistance++;
+        return true;
+    }
+    if(restant < stack->height - 1){
+        bornes->coupesPile++;
+        return true;
+    }
+
+    int mask = tn_get_actions_by_top(network, node, tn_stack_top_symbol(stack));
+    int numSuccessors = tn_get_num_successors(network, node);
+    int* successors = tn_get_successors(network, node);
+    for(int i=0; i<numSuccessors; i++){
+        for(int action=tn_next_action(mask, 0); action<NumActions; action=tn_next_action(mask, action+1)){
+            if(tn_stack_apply(stack, action)){
+                *(path + pas) = tn_step_create(action, node, successors[i]);
+                bool continuer = tn_enumerate_aux(network, length, path, stack, pas+1, successors[i], bornes, callback, data, restants);
+                tn_stack_undo(stack, action);
+                if(!continuer){
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+int tn_brute_force_enumerate(TunnelNetwork network, int length, int maxPaths, tn_path_callback callback, void *data)
+{
+    if(maxPaths <= 0){
+        return 0;
+    }
+    tn_step *path = malloc((length + 1) * sizeof(tn_step));
+    if(path == NULL){
         printf("Malloc failded\n");
         exit(EXIT_FAILURE);
     }
-    *stack = 4;
-    for(int i=1; i<maxTaillePile; i++){
-        *(stack + i) = -1;
+    tn_bornes bornes = {tn_compute_distances_to_final(network), 0, 0};
+    int restants = maxPaths;
+
+    //les tailles sont parcourues dans l'ordre croissant : les chemins les plus courts sont donnés en premier
+    bool continuer = true;
+    for(int l=1; l<=length && continuer; l++){
+        tn_stack stack;
+        tn_stack_init(&stack, (l/2)+1);
+        continuer = tn_enumerate_aux(network, l, path, &stack, 0, tn_get_initial(network), &bornes, callback, data, &restants);
+        tn_stack_free(&stack);
+    }
+
+    derniereCoupesDistance = bornes.coupesDistance;
+    derniereCoupesPile = bornes.coupesPile;
+    free(bornes.distance);
+    free(path);
+    return maxPaths - restants;
+}
+
+//une tache du mode parallele : un prefixe de chemin de taille "depth" deja explore, ...
+// avec l'etat de la pile et le noeud atteint a la fin de ce prefixe
+typedef struct {
+    int node;
+    tn_step *prefix; //tableau de taille depth
+    tn_stack stack;
+} tn_task;
+
+//file de taches d'un thread : le thread prend ses taches par le debut (les plus petits indices), ...
+// les autres threads lui volent des taches par la fin
+typedef struct {
+    int *tasks;
+    int head;
+    int tail;
+    pthread_mutex_t lock;
+} tn_deque;
+
+//donnees partagées par tous les threads
+typedef struct {
+    TunnelNetwork network;
+    int length;
+    int depth;
+    int maxTaillePile;
+    tn_task *tasks;
+    tn_deque *deques;
+    int numThreads;
+    atomic_int best;           //plus petit indice de tache ayant trouvé un chemin (INT_MAX sinon)
+    pthread_mutex_t bestLock;  //protege best et bestPath lors d'une mise a jour, et les coupes
+    tn_step *bestPath;
+    int *distance;             //partagé par les bornes de tous les threads
+    long coupesDistance;       //somme des coupes des threads
+    long coupesPile;
+} tn_shared;
+
+typedef struct {
+    tn_shared *shared;
+    int id;
+} tn_worker;
+
+//prend une tache dans la file du thread "id", ou en vole une dans la file d'un autre thread
+//renvoi -1 si toutes les files sont vides (aucune tache n'est creee pendant la recherche)
+static int tn_next_task(tn_shared *shared, int id){
+    tn_deque *own = &shared->deques[id];
+    int task = -1;
+    pthread_mutex_lock(&own->lock);
+    if(own->head < own->tail){
+        task = own->tasks[own->head++];
+    }
+    pthread_mutex_unlock(&own->lock);
+
+    for(int k=1; k<shared->numThreads && task == -1; k++){
+        tn_deque *victim = &shared->deques[(id + k) % shared->numThreads];
+        pthread_mutex_lock(&victim->lock);
+        if(victim->head < victim->tail){
+            task = victim->tasks[--victim->tail];
+        }
+        pthread_mutex_unlock(&victim->lock);
     }
+    return task;
+}
+
+static void *tn_brute_force_worker(void *arg){
+    tn_worker *worker = arg;
+    tn_shared *shared = worker->shared;
 
-    //la variable stackHeight represente elle le nombre d'element dans la stack actuelle
-    //par default, elle sera de taille 1 avec un premier protocole ipv4 empilé (à l'indice 0)
-    int* stackHeight = malloc(sizeof(int));
-    if(stackHeight == NULL){
+    tn_step *path = malloc(shared->length * sizeof(tn_step));
+    tn_stack stack;
+    tn_stack_init(&stack, shared->maxTaillePile);
+    if(path == NULL){
         printf("Malloc failded\n");
         exit(EXIT_FAILURE);
     }
-    *stackHeight = 1;
 
-    //node stock le numéro du noeu dans lequel on sera au fur et a mesure de l'algo (debute au 1er)
-    int node = tn_get_initial(network);
-    //pas servira a reprenter l'avancement dans le graphe => devra etre de taille length pour un chemin valide
-    int pas = 0;
+    tn_bornes bornes = {shared->distance, 0, 0};
 
-    //on lance la fonction recursive auxiliaire, et revoi son resultat
-    int res = tn_brute_force_aux(network, length, path, stack, stackHeight, pas, node);
+    int task;
+    while((task = tn_next_task(shared, worker->id)) != -1){
+        //une tache plus petite a deja trouvé un chemin : inutile d'explorer celle-ci
+        if(atomic_load(&shared->best) < task){
+            continue;
+        }
 
-    free(stack);
-    free(stackHeight);
-    
+        tn_task *t = &shared->tasks[task];
+        memcpy(path, t->prefix, shared->depth * sizeof(tn_step));
+        tn_stack_copy(&stack, &t->stack);
+
+        int res = tn_brute_force_aux(shared->network, shared->length, path, &stack, shared->depth, t->node, &shared->best, task, &bornes);
+        if(res != -1){
+            pthread_mutex_lock(&shared->bestLock);
+            if(task < atomic_load(&shared->best)){
+                memcpy(shared->bestPath, path, shared->length * sizeof(tn_step));
+                atomic_store(&shared->best, task);
+            }
+            pthread_mutex_unlock(&shared->bestLock);
+        }
+    }
+
+    pthread_mutex_lock(&shared->bestLock);
+    shared->coupesDistance += bornes.coupesDistance;
+    shared->coupesPile += bornes.coupesPile;
+    pthread_mutex_unlock(&shared->bestLock);
+
+    free(path);
+    tn_stack_free(&stack);
+    return NULL;
+}
+
+//decoupe l'arbre de recherche en taches : on developpe les prefixes niveau par niveau, dans l'ordre ...
+// du parcours en profondeur (successeurs puis actions), jusqu'a avoir au moins "minTasks" taches
+//l'ordre des taches est donc l'ordre dans lequel tn_brute_force les explorerait
+//renvoi le nombre de taches et met dans "depth" la taille de leurs prefixes
+static int tn_split_tasks(TunnelNetwork network, int length, int maxTaillePile, int minTasks, tn_task **tasks, int *depth){
+    int numTasks = 1;
+    *tasks = malloc(sizeof(tn_task));
+    if(*tasks == NULL){
+        printf("Malloc failded\n");
+        exit(EXIT_FAILURE);
+    }
+    (*tasks)[0].node = tn_get_initial(network);
+    (*tasks)[0].prefix = NULL;
+    tn_stack_init(&(*tasks)[0].stack, maxTaillePile);
+    *depth = 0;
+
+    while(numTasks > 0 && numTasks < minTasks && *depth < length){
+        int capacity = numTasks * 4;
+        int numNext = 0;
+        tn_task *next = malloc(capacity * sizeof(tn_task));
+        if(next == NULL){
+            printf("Malloc failded\n");
+            exit(EXIT_FAILURE);
+        }
+
+        for(int t=0; t<numTasks; t++){
+            tn_task *parent = &(*tasks)[t];
+            int numSuccessors = tn_get_num_successors(network, parent->node);
+            int* successors = tn_get_successors(network, parent->node);
+            int mask = tn_get_actions_by_top(network, parent->node, tn_stack_top_symbol(&parent->stack));
+            for(int i=0; i<numSuccessors; i++){
+                for(int action=tn_next_action(mask, 0); action<NumActions; action=tn_next_action(mask, action+1)){
+                    if(!tn_stack_apply(&parent->stack, action)){
+                        continue;
+                    }
+                    if(numNext == capacity){
+                        capacity *= 2;
+                        next = realloc(next, capacity * sizeof(tn_task));
+                        if(next == NULL){
+                            printf("Malloc failded\n");
+                            exit(EXIT_FAILURE);
+                        }
+                    }
+                    tn_task *child = &next[numNext++];
+                    child->node = successors[i];
+                    tn_stack_init(&child->stack, maxTaillePile);
+                    child->prefix = malloc((*depth + 1) * sizeof(tn_step));
+                    if(child->prefix == NULL){
+                        printf("Malloc failded\n");
+                        exit(EXIT_FAILURE);
+                    }
+                    tn_stack_copy(&child->stack, &parent->stack);
+                    if(*depth > 0){
+                        memcpy(child->prefix, parent->prefix, *depth * sizeof(tn_step));
+                    }
+                    child->prefix[*depth] = tn_step_create(action, parent->node, successors[i]);
+                    tn_stack_undo(&parent->stack, action);
+                }
+            }
+            tn_stack_free(&parent->stack);
+            free(parent->prefix);
+        }
+        free(*tasks);
+        *tasks = next;
+        numTasks = numNext;
+        (*depth)++;
+    }
+    return numTasks;
+}
+
+int tn_brute_force_parallel(TunnelNetwork network, int length, tn_step *path, int numThreads)
+{
+    if(numThreads <= 1 || length <= 0){
+        int res = tn_brute_force(network, length, path);
+        return res > 0 ? res : 0;
+    }
+
+    tn_shared shared;
+    shared.network = network;
+    shared.length = length;
+    shared.maxTaillePile = (length/2)+1;
+    shared.numThreads = numThreads;
+    shared.distance = tn_compute_distances_to_final(network);
+    shared.coupesDistance = 0;
+    shared.coupesPile = 0;
+    int numTasks = tn_split_tasks(network, length, shared.maxTaillePile, 32 * numThreads, &shared.tasks, &shared.depth);
+
+    //les taches sont distribuées en alternance, pour que chaque thread commence par les plus petites
+    shared.deques = malloc(numThreads * sizeof(tn_deque));
+    shared.bestPath = malloc(length * sizeof(tn_step));
+    if(shared.deques == NULL || shared.bestPath == NULL){
+        printf("Malloc failded\n");
+        exit(EXIT_FAILURE);
+    }
+    for(int id=0; id<numThreads; id++){
+        tn_deque *deque = &shared.deques[id];
+        deque->tasks = malloc((numTasks / numThreads + 1) * sizeof(int));
+        deque->head = 0;
+        deque->tail = 0;
+        pthread_mutex_init(&deque->lock, NULL);
+        for(int task=id; task<numTasks; task+=numThreads){
+            deque->tasks[deque->tail++] = task;
+        }
+    }
+    atomic_init(&shared.best, INT_MAX);
+    pthread_mutex_init(&shared.bestLock, NULL);
+
+    pthread_t threads[numThreads];
+    tn_worker workers[numThreads];
+    for(int id=0; id<numThreads; id++){
+        workers[id].shared = &shared;
+        workers[id].id = id;
+        if(pthread_create(&threads[id], NULL, tn_brute_force_worker, &workers[id]) != 0){
+            printf("Could not create thread %d\n", id);
+            exit(EXIT_FAILURE);
+        }
+    }
+    for(int id=0; id<numThreads; id++){
+        pthread_join(threads[id], NULL);
+    }
+
+    int res = 0;
+    if(atomic_load(&shared.best) != INT_MAX){
+        memcpy(path, shared.bestPath, length * sizeof(tn_step));
+        res = length;
+    }
+    derniereCoupesDistance = shared.coupesDistance;
+    derniereCoupesPile = shared.coupesPile;
+
+    for(int task=0; task<numTasks; task++){
+        tn_stack_free(&shared.tasks[task].stack);
+        free(shared.tasks[task].prefix);
+    }
+    free(shared.tasks);
+    for(int id=0; id<numThreads; id++){
+        free(shared.deques[id].tasks);
+        pthread_mutex_destroy(&shared.deques[id].lock);
+    }
+    free(shared.deques);
+    free(shared.bestPath);
+    free(shared.distance);
+    pthread_mutex_destroy(&shared.bestLock);
     return res;
-}
\ No newline at end of file
+}
+
+void tn_brute_force_get_cuts(long *distanceCuts, long *stackCuts)
+{
+    *distanceCuts = derniereCoupesDistance;
+    *stackCuts = derniereCoupesPile;
+}
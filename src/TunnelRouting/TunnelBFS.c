@@ -0,0 +1,253 @@
+#include "TunnelBFS.h"
+#include "TunnelNetwork.h"
+#include "TunnelStack.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+/**
+ * @brief A configuration reached by the search. Its stack is stored in the pool, as the word low of a tn_stack followed by its words high.
+ *
+ */
+typedef struct
+{
+    int node;            ///< The node where the packet is.
+    int height;          ///< The number of cells of the stack.
+    int parent;          ///< The index of the configuration before the last step (-1 for the initial configuration).
+    stack_action action; ///< The action performed by the node of the parent configuration.
+} tn_configuration;
+
+/**
+ * @brief All the configurations reached so far, layer after layer, and the hash set of the current layer.
+ *
+ */
+typedef struct
+{
+    tn_configuration *configurations; ///< The configurations.
+    uint64_t *stacks;                 ///< The stacks of the configurations, num_words words each.
+    int num_words;                    ///< The number of words of a stack.
+    int size;                         ///< The number of configurations.
+    int capacity;                     ///< The allocated number of configurations.
+    int *slots;                       ///< Open-addressing set of the configurations of the current layer (-1 if empty).
+    int num_slots;                    ///< The number of slots (a power of 2).
+    int layer_size;                   ///< The number of configurations of the current layer.
+    tn_stack buffer;                  ///< A stack to load the stored ones.
+} tn_pool;
+
+/**
+ * @brief Returns the stack of the configuration @p index.
+ */
+static inline uint64_t *tn_pool_stack(tn_pool *pool, int index)
+{
+    return pool->stacks + (size_t)index * pool->num_words;
+}
+
+/**
+ * @brief Writes the cells of @p stack in the configuration @p index.
+ */
+static inline void tn_pool_store(tn_pool *pool, int index, tn_stack *stack)
+{
+    uint64_t *words = tn_pool_stack(pool, index);
+    words[0] = stack->low;
+    if (stack->high != NULL)
+        memcpy(words + 1, stack->high, (pool->num_words - 1) * sizeof(uint64_t));
+}
+
+/**
+ * @brief Loads the stack of the configuration @p index in @p stack.
+ */
+static inline void tn_pool_load(tn_pool *pool, int index, tn_stack *stack)
+{
+    uint64_t *words = tn_pool_stack(pool, index);
+    stack->height = pool->configurations[index].height;
+    stack->low = words[0];
+    if (stack->high != NULL)
+        memcpy(stack->high, words + 1, (pool->num_words - 1) * sizeof(uint64_t));
+}
+
+/**
+ * @brief Tells if the configuration @p index has the stack @p stack.
+ */
+static inline bool tn_pool_has_stack(tn_pool *pool, int index, tn_stack *stack)
+{
+    uint64_t *words = tn_pool_stack(pool, index);
+    if (pool->configurations[index].height != stack->height || words[0] != stack->low)
+        return false;
+    return stack->high == NULL || memcmp(words + 1, stack->high, (pool->num_words - 1) * sizeof(uint64_t)) == 0;
+}
+
+/**
+ * @brief Hash of a configuration.
+ */
+static inline uint64_t tn_configuration_hash(int node, tn_stack *stack)
+{
+    return tn_stack_hash(stack) ^ ((uint64_t)node * 0x9e3779b97f4a7c15ULL);
+}
+
+/**
+ * @brief Empties the hash set, so that a new layer can start. The set is enlarged if the previous layer filled more than half of it.
+ */
+static void tn_pool_new_layer(tn_pool *pool)
+{
+    if (2 * pool->layer_size >= pool->num_slots)
+    {
+        while (2 * pool->layer_size >= pool->num_slots)
+            pool->num_slots *= 2;
+        free(pool->slots);
+        pool->slots = malloc(pool->num_slots * sizeof(int));
+    }
+    memset(pool->slots, -1, pool->num_slots * sizeof(int));
+    pool->layer_size = 0;
+}
+
+/**
+ * @brief Adds the configuration (@p node, @p stack) to the current layer if it is not already in it.
+ *
+ * @return true if the configuration was added.
+ */
+static bool tn_pool_add(tn_pool *pool, int node, tn_stack *stack, int parent, stack_action action)
+{
+    // the set is kept at most half full
+    if (2 * (pool->layer_size + 1) > pool->num_slots)
+    {
+        int old_num_slots = pool->num_slots;
+        int *old_slots = pool->slots;
+        pool->num_slots *= 2;
+        pool->slots = malloc(pool->num_slots * sizeof(int));
+        memset(pool->slots, -1, pool->num_slots * sizeof(int));
+        for (int i = 0; i < old_num_slots; i++)
+        {
+            if (old_slots[i] == -1)
+                continue;
+            tn_pool_load(pool, old_slots[i], &pool->buffer);
+            int slot = tn_configuration_hash(pool->configurations[old_slots[i]].node, &pool->buffer) & (pool->num_slots - 1);
+            while (pool->slots[slot] != -1)
+                slot = (slot + 1) & (pool->num_slots - 1);
+            pool->slots[slot] = old_slots[i];
+        }
+        free(old_slots);
+    }
+
+    int slot = tn_configuration_hash(node, stack) & (pool->num_slots - 1);
+    while (pool->slots[slot] != -1)
+    {
+        int index = pool->slots[slot];
+        if (pool->configurations[index].node == node && tn_pool_has_stack(pool, index, stack))
+            return false;
+        slot = (slot + 1) & (pool->num_slots - 1);
+    }
+
+    if (pool->size == pool->capacity)
+    {
+        pool->capacity *= 2;
+        pool->configurations = realloc(pool->configurations, pool->capacity * sizeof(tn_configuration));
+        pool->stacks = realloc(pool->stacks, (size_t)pool->capacity * pool->num_words * sizeof(uint64_t));
+        if (pool->configurations == NULL || pool->stacks == NULL)
+        {
+            printf("Malloc failed\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    int index = pool->size++;
+    pool->configurations[index].node = node;
+    pool->configurations[index].height = stack->height;
+    pool->configurations[index].parent = parent;
+    pool->configurations[index].action = action;
+    tn_pool_store(pool, index, stack);
+    pool->slots[slot] = index;
+    pool->layer_size++;
+    return true;
+}
+
+int tn_bfs(TunnelNetwork network, int length, tn_step *path)
+{
+    int final = tn_get_final(network);
+
+    // a path of size length never has more than length/2+1 cells in its stack
+    tn_pool pool;
+    tn_stack stack;
+    tn_stack_init(&stack, length / 2 + 1);
+    tn_stack_init(&pool.buffer, length / 2 + 1);
+    pool.num_words = 1 + tn_stack_num_high_words(length / 2 + 1);
+    pool.capacity = 1024;
+    pool.size = 0;
+    pool.configurations = malloc(pool.capacity * sizeof(tn_configuration));
+    pool.stacks = calloc((size_t)pool.capacity * pool.num_words, sizeof(uint64_t));
+    pool.num_slots = 1024;
+    pool.slots = malloc(pool.num_slots * sizeof(int));
+    pool.layer_size = 0;
+    if (pool.configurations == NULL || pool.stacks == NULL || pool.slots == NULL)
+    {
+        printf("Malloc failed\n");
+        exit(EXIT_FAILURE);
+    }
+
+    // initial configuration : a single IPv4 cell
+    tn_pool_new_layer(&pool);
+    tn_pool_add(&pool, tn_get_initial(network), &stack, -1, transmit_4);
+
+    int layer_begin = 0;
+    int found = -1;
+    int pos;
+    for (pos = 0; pos < length && found == -1; pos++)
+    {
+        int layer_end = pool.size;
+        tn_pool_new_layer(&pool);
+
+        for (int index = layer_begin; index < layer_end && found == -1; index++)
+        {
+            int node = pool.configurations[index].node;
+            tn_pool_load(&pool, index, &stack);
+            int mask = tn_get_actions_by_top(network, node, tn_stack_top_symbol(&stack));
+            int num_successors = tn_get_num_successors(network, node);
+            int *successors = tn_get_successors(network, node);
+
+            for (int action = tn_next_action(mask, 0); action < NumActions; action = tn_next_action(mask, action + 1))
+            {
+                tn_pool_load(&pool, index, &stack);
+                if (!tn_stack_apply(&stack, action))
+                    continue;
+                // the cells above the bottom must all be popped in the remaining steps
+                if (stack.height - 1 > length - (pos + 1))
+                    continue;
+
+                for (int i = 0; i < num_successors; i++)
+                {
+                    if (!tn_pool_add(&pool, successors[i], &stack, index, action))
+                        continue;
+                    if (successors[i] == final && stack.height == 1)
+                    {
+                        found = pool.size - 1;
+                        break;
+                    }
+                }
+                if (found != -1)
+                    break;
+            }
+        }
+        layer_begin = layer_end;
+    }
+
+    int res = 0;
+    if (found != -1)
+    {
+        // the last step found is at position pos-1, we go back to the initial configuration
+        res = pos;
+        int index = found;
+        for (int step = res - 1; step >= 0; step--)
+        {
+            int parent = pool.configurations[index].parent;
+            path[step] = tn_step_create(pool.configurations[index].action, pool.configurations[parent].node, pool.configurations[index].node);
+            index = parent;
+        }
+    }
+
+    tn_stack_free(&stack);
+    tn_stack_free(&pool.buffer);
+    free(pool.configurations);
+    free(pool.stacks);
+    free(pool.slots);
+    return res;
+}
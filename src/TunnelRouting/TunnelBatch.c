@@ -0,0 +1,157 @@
+#include "TunnelBatch.h"
+#include "TunnelNetwork.h"
+#include "TunnelReach.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+/**
+ * @brief The network whose node names are compared by tn_compare_names (qsort and bsearch take no extra argument).
+ */
+static TunnelNetwork tn_named_network;
+
+/**
+ * @brief Compares the names of two nodes (pointed to by @p a and @p b) of tn_named_network.
+ */
+static int tn_compare_names(const void *a, const void *b)
+{
+    return strcmp(tn_get_node_name(tn_named_network, *(const int *)a), tn_get_node_name(tn_named_network, *(const int *)b));
+}
+
+/**
+ * @brief Compares a name (pointed to by @p key) to the name of a node (pointed to by @p element) of tn_named_network.
+ */
+static int tn_compare_name_to_node(const void *key, const void *element)
+{
+    return strcmp((const char *)key, tn_get_node_name(tn_named_network, *(const int *)element));
+}
+
+int tn_batch_read_queries(TunnelNetwork network, char *file_name, tn_query **queries)
+{
+    FILE *file = fopen(file_name, "r");
+    if (file == NULL)
+        return -1;
+
+    // the nodes sorted by name, to find the names of the file by dichotomy
+    int num_nodes = tn_get_num_nodes(network);
+    int *sorted = malloc(num_nodes * sizeof(int));
+    int capacity = 64;
+    tn_query *result = malloc(capacity * sizeof(tn_query));
+    if (sorted == NULL || result == NULL)
+    {
+        printf("Malloc failed\n");
+        exit(EXIT_FAILURE);
+    }
+    for (int node = 0; node < num_nodes; node++)
+        sorted[node] = node;
+    tn_named_network = network;
+    qsort(sorted, num_nodes, sizeof(int), tn_compare_names);
+
+    int num_queries = 0;
+    char line[1024];
+    int line_number = 0;
+    while (fgets(line, sizeof(line), file) != NULL)
+    {
+        line_number++;
+        char initial[512], final[512];
+        int length;
+        char *start = line + strspn(line, " \t");
+        if (*start == '\n' || *start == '\r' || *start == '\0' || *start == '#')
+            continue;
+        if (sscanf(start, "%511s %511s %d", initial, final, &length) != 3 || length < 1)
+        {
+            printf("%s:%d: expected \"INITIAL FINAL SIZE\", line ignored.\n", file_name, line_number);
+            continue;
+        }
+        int *initial_node = bsearch(initial, sorted, num_nodes, sizeof(int), tn_compare_name_to_node);
+        int *final_node = bsearch(final, sorted, num_nodes, sizeof(int), tn_compare_name_to_node);
+        if (initial_node == NULL || final_node == NULL)
+        {
+            printf("%s:%d: unknown node %s, line ignored.\n", file_name, line_number, initial_node == NULL ? initial : final);
+            continue;
+        }
+
+        if (num_queries == capacity)
+        {
+            capacity *= 2;
+            result = realloc(result, capacity * sizeof(tn_query));
+            if (result == NULL)
+            {
+                printf("Malloc failed\n");
+                exit(EXIT_FAILURE);
+            }
+        }
+        result[num_queries].initial = *initial_node;
+        result[num_queries].final = *final_node;
+        result[num_queries].length = length;
+        num_queries++;
+    }
+
+    fclose(file);
+    free(sorted);
+    *queries = result;
+    return num_queries;
+}
+
+/**
+ * @brief The questions compared by tn_compare_initials.
+ */
+static tn_query *tn_sorted_queries;
+
+/**
+ * @brief Compares the initial nodes of two questions (pointed to by @p a and @p b, indexes in tn_sorted_queries), then their indexes so that the order is stable.
+ */
+static int tn_compare_initials(const void *a, const void *b)
+{
+    int i = *(const int *)a;
+    int j = *(const int *)b;
+    if (tn_sorted_queries[i].initial != tn_sorted_queries[j].initial)
+        return tn_sorted_queries[i].initial < tn_sorted_queries[j].initial ? -1 : 1;
+    return i < j ? -1 : (i > j);
+}
+
+int tn_batch_solve(TunnelNetwork network, tn_query *queries, int num_queries, int *results, tn_step **paths)
+{
+    int *order = malloc(num_queries * sizeof(int));
+    if (num_queries > 0 && order == NULL)
+    {
+        printf("Malloc failed\n");
+        exit(EXIT_FAILURE);
+    }
+    for (int i = 0; i < num_queries; i++)
+        order[i] = i;
+    tn_sorted_queries = queries;
+    qsort(order, num_queries, sizeof(int), tn_compare_initials);
+
+    int num_explorations = 0;
+    int begin = 0;
+    while (begin < num_queries)
+    {
+        // the group of the questions from the same initial node, explored up to its largest size
+        int initial = queries[order[begin]].initial;
+        int end = begin;
+        int length = 0;
+        while (end < num_queries && queries[order[end]].initial == initial)
+        {
+            if (queries[order[end]].length > length)
+                length = queries[order[end]].length;
+            end++;
+        }
+
+        TunnelReach reach = tn_reach_create(network, initial, length);
+        num_explorations++;
+        for (int k = begin; k < end; k++)
+        {
+            int i = order[k];
+            int res = tn_reach_get_length(reach, queries[i].final);
+            results[i] = res <= queries[i].length ? res : 0;
+            if (results[i] > 0 && paths != NULL)
+                tn_reach_get_path(reach, queries[i].final, paths[i]);
+        }
+        tn_reach_delete(reach);
+        begin = end;
+    }
+
+    free(order);
+    return num_explorations;
+}
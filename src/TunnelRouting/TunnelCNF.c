@@ -0,0 +1,617 @@
+#include "TunnelCNF.h"
+#include "CNF.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+/**
+ * @brief The literals of the variables of the reduction (named as in TunnelReduction.c), CNF_FALSE for the variables that are false in every model, and the solver.
+ *
+ */
+struct TunnelCNF_s
+{
+    TunnelNetwork network; ///< The network.
+    int length;            ///< The size of the path (the bound for an incremental solver).
+    int num_nodes;         ///< The number of nodes of the network.
+    int stack_size;        ///< The number of cells of the stack (get_stack_size(length)).
+    int *path;             ///< The literals x_{node,pos,height}, indexed by (pos * num_nodes + node) * stack_size + height.
+    int *four;             ///< The literals y_{pos,height,4}, indexed by pos * stack_size + height.
+    int *six;              ///< The literals y_{pos,height,6}, indexed by pos * stack_size + height.
+    tn_encoding encoding;  ///< The encoding of the uniqueness constraints.
+    int *node;             ///< With tn_factored_encoding, the literals n_{node,pos}, indexed by pos * num_nodes + node (NULL otherwise).
+    int *height;           ///< With tn_factored_encoding, the literals h_{pos,height}, indexed by pos * stack_size + height (NULL otherwise).
+    int *cases;            ///< The literal implying the cells of an action at a position and a height, indexed by (pos * stack_size + height) * NumActions + action (0 if not created yet).
+    bool *alive;           ///< alive[pos * num_nodes + node] tells if the packet can be at node at position pos.
+    int *max_height;       ///< max_height[pos] is the highest cell that can be occupied at position pos.
+    SatSolver solver;      ///< The solver, which contains the clauses of the positions 0..num_positions-1.
+    bool incremental;      ///< Tells if the final condition is guarded (solver created by tn_cnf_incremental_create).
+    int num_positions;     ///< The number of positions whose clauses have been added.
+    int *guards;           ///< guards[l] implies the final condition for the length l (0 if not created yet).
+};
+
+static void *tn_cnf_malloc(size_t size)
+{
+    void *result = malloc(size);
+    if (result == NULL && size > 0)
+    {
+        printf("Malloc failed\n");
+        exit(EXIT_FAILURE);
+    }
+    return result;
+}
+
+static inline int tn_cnf_path(TunnelCNF cnf, int node, int pos, int height)
+{
+    return cnf->path[(pos * cnf->num_nodes + node) * cnf->stack_size + height];
+}
+
+static inline bool tn_cnf_is_alive(TunnelCNF cnf, int node, int pos, int height)
+{
+    return cnf->alive[pos * cnf->num_nodes + node] && height <= cnf->max_height[pos];
+}
+
+static inline int tn_cnf_4(TunnelCNF cnf, int pos, int height)
+{
+    return cnf->four[pos * cnf->stack_size + height];
+}
+
+static inline int tn_cnf_6(TunnelCNF cnf, int pos, int height)
+{
+    return cnf->six[pos * cnf->stack_size + height];
+}
+
+static inline int tn_cnf_symbol(TunnelCNF cnf, int pos, int height, int symbol)
+{
+    return symbol == 4 ? tn_cnf_4(cnf, pos, height) : tn_cnf_6(cnf, pos, height);
+}
+
+/**
+ * @brief Returns the class of the actions changing the height by @p delta (-1, 0 or 1).
+ */
+static inline tn_action_class tn_cnf_class_of_delta(int delta)
+{
+    return delta == 0 ? tn_transmit_class : (delta > 0 ? tn_push_class : tn_pop_class);
+}
+
+/**
+ * @brief Creates the variables (see tn_variables_build in TunnelReduction.c, which discards the same ones).
+ */
+static TunnelCNF tn_cnf_build(TunnelNetwork network, int length, tn_encoding encoding, bool backward)
+{
+    TunnelCNF cnf = tn_cnf_malloc(sizeof(*cnf));
+    cnf->network = network;
+    cnf->length = length;
+    cnf->num_nodes = tn_get_num_nodes(network);
+    cnf->stack_size = get_stack_size(length);
+    cnf->encoding = encoding;
+    int N = cnf->num_nodes;
+    int H = cnf->stack_size;
+
+    long num_path = (long)(length + 1) * N * H;
+    long num_cells = (long)(length + 1) * H;
+    long num_node = (long)(length + 1) * N;
+    long num_factored = (encoding == tn_factored_encoding) ? num_node + num_cells : 0;
+    if (num_path + (2 + NumActions) * num_cells + num_factored >= (1L << 30))
+    {
+        fprintf(stderr, "Error: too many variables for the reduction (length %d, %d nodes).\n", length, N);
+        exit(EXIT_FAILURE);
+    }
+
+    cnf->alive = tn_cnf_malloc(num_node * sizeof(bool));
+    cnf->max_height = tn_cnf_malloc((length + 1) * sizeof(int));
+    tn_compute_alive(network, length, backward, cnf->alive);
+    for (int pos = 0; pos <= length; pos++)
+    {
+        int max_height = backward && length - pos < pos ? length - pos : pos;
+        cnf->max_height[pos] = max_height < H - 1 ? max_height : H - 1;
+    }
+
+    cnf->solver = cnf_create_solver();
+    cnf->path = tn_cnf_malloc(num_path * sizeof(int));
+    cnf->four = tn_cnf_malloc(num_cells * sizeof(int));
+    cnf->six = tn_cnf_malloc(num_cells * sizeof(int));
+    for (long i = 0; i < num_path; i++)
+    {
+        long pos_node = i / H;
+        bool alive = cnf->alive[pos_node] && i % H <= cnf->max_height[pos_node / N];
+        cnf->path[i] = alive ? sat_new_var(cnf->solver) : CNF_FALSE;
+    }
+    for (long i = 0; i < num_cells; i++)
+    {
+        bool alive = i % H <= cnf->max_height[i / H];
+        cnf->four[i] = alive ? sat_new_var(cnf->solver) : CNF_FALSE;
+        cnf->six[i] = alive ? sat_new_var(cnf->solver) : CNF_FALSE;
+    }
+
+    cnf->node = NULL;
+    cnf->height = NULL;
+    if (encoding == tn_factored_encoding)
+    {
+        cnf->node = tn_cnf_malloc(num_node * sizeof(int));
+        cnf->height = tn_cnf_malloc(num_cells * sizeof(int));
+        for (long i = 0; i < num_node; i++)
+            cnf->node[i] = cnf->alive[i] ? sat_new_var(cnf->solver) : CNF_FALSE;
+        for (long i = 0; i < num_cells; i++)
+            cnf->height[i] = i % H <= cnf->max_height[i / H] ? sat_new_var(cnf->solver) : CNF_FALSE;
+    }
+
+    cnf->cases = calloc(num_cells * NumActions, sizeof(int));
+    cnf->guards = calloc(length + 1, sizeof(int));
+    if (cnf->cases == NULL || cnf->guards == NULL)
+    {
+        printf("Malloc failed\n");
+        exit(EXIT_FAILURE);
+    }
+    cnf->incremental = !backward;
+    cnf->num_positions = 0;
+    return cnf;
+}
+
+/**
+ * @brief le paquet est au nœud @p node a la position @p pos, avec une pile reduite a un paquet IPv4 (si @p guard est vrai, 0 pour aucune garde).
+ */
+static void tn_cnf_endpoint(TunnelCNF cnf, int node, int pos, int guard)
+{
+    int num_premises = guard != 0 ? 1 : 0;
+    int unit = tn_cnf_path(cnf, node, pos, 0);
+    cnf_add_implies(cnf->solver, &guard, num_premises, &unit, 1);
+    unit = tn_cnf_4(cnf, pos, 0);
+    cnf_add_implies(cnf->solver, &guard, num_premises, &unit, 1);
+    for (int n = 0; n < cnf->num_nodes; ++n)
+    {
+        for (int h = 0; h < cnf->stack_size; ++h)
+        {
+            if ((n == node && h == 0) || !tn_cnf_is_alive(cnf, n, pos, h))
+                continue;
+            unit = -tn_cnf_path(cnf, n, pos, h);
+            cnf_add_implies(cnf->solver, &guard, num_premises, &unit, 1);
+        }
+    }
+}
+
+/**
+ * @brief a chaque position pos, exactement un couple (node,height) est vrai (par paires).
+ */
+static void tn_cnf_layer_uniqueness(TunnelCNF cnf, int pos)
+{
+    int N = cnf->num_nodes;
+    int H = cnf->stack_size;
+    int *lits = tn_cnf_malloc((N * H + 1) * sizeof(int));
+    int num_lits = 0;
+    for (int n = 0; n < N; ++n)
+        for (int h = 0; h < H; ++h)
+            if (tn_cnf_is_alive(cnf, n, pos, h))
+                lits[num_lits++] = tn_cnf_path(cnf, n, pos, h);
+    cnf_unique(cnf->solver, lits, num_lits);
+    free(lits);
+}
+
+/**
+ * @brief a chaque position pos, exactement un nœud et une hauteur, et x(n,pos,h) ⇔ n(n,pos) ∧ h(pos,h).
+ */
+static void tn_cnf_layer_uniqueness_factored(TunnelCNF cnf, int pos)
+{
+    int N = cnf->num_nodes;
+    int H = cnf->stack_size;
+    int *nodes = cnf->node + pos * N;
+    int *heights = cnf->height + pos * H;
+
+    int *alive_nodes = tn_cnf_malloc((N + 1) * sizeof(int));
+    int num_alive = 0;
+    for (int n = 0; n < N; ++n)
+        if (cnf->alive[pos * N + n])
+            alive_nodes[num_alive++] = nodes[n];
+    // aucun nœud possible a cette position : la clause vide rend la formule insatisfiable
+    if (num_alive == 0)
+        sat_add_clause(cnf->solver, NULL, 0);
+    else
+        cnf_unique_sequential(cnf->solver, alive_nodes, num_alive);
+    cnf_unique_sequential(cnf->solver, heights, cnf->max_height[pos] + 1);
+    free(alive_nodes);
+
+    for (int n = 0; n < N; ++n)
+    {
+        for (int h = 0; h < H; ++h)
+        {
+            if (!tn_cnf_is_alive(cnf, n, pos, h))
+                continue;
+            int x = tn_cnf_path(cnf, n, pos, h);
+            cnf_add_binary(cnf->solver, -x, nodes[n]);
+            cnf_add_binary(cnf->solver, -x, heights[h]);
+            cnf_add_ternary(cnf->solver, -nodes[n], -heights[h], x);
+        }
+    }
+}
+
+/**
+ * @brief Si on est au nœud u a pos, alors le nœud v a pos+1 doit être un voisin (avec une hauteur que u peut atteindre).
+ */
+static void tn_cnf_layer_edges(TunnelCNF cnf, int pos)
+{
+    TunnelNetwork network = cnf->network;
+    int H = cnf->stack_size;
+
+    for (int u = 0; u < cnf->num_nodes; ++u)
+    {
+        int degree = tn_get_num_successors(network, u);
+        int *successors = tn_get_successors(network, u);
+        int classes = tn_get_action_classes(network, u);
+        int *nexts = tn_cnf_malloc((3 * degree + 1) * sizeof(int));
+
+        for (int h = 0; h < H; ++h)
+        {
+            if (!tn_cnf_is_alive(cnf, u, pos, h))
+                continue;
+            int premise = tn_cnf_path(cnf, u, pos, h);
+            int ni = 0;
+            for (int k = 0; k < degree; ++k)
+            {
+                for (int hp = h - 1; hp <= h + 1; ++hp)
+                {
+                    if (hp < 0 || hp >= H || !(classes & (1 << tn_cnf_class_of_delta(hp - h))) || !tn_cnf_is_alive(cnf, successors[k], pos + 1, hp))
+                        continue;
+                    nexts[ni++] = tn_cnf_path(cnf, successors[k], pos + 1, hp);
+                }
+            }
+            // sans successeur possible, la clause se réduit à ¬x(u,pos,h)
+            cnf_add_implies(cnf->solver, &premise, 1, nexts, ni);
+        }
+        free(nexts);
+    }
+}
+
+/**
+ * @brief pas de case a la fois IPv4 et IPv6, et si une case est vide, la suivante aussi (donc toutes celles au-dessus).
+ */
+static void tn_cnf_layer_stack_wellformed(TunnelCNF cnf, int pos)
+{
+    int H = cnf->max_height[pos] + 1;
+    for (int h = 0; h < H; ++h)
+    {
+        cnf_add_binary(cnf->solver, -tn_cnf_4(cnf, pos, h), -tn_cnf_6(cnf, pos, h));
+        if (h + 1 < H)
+        {
+            cnf_add_ternary(cnf->solver, tn_cnf_4(cnf, pos, h), tn_cnf_6(cnf, pos, h), -tn_cnf_4(cnf, pos, h + 1));
+            cnf_add_ternary(cnf->solver, tn_cnf_4(cnf, pos, h), tn_cnf_6(cnf, pos, h), -tn_cnf_6(cnf, pos, h + 1));
+        }
+    }
+}
+
+/**
+ * @brief Si x(n,pos,h) est vrai alors la case (pos,h) est occupée et la case (pos,h+1) est vide.
+ */
+static void tn_cnf_layer_occupancy(TunnelCNF cnf, int pos)
+{
+    for (int h = 0; h < cnf->stack_size; ++h)
+    {
+        bool above = h + 1 <= cnf->max_height[pos];
+        for (int n = 0; n < cnf->num_nodes; ++n)
+        {
+            if (!tn_cnf_is_alive(cnf, n, pos, h))
+                continue;
+            int x = tn_cnf_path(cnf, n, pos, h);
+            cnf_add_ternary(cnf->solver, -x, tn_cnf_4(cnf, pos, h), tn_cnf_6(cnf, pos, h));
+            if (above)
+            {
+                cnf_add_binary(cnf->solver, -x, -tn_cnf_4(cnf, pos, h + 1));
+                cnf_add_binary(cnf->solver, -x, -tn_cnf_6(cnf, pos, h + 1));
+            }
+        }
+    }
+}
+
+/**
+ * @brief les cases strictement sous le sommet sont recopiées de pos a pos+1.
+ */
+static void tn_cnf_layer_stack_frame(TunnelCNF cnf, int pos)
+{
+    for (int k = 0; k + 1 < cnf->stack_size && k + 1 <= cnf->max_height[pos]; ++k)
+    {
+        int occupied[2] = {tn_cnf_4(cnf, pos, k + 1), tn_cnf_6(cnf, pos, k + 1)};
+        int before[2] = {tn_cnf_4(cnf, pos, k), tn_cnf_6(cnf, pos, k)};
+        int after[2] = {tn_cnf_4(cnf, pos + 1, k), tn_cnf_6(cnf, pos + 1, k)};
+        for (int o = 0; o < 2; ++o)
+        {
+            for (int s = 0; s < 2; ++s)
+            {
+                // occ(pos,k+1) ⇒ (y(pos,k) ⇔ y(pos+1,k))
+                cnf_add_ternary(cnf->solver, -occupied[o], -before[s], after[s]);
+                cnf_add_ternary(cnf->solver, -occupied[o], before[s], -after[s]);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Le littéral qui implique les cases lues et écrites par @p action de la hauteur @p h a la position @p pos vers la position pos+1, créé a la première demande.
+ */
+static int tn_cnf_action_case(TunnelCNF cnf, int pos, int h, int action)
+{
+    int *entry = &cnf->cases[(pos * cnf->stack_size + h) * NumActions + action];
+    if (*entry != 0)
+        return *entry;
+
+    const tn_action_semantics *semantics = &tn_action_table[action];
+    int hp = h + semantics->delta;
+    int conj[3];
+    int k = 0;
+    conj[k++] = tn_cnf_symbol(cnf, pos, h, semantics->top);
+    if (semantics->delta == 0)
+        conj[k++] = tn_cnf_symbol(cnf, pos + 1, h, semantics->result_top);
+    else if (semantics->delta > 0)
+    {
+        conj[k++] = tn_cnf_symbol(cnf, pos + 1, h, semantics->top);
+        conj[k++] = tn_cnf_symbol(cnf, pos + 1, hp, semantics->result_top);
+    }
+    else
+    {
+        conj[k++] = tn_cnf_symbol(cnf, pos, h - 1, semantics->second);
+        conj[k++] = tn_cnf_symbol(cnf, pos + 1, hp, semantics->result_top);
+    }
+
+    *entry = sat_new_var(cnf->solver);
+    for (int i = 0; i < k; i++)
+        cnf_add_binary(cnf->solver, -*entry, conj[i]);
+    return *entry;
+}
+
+/**
+ * @brief cur(n,pos,h) ∧ nxt(m,pos+1,hp) ⇒ l'une des actions de n de variation hp-h s'applique.
+ */
+static void tn_cnf_layer_actions(TunnelCNF cnf, int pos)
+{
+    TunnelNetwork network = cnf->network;
+    int H = cnf->stack_size;
+
+    for (int n = 0; n < cnf->num_nodes; ++n)
+    {
+        int degree = tn_get_num_successors(network, n);
+        int *successors = tn_get_successors(network, n);
+        int classes = tn_get_action_classes(network, n);
+        for (int h = 0; h < H; ++h)
+        {
+            if (!tn_cnf_is_alive(cnf, n, pos, h))
+                continue;
+            for (int hp = h - 1; hp <= h + 1; ++hp)
+            {
+                tn_action_class action_class = tn_cnf_class_of_delta(hp - h);
+                if (hp < 0 || hp >= H || !(classes & (1 << action_class)))
+                    continue;
+
+                // les cas ne dépendent pas du successeur : ils sont calculés une fois pour tous
+                int cases[NumActions];
+                int nc = 0;
+                int mask = tn_get_actions_of_class(network, n, action_class);
+                for (int action = tn_next_action(mask, 0); action < NumActions; action = tn_next_action(mask, action + 1))
+                    cases[nc++] = tn_cnf_action_case(cnf, pos, h, action);
+
+                for (int k = 0; k < degree; ++k)
+                {
+                    int m = successors[k];
+                    if (!tn_cnf_is_alive(cnf, m, pos + 1, hp))
+                        continue;
+                    int antecedent[2] = {tn_cnf_path(cnf, n, pos, h), tn_cnf_path(cnf, m, pos + 1, hp)};
+                    cnf_add_implies(cnf->solver, antecedent, 2, cases, nc);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Toutes les clauses qui concernent la position pos : celles de la position elle-même, et celles de la transition pos-1 -> pos.
+ */
+static void tn_cnf_layer_position(TunnelCNF cnf, int pos)
+{
+    if (cnf->encoding == tn_factored_encoding)
+        tn_cnf_layer_uniqueness_factored(cnf, pos);
+    else
+        tn_cnf_layer_uniqueness(cnf, pos);
+    tn_cnf_layer_stack_wellformed(cnf, pos);
+    tn_cnf_layer_occupancy(cnf, pos);
+    if (pos > 0)
+    {
+        tn_cnf_layer_edges(cnf, pos - 1);
+        tn_cnf_layer_stack_frame(cnf, pos - 1);
+        tn_cnf_layer_actions(cnf, pos - 1);
+    }
+}
+
+TunnelCNF tn_cnf_create(TunnelNetwork network, int length, tn_encoding encoding)
+{
+    assert(length >= 1);
+    TunnelCNF cnf = tn_cnf_build(network, length, encoding, true);
+    tn_cnf_endpoint(cnf, tn_get_initial(network), 0, 0);
+    tn_cnf_endpoint(cnf, tn_get_final(network), length, 0);
+    while (cnf->num_positions <= length)
+        tn_cnf_layer_position(cnf, cnf->num_positions++);
+    return cnf;
+}
+
+TunnelCNF tn_cnf_incremental_create(TunnelNetwork network, int bound, tn_encoding encoding)
+{
+    assert(bound >= 1);
+    TunnelCNF cnf = tn_cnf_build(network, bound, encoding, false);
+    tn_cnf_endpoint(cnf, tn_get_initial(network), 0, 0);
+    return cnf;
+}
+
+void tn_cnf_add_length(TunnelCNF cnf, int length)
+{
+    assert(length >= 1 && length <= cnf->length && (cnf->incremental || length == cnf->length));
+    while (cnf->num_positions <= length)
+        tn_cnf_layer_position(cnf, cnf->num_positions++);
+    if (cnf->incremental && cnf->guards[length] == 0)
+    {
+        cnf->guards[length] = sat_new_var(cnf->solver);
+        tn_cnf_endpoint(cnf, tn_get_final(cnf->network), length, cnf->guards[length]);
+    }
+}
+
+bool tn_cnf_solve(TunnelCNF cnf, int length)
+{
+    tn_cnf_add_length(cnf, length);
+    if (!cnf->incremental)
+        return sat_solve(cnf->solver, NULL, 0);
+
+    int guard = cnf->guards[length];
+    bool result = sat_solve(cnf->solver, &guard, 1);
+    // cette longueur est impossible : on le dit au solveur pour les longueurs suivantes
+    if (!result)
+    {
+        int unit = -guard;
+        sat_add_clause(cnf->solver, &unit, 1);
+    }
+    return result;
+}
+
+void tn_cnf_get_path(TunnelCNF cnf, int length, tn_step *path)
+{
+    SatSolver solver = cnf->solver;
+    for (int pos = 0; pos < length; pos++)
+    {
+        int src = -1;
+        int src_height = -1;
+        int tgt = -1;
+        int tgt_height = -1;
+        for (int n = 0; n < cnf->num_nodes; n++)
+        {
+            for (int height = 0; height < cnf->stack_size; height++)
+            {
+                if (sat_lit_value(solver, tn_cnf_path(cnf, n, pos, height)))
+                {
+                    src = n;
+                    src_height = height;
+                }
+                if (sat_lit_value(solver, tn_cnf_path(cnf, n, pos + 1, height)))
+                {
+                    tgt = n;
+                    tgt_height = height;
+                }
+            }
+        }
+        // the action is the one of tn_action_table with this height variation, this top before and this top after
+        int top = sat_lit_value(solver, tn_cnf_4(cnf, pos, src_height)) ? 4 : 6;
+        int result_top = sat_lit_value(solver, tn_cnf_4(cnf, pos + 1, tgt_height)) ? 4 : 6;
+        stack_action action = transmit_4;
+        for (stack_action act = 0; act < NumActions; act++)
+        {
+            const tn_action_semantics *semantics = &tn_action_table[act];
+            if (semantics->delta == tgt_height - src_height && semantics->top == top && semantics->result_top == result_top)
+            {
+                action = act;
+                break;
+            }
+        }
+        path[pos] = tn_step_create(action, src, tgt);
+    }
+}
+
+void tn_cnf_print_model(TunnelCNF cnf, int length)
+{
+    SatSolver solver = cnf->solver;
+    for (int pos = 0; pos <= length; pos++)
+    {
+        printf("At pos %d:\nState: ", pos);
+        int num_seen = 0;
+        for (int node = 0; node < cnf->num_nodes; node++)
+        {
+            for (int height = 0; height < cnf->stack_size; height++)
+            {
+                if (sat_lit_value(solver, tn_cnf_path(cnf, node, pos, height)))
+                {
+                    printf("(%s,%d) ", tn_get_node_name(cnf->network, node), height);
+                    num_seen++;
+                }
+            }
+        }
+        if (num_seen == 0)
+            printf("No node at that position !\n");
+        else
+            printf("\n");
+        if (num_seen > 1)
+            printf("Several pair node,height!\n");
+        printf("Stack: ");
+        bool misdefined = false;
+        bool above_top = false;
+        for (int height = 0; height < cnf->stack_size; height++)
+        {
+            bool four = sat_lit_value(solver, tn_cnf_4(cnf, pos, height));
+            bool six = sat_lit_value(solver, tn_cnf_6(cnf, pos, height));
+            printf("|%c", four ? (six ? 'X' : '4') : (six ? '6' : ' '));
+            misdefined = misdefined || (four && six) || ((four || six) && above_top);
+            above_top = above_top || !(four || six);
+        }
+        printf("\n");
+        if (misdefined)
+            printf("Warning: ill-defined stack\n");
+    }
+}
+
+void tn_cnf_block_path(TunnelCNF cnf, int length, tn_step *path)
+{
+    assert(length >= 1 && length <= cnf->length && (!cnf->incremental || cnf->guards[length] != 0));
+
+    // la position pos du chemin est (nœud, hauteur, sommet), comme dans tn_incremental_block_path
+    int *literals = tn_cnf_malloc((2 * (length + 1) + 1) * sizeof(int));
+    int num_literals = 0;
+    int height = 0;
+    for (int pos = 0; pos <= length; pos++)
+    {
+        const tn_action_semantics *semantics = &tn_action_table[path[pos < length ? pos : length - 1].action];
+        int node = pos < length ? path[pos].source : path[length - 1].target;
+        int top = pos < length ? semantics->top : semantics->result_top;
+        literals[num_literals++] = -tn_cnf_path(cnf, node, pos, height);
+        literals[num_literals++] = -tn_cnf_symbol(cnf, pos, height, top);
+        if (pos < length)
+            height += semantics->delta;
+    }
+    if (cnf->incremental)
+        literals[num_literals++] = -cnf->guards[length];
+    sat_add_clause(cnf->solver, literals, num_literals);
+    free(literals);
+}
+
+int tn_cnf_enumerate(TunnelCNF cnf, int max_paths, tn_path_callback callback, void *data)
+{
+    assert(cnf->incremental);
+    int bound = cnf->length;
+    tn_step *path = tn_cnf_malloc((bound + 1) * sizeof(tn_step));
+    int num_paths = 0;
+    bool go_on = max_paths > 0;
+
+    for (int length = 1; length <= bound && go_on; length++)
+    {
+        while (go_on && tn_cnf_solve(cnf, length))
+        {
+            tn_cnf_get_path(cnf, length, path);
+            tn_cnf_block_path(cnf, length, path);
+            num_paths++;
+            go_on = callback(path, length, data) && num_paths < max_paths;
+        }
+    }
+
+    free(path);
+    return num_paths;
+}
+
+SatSolver tn_cnf_get_solver(TunnelCNF cnf)
+{
+    return cnf->solver;
+}
+
+void tn_cnf_delete(TunnelCNF cnf)
+{
+    sat_delete(cnf->solver);
+    free(cnf->path);
+    free(cnf->four);
+    free(cnf->six);
+    free(cnf->node);
+    free(cnf->height);
+    free(cnf->cases);
+    free(cnf->alive);
+    free(cnf->max_height);
+    free(cnf->guards);
+    free(cnf);
+}
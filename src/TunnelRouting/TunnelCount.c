@@ -0,0 +1,392 @@
+#include "TunnelCount.h"
+#include "TunnelNetwork.h"
+#include "TunnelStack.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+/**
+ * @brief The configurations of a position with their number of paths, and a hash set on them. Their stacks are stored as the word low of a tn_stack followed by its words high.
+ *
+ */
+typedef struct
+{
+    int *nodes;       ///< The node of each configuration.
+    int *heights;     ///< The number of cells of the stack of each configuration.
+    uint64_t *stacks; ///< The stacks of the configurations, num_words words each.
+    tn_count *counts; ///< The number of paths reaching each configuration.
+    int num_words;    ///< The number of words of a stack.
+    int size;         ///< The number of configurations.
+    int capacity;     ///< The allocated number of configurations.
+    int *slots;       ///< Open-addressing set of the configurations (-1 if empty).
+    int num_slots;    ///< The number of slots (a power of 2), at least twice the size.
+} tn_layer;
+
+/**
+ * @brief Adds @p a and @p b, saturating at TN_COUNT_MAX.
+ */
+static inline tn_count tn_count_add(tn_count a, tn_count b)
+{
+    tn_count sum = a + b;
+    return sum < a ? TN_COUNT_MAX : sum;
+}
+
+/**
+ * @brief Hash of a configuration.
+ */
+static inline uint64_t tn_layer_hash(int node, tn_stack *stack)
+{
+    return tn_stack_hash(stack) ^ ((uint64_t)node * 0x9e3779b97f4a7c15ULL);
+}
+
+static void tn_layer_init(tn_layer *layer, int num_words)
+{
+    layer->num_words = num_words;
+    layer->size = 0;
+    layer->capacity = 1024;
+    layer->nodes = malloc(layer->capacity * sizeof(int));
+    layer->heights = malloc(layer->capacity * sizeof(int));
+    layer->stacks = malloc((size_t)layer->capacity * num_words * sizeof(uint64_t));
+    layer->counts = malloc(layer->capacity * sizeof(tn_count));
+    layer->num_slots = 2048;
+    layer->slots = malloc(layer->num_slots * sizeof(int));
+    if (layer->nodes == NULL || layer->heights == NULL || layer->stacks == NULL || layer->counts == NULL || layer->slots == NULL)
+    {
+        printf("Malloc failed\n");
+        exit(EXIT_FAILURE);
+    }
+    memset(layer->slots, -1, layer->num_slots * sizeof(int));
+}
+
+static void tn_layer_free(tn_layer *layer)
+{
+    free(layer->nodes);
+    free(layer->heights);
+    free(layer->stacks);
+    free(layer->counts);
+    free(layer->slots);
+}
+
+/**
+ * @brief Empties @p layer, keeping its memory.
+ */
+static void tn_layer_clear(tn_layer *layer)
+{
+    layer->size = 0;
+    memset(layer->slots, -1, layer->num_slots * sizeof(int));
+}
+
+/**
+ * @brief Loads the stack of the configuration @p index in @p stack.
+ */
+static inline void tn_layer_load(tn_layer *layer, int index, tn_stack *stack)
+{
+    uint64_t *words = layer->stacks + (size_t)index * layer->num_words;
+    stack->height = layer->heights[index];
+    stack->low = words[0];
+    if (stack->high != NULL)
+        memcpy(stack->high, words + 1, (layer->num_words - 1) * sizeof(uint64_t));
+}
+
+/**
+ * @brief Tells if the configuration @p index has the node @p node and the stack @p stack.
+ */
+static inline bool tn_layer_is(tn_layer *layer, int index, int node, tn_stack *stack)
+{
+    uint64_t *words = layer->stacks + (size_t)index * layer->num_words;
+    if (layer->nodes[index] != node || layer->heights[index] != stack->height || words[0] != stack->low)
+        return false;
+    return stack->high == NULL || memcmp(words + 1, stack->high, (layer->num_words - 1) * sizeof(uint64_t)) == 0;
+}
+
+/**
+ * @brief Inserts the configuration @p index in the slots of @p layer.
+ *
+ * @param buffer A stack of the capacity of the configurations, used to hash them.
+ */
+static void tn_layer_insert_slot(tn_layer *layer, int index, tn_stack *buffer)
+{
+    tn_layer_load(layer, index, buffer);
+    int slot = tn_layer_hash(layer->nodes[index], buffer) & (layer->num_slots - 1);
+    while (layer->slots[slot] != -1)
+        slot = (slot + 1) & (layer->num_slots - 1);
+    layer->slots[slot] = index;
+}
+
+/**
+ * @brief Adds @p count paths reaching the configuration (@p node, @p stack) to @p layer.
+ *
+ * @param buffer A stack of the capacity of @p stack, different from it.
+ */
+static void tn_layer_add(tn_layer *layer, int node, tn_stack *stack, tn_count count, tn_stack *buffer)
+{
+    int slot = tn_layer_hash(node, stack) & (layer->num_slots - 1);
+    while (layer->slots[slot] != -1)
+    {
+        int index = layer->slots[slot];
+        if (tn_layer_is(layer, index, node, stack))
+        {
+            layer->counts[index] = tn_count_add(layer->counts[index], count);
+            return;
+        }
+        slot = (slot + 1) & (layer->num_slots - 1);
+    }
+
+    if (layer->size == layer->capacity)
+    {
+        layer->capacity *= 2;
+        layer->nodes = realloc(layer->nodes, layer->capacity * sizeof(int));
+        layer->heights = realloc(layer->heights, layer->capacity * sizeof(int));
+        layer->stacks = realloc(layer->stacks, (size_t)layer->capacity * layer->num_words * sizeof(uint64_t));
+        layer->counts = realloc(layer->counts, layer->capacity * sizeof(tn_count));
+        if (layer->nodes == NULL || layer->heights == NULL || layer->stacks == NULL || layer->counts == NULL)
+        {
+            printf("Malloc failed\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+    int index = layer->size++;
+    layer->nodes[index] = node;
+    layer->heights[index] = stack->height;
+    layer->counts[index] = count;
+    uint64_t *words = layer->stacks + (size_t)index * layer->num_words;
+    words[0] = stack->low;
+    if (stack->high != NULL)
+        memcpy(words + 1, stack->high, (layer->num_words - 1) * sizeof(uint64_t));
+    layer->slots[slot] = index;
+
+    // the set is kept at most half full
+    if (2 * layer->size > layer->num_slots)
+    {
+        layer->num_slots *= 2;
+        free(layer->slots);
+        layer->slots = malloc(layer->num_slots * sizeof(int));
+        if (layer->slots == NULL)
+        {
+            printf("Malloc failed\n");
+            exit(EXIT_FAILURE);
+        }
+        memset(layer->slots, -1, layer->num_slots * sizeof(int));
+        for (int other = 0; other < layer->size; other++)
+            tn_layer_insert_slot(layer, other, buffer);
+    }
+}
+
+/**
+ * @brief Multiplies @p a and @p b, saturating at TN_COUNT_MAX.
+ */
+static inline tn_count tn_count_mul(tn_count a, tn_count b)
+{
+    if (a == 0 || b == 0)
+        return 0;
+    return a > TN_COUNT_MAX / b ? TN_COUNT_MAX : a * b;
+}
+
+/**
+ * @brief The max number of counts of each table of tn_count_by_summaries (2^23 counts, 128 MB).
+ */
+#define TN_COUNT_MAX_SUMMARIES ((double)(1 << 23))
+
+/**
+ * @brief The max number of elementary operations of tn_count_by_summaries (about length^2 * num_nodes^3).
+ */
+#define TN_COUNT_MAX_OPERATIONS 1e10
+
+/**
+ * @brief Counts the paths with the summaries of the network (see TunnelSummary.h), for the networks small enough. A path decomposes uniquely in transmits and "push ... pop" blocks, the pop being the first one going back to the height of the push, and a block is a push, a summary one cell higher, and a pop. So balanced[k][u][v][t], the number of paths of k steps from u to v that start and end on the same top t without going below it, is the sum of the transmits followed by balanced[k-1], and of the blocks of m steps followed by balanced[k-m].
+ *
+ * @param num_entries The size of each table: (length + 1) * num_nodes * num_nodes * 2 counts.
+ */
+static void tn_count_by_summaries(TunnelNetwork network, int length, tn_count *counts, size_t num_entries)
+{
+    int N = tn_get_num_nodes(network);
+    // balanced[((k * N + u) * 2 + t) * N + v], and blocks[...] likewise for the blocks of k steps from u to v
+    tn_count *balanced = calloc(num_entries, sizeof(tn_count));
+    tn_count *blocks = calloc(num_entries, sizeof(tn_count));
+    if (balanced == NULL || blocks == NULL)
+    {
+        printf("Malloc failed\n");
+        exit(EXIT_FAILURE);
+    }
+#define TN_ROW(table, k, u, t) ((table) + (((size_t)(k) * N + (u)) * 2 + (t)) * N)
+
+    stack_action transmit[2], push[2][2], pop[2][2];
+    for (stack_action action = 0; action < NumActions; action++)
+    {
+        const tn_action_semantics *semantics = &tn_action_table[action];
+        int top = semantics->top == 6;
+        if (semantics->delta == 0)
+            transmit[top] = action;
+        else if (semantics->delta > 0)
+            push[top][semantics->result_top == 6] = action;
+        else
+            pop[semantics->second == 6][top] = action;
+    }
+
+    for (int k = 0; k <= length; k++)
+    {
+        // blocks of k steps : push t -> b at u, balanced path of k-2 steps on b from w to x, pop at x
+        for (int u = 0; k >= 2 && u < N; u++)
+        {
+            int *successors = tn_get_successors(network, u);
+            for (int t = 0; t < 2; t++)
+                for (int b = 0; b < 2; b++)
+                {
+                    if (!tn_node_has_action(network, u, push[t][b]))
+                        continue;
+                    tn_count *block = TN_ROW(blocks, k, u, t);
+                    for (int i = 0; i < tn_get_num_successors(network, u); i++)
+                    {
+                        tn_count *inner = TN_ROW(balanced, k - 2, successors[i], b);
+                        for (int x = 0; x < N; x++)
+                        {
+                            if (inner[x] == 0 || !tn_node_has_action(network, x, pop[t][b]))
+                                continue;
+                            int *next = tn_get_successors(network, x);
+                            for (int j = 0; j < tn_get_num_successors(network, x); j++)
+                                block[next[j]] = tn_count_add(block[next[j]], inner[x]);
+                        }
+                    }
+                }
+        }
+
+        for (int u = 0; u < N; u++)
+        {
+            int *successors = tn_get_successors(network, u);
+            for (int t = 0; t < 2; t++)
+            {
+                tn_count *row = TN_ROW(balanced, k, u, t);
+                if (k == 0)
+                {
+                    row[u] = 1;
+                    continue;
+                }
+                if (tn_node_has_action(network, u, transmit[t]))
+                {
+                    for (int i = 0; i < tn_get_num_successors(network, u); i++)
+                    {
+                        tn_count *rest = TN_ROW(balanced, k - 1, successors[i], t);
+                        for (int v = 0; v < N; v++)
+                            row[v] = tn_count_add(row[v], rest[v]);
+                    }
+                }
+                for (int m = 2; m <= k; m++)
+                {
+                    tn_count *block = TN_ROW(blocks, m, u, t);
+                    for (int y = 0; y < N; y++)
+                    {
+                        if (block[y] == 0)
+                            continue;
+                        tn_count *rest = TN_ROW(balanced, k - m, y, t);
+                        for (int v = 0; v < N; v++)
+                            row[v] = tn_count_add(row[v], tn_count_mul(block[y], rest[v]));
+                    }
+                }
+            }
+        }
+    }
+
+    // the valid paths are the balanced ones on the bottom 4, from the initial node to the final node
+    counts[0] = 0;
+    for (int l = 1; l <= length; l++)
+        counts[l] = TN_ROW(balanced, l, tn_get_initial(network), 0)[tn_get_final(network)];
+#undef TN_ROW
+    free(balanced);
+    free(blocks);
+}
+
+/**
+ * @brief Counts the paths by expanding the configurations (node, stack) position by position, for the networks too large for tn_count_by_summaries.
+ */
+static void tn_count_by_configurations(TunnelNetwork network, int length, tn_count *counts)
+{
+    int final = tn_get_final(network);
+    int *distances = tn_compute_distances_to_final(network);
+
+    // a path of size length never has more than length/2+1 cells in its stack
+    int capacity = length / 2 + 1;
+    tn_stack stack, buffer;
+    tn_stack_init(&stack, capacity);
+    tn_stack_init(&buffer, capacity);
+    tn_layer layers[2];
+    tn_layer_init(&layers[0], 1 + tn_stack_num_high_words(capacity));
+    tn_layer_init(&layers[1], 1 + tn_stack_num_high_words(capacity));
+
+    counts[0] = 0;
+    tn_layer *current = &layers[0];
+    tn_layer *next = &layers[1];
+    tn_layer_add(current, tn_get_initial(network), &stack, 1, &buffer);
+
+    for (int pos = 0; pos < length; pos++)
+    {
+        tn_layer_clear(next);
+        int remaining = length - (pos + 1);
+        for (int index = 0; index < current->size; index++)
+        {
+            int node = current->nodes[index];
+            tn_layer_load(current, index, &stack);
+            int mask = tn_get_actions_by_top(network, node, tn_stack_top_symbol(&stack));
+            int *successors = tn_get_successors(network, node);
+            for (int action = tn_next_action(mask, 0); action < NumActions; action = tn_next_action(mask, action + 1))
+            {
+                if (!tn_stack_apply(&stack, action))
+                    continue;
+                // the cells above the bottom must all be popped in the remaining steps
+                if (stack.height - 1 <= remaining)
+                {
+                    for (int i = 0; i < tn_get_num_successors(network, node); i++)
+                    {
+                        if (distances[successors[i]] <= remaining)
+                            tn_layer_add(next, successors[i], &stack, current->counts[index], &buffer);
+                    }
+                }
+                tn_stack_undo(&stack, action);
+            }
+        }
+
+        // the paths of size pos+1 are the ones at the final node with the stack [4]
+        counts[pos + 1] = 0;
+        for (int index = 0; index < next->size; index++)
+        {
+            if (next->nodes[index] == final && next->heights[index] == 1)
+                counts[pos + 1] = tn_count_add(counts[pos + 1], next->counts[index]);
+        }
+
+        tn_layer *swap = current;
+        current = next;
+        next = swap;
+    }
+
+    free(distances);
+    tn_stack_free(&stack);
+    tn_stack_free(&buffer);
+    tn_layer_free(&layers[0]);
+    tn_layer_free(&layers[1]);
+}
+
+char *tn_count_to_string(tn_count count, char *buffer)
+{
+    char digits[TN_COUNT_STRING_SIZE];
+    int size = 0;
+    do
+    {
+        digits[size++] = '0' + (int)(count % 10);
+        count /= 10;
+    } while (count > 0);
+    for (int i = 0; i < size; i++)
+        buffer[i] = digits[size - 1 - i];
+    buffer[size] = '\0';
+    return buffer;
+}
+
+void tn_count_paths(TunnelNetwork network, int length, tn_count *counts)
+{
+    double num_nodes = tn_get_num_nodes(network);
+    double num_entries = (length + 1) * num_nodes * num_nodes * 2;
+    // the number of configurations can grow exponentially with the length, the summaries are polynomial but cubic in the number of nodes
+    if (num_entries <= TN_COUNT_MAX_SUMMARIES && (double)length * length * num_nodes * num_nodes * num_nodes <= TN_COUNT_MAX_OPERATIONS)
+        tn_count_by_summaries(network, length, counts, (size_t)num_entries);
+    else
+        tn_count_by_configurations(network, length, counts);
+}
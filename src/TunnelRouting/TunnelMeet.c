@@ -0,0 +1,299 @@
+#include "TunnelMeet.h"
+#include "TunnelNetwork.h"
+#include "TunnelStack.h"
+#include "TunnelBFS.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+/**
+ * @brief A configuration reached by one side of the search. Its stack is stored in the side, as the word low of a tn_stack followed by its words high.
+ *
+ */
+typedef struct
+{
+    int node;            ///< The node where the packet is.
+    int height;          ///< The number of cells of the stack.
+    int depth;           ///< The number of steps from the initial configuration (forward) or to the final one (backward).
+    int link;            ///< The configuration before the last step (forward) or after the first step (backward), -1 for the starting one.
+    stack_action action; ///< The action of the step between the configuration and its link, performed by the first node of the step.
+} tn_meet_configuration;
+
+/**
+ * @brief One side of the search: all the configurations it reached, layer after layer, and the hash set of all of them.
+ *
+ */
+typedef struct
+{
+    tn_meet_configuration *configurations; ///< The configurations.
+    uint64_t *stacks;                      ///< The stacks of the configurations, num_words words each.
+    int num_words;                         ///< The number of words of a stack.
+    int size;                              ///< The number of configurations.
+    int capacity;                          ///< The allocated number of configurations.
+    int *slots;                            ///< Open-addressing set of the configurations (-1 if empty).
+    int num_slots;                         ///< The number of slots (a power of 2), at least twice the size.
+    int layer_begin;                       ///< The first configuration of the frontier (the last layer).
+    int depth;                             ///< The depth of the frontier.
+    tn_stack buffer;                       ///< A stack to load the stored ones.
+} tn_side;
+
+/**
+ * @brief Returns the stack of the configuration @p index.
+ */
+static inline uint64_t *tn_side_stack(tn_side *side, int index)
+{
+    return side->stacks + (size_t)index * side->num_words;
+}
+
+/**
+ * @brief Loads the stack of the configuration @p index in @p stack.
+ */
+static inline void tn_side_load(tn_side *side, int index, tn_stack *stack)
+{
+    uint64_t *words = tn_side_stack(side, index);
+    stack->height = side->configurations[index].height;
+    stack->low = words[0];
+    if (stack->high != NULL)
+        memcpy(stack->high, words + 1, (side->num_words - 1) * sizeof(uint64_t));
+}
+
+/**
+ * @brief Tells if the configuration @p index has the stack @p stack.
+ */
+static inline bool tn_side_has_stack(tn_side *side, int index, tn_stack *stack)
+{
+    uint64_t *words = tn_side_stack(side, index);
+    if (side->configurations[index].height != stack->height || words[0] != stack->low)
+        return false;
+    return stack->high == NULL || memcmp(words + 1, stack->high, (side->num_words - 1) * sizeof(uint64_t)) == 0;
+}
+
+/**
+ * @brief Hash of a configuration.
+ */
+static inline uint64_t tn_meet_hash(int node, tn_stack *stack)
+{
+    return tn_stack_hash(stack) ^ ((uint64_t)node * 0x9e3779b97f4a7c15ULL);
+}
+
+static void tn_side_init(tn_side *side, int stack_capacity)
+{
+    tn_stack_init(&side->buffer, stack_capacity);
+    side->num_words = 1 + tn_stack_num_high_words(stack_capacity);
+    side->capacity = 1024;
+    side->size = 0;
+    side->configurations = malloc(side->capacity * sizeof(tn_meet_configuration));
+    side->stacks = calloc((size_t)side->capacity * side->num_words, sizeof(uint64_t));
+    side->num_slots = 2048;
+    side->slots = malloc(side->num_slots * sizeof(int));
+    if (side->configurations == NULL || side->stacks == NULL || side->slots == NULL)
+    {
+        printf("Malloc failed\n");
+        exit(EXIT_FAILURE);
+    }
+    memset(side->slots, -1, side->num_slots * sizeof(int));
+    side->layer_begin = 0;
+    side->depth = 0;
+}
+
+static void tn_side_free(tn_side *side)
+{
+    tn_stack_free(&side->buffer);
+    free(side->configurations);
+    free(side->stacks);
+    free(side->slots);
+}
+
+/**
+ * @brief Returns the index of the configuration (@p node, @p stack) in @p side, or -1 if it was not reached.
+ */
+static int tn_side_find(tn_side *side, int node, tn_stack *stack)
+{
+    int slot = tn_meet_hash(node, stack) & (side->num_slots - 1);
+    while (side->slots[slot] != -1)
+    {
+        int index = side->slots[slot];
+        if (side->configurations[index].node == node && tn_side_has_stack(side, index, stack))
+            return index;
+        slot = (slot + 1) & (side->num_slots - 1);
+    }
+    return -1;
+}
+
+/**
+ * @brief Adds the configuration (@p node, @p stack) to @p side if it was not reached yet.
+ *
+ * @return int The index of the new configuration, or -1 if it was already reached.
+ */
+static int tn_side_add(tn_side *side, int node, tn_stack *stack, int depth, int link, stack_action action)
+{
+    if (tn_side_find(side, node, stack) != -1)
+        return -1;
+
+    // the set is kept at most half full
+    if (2 * (side->size + 1) > side->num_slots)
+    {
+        side->num_slots *= 2;
+        free(side->slots);
+        side->slots = malloc(side->num_slots * sizeof(int));
+        if (side->slots == NULL)
+        {
+            printf("Malloc failed\n");
+            exit(EXIT_FAILURE);
+        }
+        memset(side->slots, -1, side->num_slots * sizeof(int));
+        for (int index = 0; index < side->size; index++)
+        {
+            tn_side_load(side, index, &side->buffer);
+            int slot = tn_meet_hash(side->configurations[index].node, &side->buffer) & (side->num_slots - 1);
+            while (side->slots[slot] != -1)
+                slot = (slot + 1) & (side->num_slots - 1);
+            side->slots[slot] = index;
+        }
+    }
+
+    if (side->size == side->capacity)
+    {
+        side->capacity *= 2;
+        side->configurations = realloc(side->configurations, side->capacity * sizeof(tn_meet_configuration));
+        side->stacks = realloc(side->stacks, (size_t)side->capacity * side->num_words * sizeof(uint64_t));
+        if (side->configurations == NULL || side->stacks == NULL)
+        {
+            printf("Malloc failed\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    int index = side->size++;
+    side->configurations[index].node = node;
+    side->configurations[index].height = stack->height;
+    side->configurations[index].depth = depth;
+    side->configurations[index].link = link;
+    side->configurations[index].action = action;
+    uint64_t *words = tn_side_stack(side, index);
+    words[0] = stack->low;
+    if (stack->high != NULL)
+        memcpy(words + 1, stack->high, (side->num_words - 1) * sizeof(uint64_t));
+
+    int slot = tn_meet_hash(node, stack) & (side->num_slots - 1);
+    while (side->slots[slot] != -1)
+        slot = (slot + 1) & (side->num_slots - 1);
+    side->slots[slot] = index;
+    return index;
+}
+
+/**
+ * @brief Expands the frontier of @p side by one layer: forward, the actions are applied on the successors, backward, they are applied in reverse on the predecessors. Each new configuration is looked up in @p other.
+ *
+ * @param stack A stack of the capacity of the sides.
+ * @param meet Set to the indexes (in the forward side, then in the backward side) of the first common configuration found.
+ * @return true if a common configuration was found.
+ */
+static bool tn_side_expand(TunnelNetwork network, int length, tn_side *side, tn_side *other, bool forward, tn_stack *stack, int meet[2])
+{
+    int layer_end = side->size;
+    int depth = side->depth + 1;
+
+    for (int index = side->layer_begin; index < layer_end; index++)
+    {
+        int node = side->configurations[index].node;
+        int degree = forward ? tn_get_num_successors(network, node) : tn_get_num_predecessors(network, node);
+        int *neighbours = forward ? tn_get_successors(network, node) : tn_get_predecessors(network, node);
+        int top_mask = 0;
+        if (forward)
+        {
+            tn_side_load(side, index, stack);
+            top_mask = tn_get_actions_by_top(network, node, tn_stack_top_symbol(stack));
+        }
+
+        for (int i = 0; i < degree; i++)
+        {
+            int next = neighbours[i];
+            // the node performing the action is the current one forward, the predecessor backward
+            int mask = forward ? top_mask : tn_get_actions(network, next);
+            for (int action = tn_next_action(mask, 0); action < NumActions; action = tn_next_action(mask, action + 1))
+            {
+                tn_side_load(side, index, stack);
+                if (!(forward ? tn_stack_apply(stack, action) : tn_stack_unapply(stack, action)))
+                    continue;
+                // the cells above the bottom need as many steps as their number on the other side
+                if (stack->height - 1 > length - depth)
+                    continue;
+                int added = tn_side_add(side, next, stack, depth, index, action);
+                if (added == -1)
+                    continue;
+                int found = tn_side_find(other, next, stack);
+                if (found != -1)
+                {
+                    meet[0] = forward ? added : found;
+                    meet[1] = forward ? found : added;
+                    return true;
+                }
+            }
+        }
+    }
+
+    side->layer_begin = layer_end;
+    side->depth = depth;
+    return false;
+}
+
+int tn_meet_in_the_middle(TunnelNetwork network, int length, tn_step *path)
+{
+    int initial = tn_get_initial(network);
+    int final = tn_get_final(network);
+    if (initial == final)
+        return tn_bfs(network, length, path);
+
+    // a path of size length never has more than length/2+1 cells in its stack
+    tn_side sides[2];
+    tn_stack stack;
+    tn_stack_init(&stack, length / 2 + 1);
+    tn_side_init(&sides[0], length / 2 + 1);
+    tn_side_init(&sides[1], length / 2 + 1);
+    tn_side_add(&sides[0], initial, &stack, 0, -1, transmit_4);
+    tn_side_add(&sides[1], final, &stack, 0, -1, transmit_4);
+
+    // the sides have reached all the configurations at distance at most their depth : a common configuration found while expanding one layer gives a path of size the sum of the depths, and none could be shorter
+    int meet[2];
+    bool found = false;
+    while (!found && sides[0].depth + sides[1].depth < length)
+    {
+        int frontier[2] = {sides[0].size - sides[0].layer_begin, sides[1].size - sides[1].layer_begin};
+        if (frontier[0] == 0 && frontier[1] == 0)
+            break;
+        // the smaller frontier is expanded, an empty one cannot be
+        int s = frontier[0] == 0 || (frontier[1] != 0 && frontier[1] < frontier[0]);
+        found = tn_side_expand(network, length, &sides[s], &sides[1 - s], s == 0, &stack, meet);
+    }
+
+    int res = 0;
+    if (found)
+    {
+        tn_meet_configuration *forward = sides[0].configurations;
+        tn_meet_configuration *backward = sides[1].configurations;
+        int middle = forward[meet[0]].depth;
+        res = middle + backward[meet[1]].depth;
+        // the forward half goes back to the initial configuration, the backward half goes on to the final one
+        int index = meet[0];
+        for (int step = middle - 1; step >= 0; step--)
+        {
+            int parent = forward[index].link;
+            path[step] = tn_step_create(forward[index].action, forward[parent].node, forward[index].node);
+            index = parent;
+        }
+        index = meet[1];
+        for (int step = middle; step < res; step++)
+        {
+            int next = backward[index].link;
+            path[step] = tn_step_create(backward[index].action, backward[index].node, backward[next].node);
+            index = next;
+        }
+    }
+
+    tn_stack_free(&stack);
+    tn_side_free(&sides[0]);
+    tn_side_free(&sides[1]);
+    return res;
+}
@@ -5,13 +5,21 @@
 #include <sys/stat.h>
 #include <string.h>
 #include <assert.h>
+#include <limits.h>
 
 struct TunnelNetwork_s
 {
     Graph graph;       ///< The graph supporting the network.
     int initial;       ///< The starting node of the network.
     int final;         ///< The target node of the network.
+    int *finals;       ///< All the nodes drawn as targets, in increasing order (final is the last one).
+    int num_finals;    ///< The number of nodes drawn as targets.
     int *node_actions; ///< The actions associated with nodes (uses a mask encoding).
+    int *node_actions_by_top; ///< The actions of node n requiring top 4 (index 2n) and 6 (index 2n+1).
+    int *node_actions_by_class; ///< The actions of node n of class c (index NumActionClasses*n+c).
+    int *node_classes;          ///< The classes of actions of each node (bit c set iff node has an action of class c).
+    int *predecessor_offsets;   ///< The predecessors of node n are predecessors[predecessor_offsets[n]] to predecessors[predecessor_offsets[n+1]-1].
+    int *predecessors;          ///< The predecessors of all the nodes, node after node.
 };
 
 TunnelNetwork tn_initialize(Graph graph)
@@ -19,9 +27,12 @@ TunnelNetwork tn_initialize(Graph graph)
     TunnelNetwork result = (TunnelNetwork)malloc(sizeof(*result));
     result->graph = graph;
     int num_nodes = graph_num_nodes(graph);
-    result->node_actions = (int *)malloc(num_nodes * sizeof(int));
+    result->node_actions = (int *)calloc(num_nodes, sizeof(int));
+    int *stored_actions = graph_get_node_masks(graph);
     result->initial = 0; // dummy value
     result->final = 0;   // dummy value
+    result->finals = (int *)malloc(num_nodes * sizeof(int));
+    result->num_finals = 0;
     for (int node = 0; node < num_nodes; node++)
     {
         char *param = parameter_list_get_value(graph_get_node_parameter(graph, node), "shape");
@@ -30,7 +41,15 @@ TunnelNetwork tn_initialize(Graph graph)
             if (strcmp("square", param) == 0)
                 result->initial = node;
             if (strcmp("invtriangle", param) == 0)
+            {
                 result->final = node;
+                result->finals[result->num_finals++] = node;
+            }
+        }
+        if (stored_actions != NULL)
+        {
+            result->node_actions[node] = stored_actions[node];
+            continue;
         }
         char *actions = parameter_list_get_value(graph_get_node_parameter(graph, node), "label");
         if (actions == NULL)
@@ -69,12 +88,61 @@ TunnelNetwork tn_initialize(Graph graph)
     }
     // todo: fill node_actions.
 
+    result->node_actions_by_top = (int *)calloc(num_nodes, 2 * sizeof(int));
+    result->node_actions_by_class = (int *)calloc(num_nodes, NumActionClasses * sizeof(int));
+    result->node_classes = (int *)calloc(num_nodes, sizeof(int));
+    for (int node = 0; node < num_nodes; node++)
+    {
+        for (stack_action act = 0; act < NumActions; act++)
+        {
+            if ((result->node_actions[node] & (1 << act)) == 0)
+                continue;
+            result->node_actions_by_top[2 * node + (tn_action_table[act].top == 6)] |= 1 << act;
+            result->node_actions_by_class[NumActionClasses * node + tn_class_of_action(act)] |= 1 << act;
+            result->node_classes[node] |= 1 << tn_class_of_action(act);
+        }
+    }
+
+    // predecessors, sorted increasingly as the sources are scanned in increasing order
+    result->predecessor_offsets = (int *)calloc(num_nodes + 1, sizeof(int));
+    for (int node = 0; node < num_nodes; node++)
+    {
+        int *successors = graph_get_successors(graph, node);
+        for (int i = 0; i < graph_out_degree(graph, node); i++)
+            result->predecessor_offsets[successors[i] + 1]++;
+    }
+    for (int node = 0; node < num_nodes; node++)
+        result->predecessor_offsets[node + 1] += result->predecessor_offsets[node];
+    result->predecessors = (int *)malloc((result->predecessor_offsets[num_nodes] + 1) * sizeof(int));
+    int *filled = (int *)calloc(num_nodes + 1, sizeof(int));
+    for (int node = 0; node < num_nodes; node++)
+    {
+        int *successors = graph_get_successors(graph, node);
+        for (int i = 0; i < graph_out_degree(graph, node); i++)
+        {
+            int target = successors[i];
+            result->predecessors[result->predecessor_offsets[target] + filled[target]++] = node;
+        }
+    }
+    free(filled);
+
     return result;
 }
 
+bool tn_save_snapshot(TunnelNetwork network, char *file_name)
+{
+    return graph_save_snapshot(network->graph, network->node_actions, file_name);
+}
+
 void tn_delete(TunnelNetwork network)
 {
     free(network->node_actions);
+    free(network->finals);
+    free(network->node_actions_by_top);
+    free(network->node_actions_by_class);
+    free(network->node_classes);
+    free(network->predecessor_offsets);
+    free(network->predecessors);
     free(network);
     return;
 }
@@ -124,6 +192,11 @@ void tn_print(TunnelNetwork network)
     return;
 }
 
+Graph tn_get_graph(TunnelNetwork network)
+{
+    return network->graph;
+}
+
 int tn_get_num_nodes(TunnelNetwork network)
 {
     return graph_num_nodes(network->graph);
@@ -139,6 +212,57 @@ bool tn_is_edge(TunnelNetwork network, int source, int target)
     return graph_is_edge(network->graph, source, target);
 }
 
+int tn_get_num_successors(TunnelNetwork network, int node)
+{
+    return graph_out_degree(network->graph, node);
+}
+
+int *tn_get_successors(TunnelNetwork network, int node)
+{
+    return graph_get_successors(network->graph, node);
+}
+
+int tn_get_num_predecessors(TunnelNetwork network, int node)
+{
+    return network->predecessor_offsets[node + 1] - network->predecessor_offsets[node];
+}
+
+int *tn_get_predecessors(TunnelNetwork network, int node)
+{
+    return network->predecessors + network->predecessor_offsets[node];
+}
+
+int *tn_compute_distances_to_final(TunnelNetwork network)
+{
+    int num_nodes = tn_get_num_nodes(network);
+    int *distances = malloc(num_nodes * sizeof(int));
+    int *queue = malloc(num_nodes * sizeof(int));
+    if (distances == NULL || queue == NULL)
+    {
+        printf("Malloc failed\n");
+        exit(EXIT_FAILURE);
+    }
+    for (int node = 0; node < num_nodes; node++)
+        distances[node] = INT_MAX;
+    int head = 0, tail = 0;
+    distances[network->final] = 0;
+    queue[tail++] = network->final;
+    while (head < tail)
+    {
+        int node = queue[head++];
+        for (int i = 0; i < tn_get_num_predecessors(network, node); i++)
+        {
+            int previous = tn_get_predecessors(network, node)[i];
+            if (distances[previous] != INT_MAX)
+                continue;
+            distances[previous] = distances[node] + 1;
+            queue[tail++] = previous;
+        }
+    }
+    free(queue);
+    return distances;
+}
+
 char *tn_get_node_name(TunnelNetwork network, int node)
 {
     return graph_get_node_name(network->graph, node);
@@ -169,6 +293,16 @@ void tn_set_final(TunnelNetwork network, int final)
     network->final = final;
 }
 
+int tn_get_num_finals(TunnelNetwork network)
+{
+    return network->num_finals;
+}
+
+int *tn_get_finals(TunnelNetwork network)
+{
+    return network->finals;
+}
+
 char *tn_get_name(TunnelNetwork network)
 {
     return graph_get_name(network->graph);
@@ -185,6 +319,40 @@ void tn_print_path(TunnelNetwork network, tn_step *path, int size_path)
     return;
 }
 
+/**
+ * @brief Writes @p string in @p file as a JSON string.
+ */
+static void tn_fprint_json_string(FILE *file, const char *string)
+{
+    fputc('"', file);
+    for (const char *c = string; *c != '\0'; c++)
+    {
+        if (*c == '"' || *c == '\\')
+            fprintf(file, "\\%c", *c);
+        else if ((unsigned char)*c < 0x20)
+            fprintf(file, "\\u%04x", *c);
+        else
+            fputc(*c, file);
+    }
+    fputc('"', file);
+}
+
+void tn_fprint_path_json(FILE *file, TunnelNetwork network, tn_step *path, int size_path)
+{
+    fprintf(file, "{\"size\": %d, \"steps\": [", size_path);
+    for (int i = 0; i < size_path; i++)
+    {
+        fprintf(file, "%s{\"source\": ", i == 0 ? "" : ", ");
+        tn_fprint_json_string(file, tn_get_node_name(network, path[i].source));
+        fprintf(file, ", \"action\": ");
+        tn_fprint_json_string(file, tn_string_of_stack_action(path[i].action));
+        fprintf(file, ", \"target\": ");
+        tn_fprint_json_string(file, tn_get_node_name(network, path[i].target));
+        fprintf(file, "}");
+    }
+    fprintf(file, "]}");
+}
+
 void tn_create_dot(TunnelNetwork network, tn_step *path, int size_path, char *name)
 {
 
@@ -241,3 +409,18 @@ tn_step tn_step_empty()
 int tn_get_actions(TunnelNetwork network, int node) {
     return network->node_actions[node];
 }
+
+int tn_get_actions_by_top(TunnelNetwork network, int node, int top)
+{
+    return network->node_actions_by_top[2 * node + (top == 6)];
+}
+
+int tn_get_actions_of_class(TunnelNetwork network, int node, tn_action_class action_class)
+{
+    return network->node_actions_by_class[NumActionClasses * node + action_class];
+}
+
+int tn_get_action_classes(TunnelNetwork network, int node)
+{
+    return network->node_classes[node];
+}
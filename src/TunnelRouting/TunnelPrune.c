@@ -0,0 +1,120 @@
+#include "TunnelPrune.h"
+#include "TunnelAbstract.h"
+#include "TunnelNetwork.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+struct TunnelPruning_s
+{
+    Graph graph;             ///< The graph of the reduced network (owned by the pruning).
+    TunnelNetwork network;   ///< The reduced network.
+    int *original_nodes;     ///< The original node of each node of the reduced network.
+    int num_removed_nodes;   ///< The number of nodes removed.
+    int num_removed_edges;   ///< The number of edges removed.
+    int num_removed_actions; ///< The number of actions removed from the kept nodes.
+};
+
+TunnelPruning tn_prune(TunnelNetwork network)
+{
+    int num_nodes = tn_get_num_nodes(network);
+    int initial = tn_get_initial(network);
+    int final = tn_get_final(network);
+
+    bool *kept = malloc((num_nodes + 1) * sizeof(bool));
+    bool *kept_arcs = malloc((tn_get_num_edges(network) + 1) * sizeof(bool));
+    int *masks = malloc((num_nodes + 1) * sizeof(int));
+    if (kept == NULL || kept_arcs == NULL || masks == NULL)
+    {
+        printf("Malloc failed\n");
+        exit(EXIT_FAILURE);
+    }
+
+    // a node is useful if one of its actions is enabled : the analysis already covers the reachability from the initial node and to the final node
+    TunnelAbstraction abstraction = tn_abstract_analyse(network, NULL);
+    int num_arcs = 0;
+    int num_removed_actions = 0;
+    for (int node = 0; node < num_nodes; node++)
+    {
+        kept[node] = node == initial || node == final || tn_abstract_get_enabled_actions(abstraction, node) != 0;
+        for (int i = 0; i < tn_get_num_successors(network, node); i++)
+            kept_arcs[num_arcs++] = tn_abstract_is_edge_enabled(abstraction, node, i);
+    }
+
+    TunnelPruning pruning = malloc(sizeof(*pruning));
+    pruning->graph = graph_induced_subgraph(tn_get_graph(network), kept, kept_arcs);
+    pruning->original_nodes = malloc((num_nodes + 1) * sizeof(int));
+
+    int num_kept = 0;
+    for (int node = 0; node < num_nodes; node++)
+    {
+        if (!kept[node])
+            continue;
+        int enabled = tn_abstract_get_enabled_actions(abstraction, node);
+        num_removed_actions += __builtin_popcount(tn_get_actions(network, node) & ~enabled);
+        masks[num_kept] = enabled;
+        pruning->original_nodes[num_kept++] = node;
+    }
+    // the reduced network only sees the enabled actions
+    free(pruning->graph.node_masks);
+    pruning->graph.node_masks = masks;
+    pruning->network = tn_initialize(pruning->graph);
+    for (int node = 0; node < num_kept; node++)
+    {
+        if (pruning->original_nodes[node] == initial)
+            tn_set_initial(pruning->network, node);
+        if (pruning->original_nodes[node] == final)
+            tn_set_final(pruning->network, node);
+    }
+
+    pruning->num_removed_nodes = num_nodes - num_kept;
+    pruning->num_removed_actions = num_removed_actions;
+    pruning->num_removed_edges = 0;
+    for (int node = 0; node < num_nodes; node++)
+        pruning->num_removed_edges += tn_get_num_successors(network, node);
+    for (int node = 0; node < num_kept; node++)
+        pruning->num_removed_edges -= tn_get_num_successors(pruning->network, node);
+
+    tn_abstract_delete(abstraction);
+    free(kept);
+    free(kept_arcs);
+    return pruning;
+}
+void tn_pruning_delete(TunnelPruning pruning)
+{
+    tn_delete(pruning->network);
+    graph_delete(pruning->graph);
+    free(pruning->original_nodes);
+    free(pruning);
+}
+
+TunnelNetwork tn_pruning_get_network(TunnelPruning pruning)
+{
+    return pruning->network;
+}
+
+int tn_pruning_get_original_node(TunnelPruning pruning, int node)
+{
+    return pruning->original_nodes[node];
+}
+
+int tn_pruning_get_num_removed_nodes(TunnelPruning pruning)
+{
+    return pruning->num_removed_nodes;
+}
+
+int tn_pruning_get_num_removed_edges(TunnelPruning pruning)
+{
+    return pruning->num_removed_edges;
+}
+
+int tn_pruning_get_num_removed_actions(TunnelPruning pruning)
+{
+    return pruning->num_removed_actions;
+}
+
+void tn_pruning_restore_path(TunnelPruning pruning, tn_step *path, int size_path)
+{
+    for (int step = 0; step < size_path; step++)
+        path[step] = tn_step_create(path[step].action, pruning->original_nodes[path[step].source], pruning->original_nodes[path[step].target]);
+}
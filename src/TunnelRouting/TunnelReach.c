@@ -0,0 +1,244 @@
+#include "TunnelReach.h"
+#include "TunnelNetwork.h"
+#include "TunnelStack.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+/**
+ * @brief A configuration reached from the source. Its stack is stored in the table, as the word low of a tn_stack followed by its words high.
+ *
+ */
+typedef struct
+{
+    int node;            ///< The node where the packet is.
+    int height;          ///< The number of cells of the stack.
+    int depth;           ///< The number of steps from the source.
+    int parent;          ///< The configuration before the last step (-1 for the source).
+    stack_action action; ///< The action performed by the node of the parent configuration.
+} tn_reach_configuration;
+
+struct TunnelReach_s
+{
+    TunnelNetwork network;                   ///< The network explored.
+    int source;                              ///< The node where the paths start.
+    tn_reach_configuration *configurations;  ///< The configurations, by increasing depth.
+    uint64_t *stacks;                        ///< The stacks of the configurations, num_words words each.
+    int num_words;                           ///< The number of words of a stack.
+    int size;                                ///< The number of configurations.
+    int capacity;                            ///< The allocated number of configurations.
+    int *slots;                              ///< Open-addressing set of the configurations (-1 if empty).
+    int num_slots;                           ///< The number of slots (a power of 2), at least twice the size.
+    int *lengths;                            ///< lengths[n] is the size of a shortest valid path to n (0 if none).
+    int *arrivals;                           ///< arrivals[n] is the configuration before the last step of that path.
+    stack_action *arrival_actions;           ///< arrival_actions[n] is the action of the last step of that path.
+    tn_stack buffer;                         ///< A stack to load the stored ones.
+};
+
+/**
+ * @brief Returns the stack of the configuration @p index.
+ */
+static inline uint64_t *tn_reach_stack(TunnelReach reach, int index)
+{
+    return reach->stacks + (size_t)index * reach->num_words;
+}
+
+/**
+ * @brief Loads the stack of the configuration @p index in @p stack.
+ */
+static inline void tn_reach_load(TunnelReach reach, int index, tn_stack *stack)
+{
+    uint64_t *words = tn_reach_stack(reach, index);
+    stack->height = reach->configurations[index].height;
+    stack->low = words[0];
+    if (stack->high != NULL)
+        memcpy(stack->high, words + 1, (reach->num_words - 1) * sizeof(uint64_t));
+}
+
+/**
+ * @brief Tells if the configuration @p index has the stack @p stack.
+ */
+static inline bool tn_reach_has_stack(TunnelReach reach, int index, tn_stack *stack)
+{
+    uint64_t *words = tn_reach_stack(reach, index);
+    if (reach->configurations[index].height != stack->height || words[0] != stack->low)
+        return false;
+    return stack->high == NULL || memcmp(words + 1, stack->high, (reach->num_words - 1) * sizeof(uint64_t)) == 0;
+}
+
+/**
+ * @brief Hash of a configuration.
+ */
+static inline uint64_t tn_reach_hash(int node, tn_stack *stack)
+{
+    return tn_stack_hash(stack) ^ ((uint64_t)node * 0x9e3779b97f4a7c15ULL);
+}
+
+/**
+ * @brief Adds the configuration (@p node, @p stack) to @p reach if it was not reached yet.
+ */
+static void tn_reach_add(TunnelReach reach, int node, tn_stack *stack, int depth, int parent, stack_action action)
+{
+    int slot = tn_reach_hash(node, stack) & (reach->num_slots - 1);
+    while (reach->slots[slot] != -1)
+    {
+        int index = reach->slots[slot];
+        if (reach->configurations[index].node == node && tn_reach_has_stack(reach, index, stack))
+            return;
+        slot = (slot + 1) & (reach->num_slots - 1);
+    }
+
+    if (reach->size == reach->capacity)
+    {
+        reach->capacity *= 2;
+        reach->configurations = realloc(reach->configurations, reach->capacity * sizeof(tn_reach_configuration));
+        reach->stacks = realloc(reach->stacks, (size_t)reach->capacity * reach->num_words * sizeof(uint64_t));
+        if (reach->configurations == NULL || reach->stacks == NULL)
+        {
+            printf("Malloc failed\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    int index = reach->size++;
+    reach->configurations[index].node = node;
+    reach->configurations[index].height = stack->height;
+    reach->configurations[index].depth = depth;
+    reach->configurations[index].parent = parent;
+    reach->configurations[index].action = action;
+    uint64_t *words = tn_reach_stack(reach, index);
+    words[0] = stack->low;
+    if (stack->high != NULL)
+        memcpy(words + 1, stack->high, (reach->num_words - 1) * sizeof(uint64_t));
+    reach->slots[slot] = index;
+
+    // the set is kept at most half full
+    if (2 * reach->size > reach->num_slots)
+    {
+        reach->num_slots *= 2;
+        free(reach->slots);
+        reach->slots = malloc(reach->num_slots * sizeof(int));
+        if (reach->slots == NULL)
+        {
+            printf("Malloc failed\n");
+            exit(EXIT_FAILURE);
+        }
+        memset(reach->slots, -1, reach->num_slots * sizeof(int));
+        for (int i = 0; i < reach->size; i++)
+        {
+            tn_reach_load(reach, i, &reach->buffer);
+            int s = tn_reach_hash(reach->configurations[i].node, &reach->buffer) & (reach->num_slots - 1);
+            while (reach->slots[s] != -1)
+                s = (s + 1) & (reach->num_slots - 1);
+            reach->slots[s] = i;
+        }
+    }
+}
+
+TunnelReach tn_reach_create(TunnelNetwork network, int source, int length)
+{
+    int num_nodes = tn_get_num_nodes(network);
+    TunnelReach reach = malloc(sizeof(*reach));
+    if (reach == NULL)
+    {
+        printf("Malloc failed\n");
+        exit(EXIT_FAILURE);
+    }
+    // a path of size length never has more than length/2+1 cells in its stack
+    int capacity = length / 2 + 1;
+    reach->network = network;
+    reach->source = source;
+    tn_stack_init(&reach->buffer, capacity);
+    reach->num_words = 1 + tn_stack_num_high_words(capacity);
+    reach->capacity = 1024;
+    reach->size = 0;
+    reach->configurations = malloc(reach->capacity * sizeof(tn_reach_configuration));
+    reach->stacks = calloc((size_t)reach->capacity * reach->num_words, sizeof(uint64_t));
+    reach->num_slots = 2048;
+    reach->slots = malloc(reach->num_slots * sizeof(int));
+    reach->lengths = calloc(num_nodes, sizeof(int));
+    reach->arrivals = malloc(num_nodes * sizeof(int));
+    reach->arrival_actions = malloc(num_nodes * sizeof(stack_action));
+    if (reach->configurations == NULL || reach->stacks == NULL || reach->slots == NULL || reach->lengths == NULL || reach->arrivals == NULL || reach->arrival_actions == NULL)
+    {
+        printf("Malloc failed\n");
+        exit(EXIT_FAILURE);
+    }
+    memset(reach->slots, -1, reach->num_slots * sizeof(int));
+
+    tn_stack stack;
+    tn_stack_init(&stack, capacity);
+    tn_reach_add(reach, source, &stack, 0, -1, transmit_4);
+
+    // the configurations are stored by increasing depth, so the first one reaching a node with the stack [4] gives its shortest path (even the source, already stored at depth 0)
+    for (int index = 0; index < reach->size && reach->configurations[index].depth < length; index++)
+    {
+        int node = reach->configurations[index].node;
+        int depth = reach->configurations[index].depth + 1;
+        tn_reach_load(reach, index, &stack);
+        int mask = tn_get_actions_by_top(network, node, tn_stack_top_symbol(&stack));
+        int num_successors = tn_get_num_successors(network, node);
+        int *successors = tn_get_successors(network, node);
+
+        for (int action = tn_next_action(mask, 0); action < NumActions; action = tn_next_action(mask, action + 1))
+        {
+            tn_reach_load(reach, index, &stack);
+            if (!tn_stack_apply(&stack, action))
+                continue;
+            // the cells above the bottom must all be popped in the remaining steps
+            if (stack.height - 1 > length - depth)
+                continue;
+
+            for (int i = 0; i < num_successors; i++)
+            {
+                int next = successors[i];
+                if (stack.height == 1 && reach->lengths[next] == 0)
+                {
+                    reach->lengths[next] = depth;
+                    reach->arrivals[next] = index;
+                    reach->arrival_actions[next] = action;
+                }
+                tn_reach_add(reach, next, &stack, depth, index, action);
+            }
+        }
+    }
+
+    tn_stack_free(&stack);
+    return reach;
+}
+
+void tn_reach_delete(TunnelReach reach)
+{
+    tn_stack_free(&reach->buffer);
+    free(reach->configurations);
+    free(reach->stacks);
+    free(reach->slots);
+    free(reach->lengths);
+    free(reach->arrivals);
+    free(reach->arrival_actions);
+    free(reach);
+}
+
+int tn_reach_get_num_configurations(TunnelReach reach)
+{
+    return reach->size;
+}
+
+int tn_reach_get_length(TunnelReach reach, int node)
+{
+    return reach->lengths[node];
+}
+
+void tn_reach_get_path(TunnelReach reach, int node, tn_step *path)
+{
+    int length = reach->lengths[node];
+    int index = reach->arrivals[node];
+    path[length - 1] = tn_step_create(reach->arrival_actions[node], reach->configurations[index].node, node);
+    for (int step = length - 2; step >= 0; step--)
+    {
+        int parent = reach->configurations[index].parent;
+        path[step] = tn_step_create(reach->configurations[index].action, reach->configurations[parent].node, reach->configurations[index].node);
+        index = parent;
+    }
+}
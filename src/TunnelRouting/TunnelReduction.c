@@ -2,78 +2,275 @@
 #include "Z3Tools.h"
 #include "stdio.h"
 #include <stdlib.h>
+#include <string.h>
 #include <assert.h>
 
 /**
- * @brief Creates the variable "x_{node,pos,stack_height}" of the reduction (described in the subject).
+ * @brief Wrapper to have the correct size of the array representing the stack (correct cells of the stack will be from 0 to (get_stack_size(length)-1)).
+ *
+ * @param length The length of the sought path.
+ * @return int
+ */
+int get_stack_size(int length)
+{
+    return length / 2 + 1;
+}
+
+
+
+/**
+ * @brief The variables of the reduction for a network and a path length. Every variable is created once (with an integer symbol, so that no name has to be built or hashed), and then accessed by its indices.
+ * The variables that are false in every model (a node that cannot be at that position, a cell that cannot be occupied at that position) are not created: their entry is the constant false, and the encoder emits no constraint about them.
+ *
+ */
+struct TunnelVariables_s
+{
+    TunnelNetwork network; ///< The network.
+    int length;            ///< The length of the path.
+    int num_nodes;         ///< The number of nodes of the network.
+    int stack_size;        ///< The number of cells of the stack (get_stack_size(length)).
+    Z3_ast *path;          ///< The variables x_{node,pos,height}, indexed by (pos * num_nodes + node) * stack_size + height.
+    Z3_ast *four;          ///< The variables y_{pos,height,4}, indexed by pos * stack_size + height.
+    Z3_ast *six;           ///< The variables y_{pos,height,6}, indexed by pos * stack_size + height.
+    tn_encoding encoding;  ///< The encoding of the uniqueness constraints.
+    Z3_ast *node;          ///< With tn_factored_encoding, the variables n_{node,pos}, indexed by pos * num_nodes + node (NULL otherwise).
+    Z3_ast *height;        ///< With tn_factored_encoding, the variables h_{pos,height}, indexed by pos * stack_size + height (NULL otherwise).
+    bool *alive;           ///< alive[pos * num_nodes + node] tells if the packet can be at node at position pos.
+    int *max_height;       ///< max_height[pos] is the highest cell that can be occupied at position pos.
+    long num_variables;    ///< The number of variables actually created.
+};
+
+/**
+ * @brief Creates a fresh boolean variable designated by the integer symbol @p id.
  *
  * @param ctx The solver context.
+ * @param id A number that no other variable of the reduction uses.
+ * @return Z3_ast
+ */
+static Z3_ast tn_mk_int_variable(Z3_context ctx, int id)
+{
+    return Z3_mk_const(ctx, Z3_mk_int_symbol(ctx, id), Z3_mk_bool_sort(ctx));
+}
+
+void tn_compute_alive(TunnelNetwork network, int length, bool backward, bool *alive)
+{
+    int num_nodes = tn_get_num_nodes(network);
+    bool *forward = (bool *)calloc((size_t)(length + 1) * num_nodes, sizeof(bool));
+    forward[tn_get_initial(network)] = true;
+    for (int pos = 0; pos < length; pos++)
+    {
+        bool *current = forward + (size_t)pos * num_nodes;
+        bool *next = current + num_nodes;
+        for (int node = 0; node < num_nodes; node++)
+        {
+            if (!current[node])
+                continue;
+            int *successors = tn_get_successors(network, node);
+            for (int k = 0; k < tn_get_num_successors(network, node); k++)
+                next[successors[k]] = true;
+        }
+    }
+
+    if (!backward)
+    {
+        memcpy(alive, forward, (size_t)(length + 1) * num_nodes * sizeof(bool));
+        free(forward);
+        return;
+    }
+
+    bool *to_final = (bool *)calloc((size_t)(length + 1) * num_nodes, sizeof(bool));
+    to_final[(size_t)length * num_nodes + tn_get_final(network)] = true;
+    for (int pos = length - 1; pos >= 0; pos--)
+    {
+        bool *current = to_final + (size_t)pos * num_nodes;
+        bool *next = current + num_nodes;
+        for (int node = 0; node < num_nodes; node++)
+        {
+            if (!next[node])
+                continue;
+            int *predecessors = tn_get_predecessors(network, node);
+            for (int k = 0; k < tn_get_num_predecessors(network, node); k++)
+                current[predecessors[k]] = true;
+        }
+    }
+
+    for (size_t i = 0; i < (size_t)(length + 1) * num_nodes; i++)
+        alive[i] = forward[i] && to_final[i];
+    free(forward);
+    free(to_final);
+}
+
+/**
+ * @brief Creates the variables of the reduction.
+ *
+ * @param backward If true, the path has exactly the size @p length, which allows to discard the nodes that cannot reach the final node in time and the heights that cannot be popped in time. If false (incremental mode), shorter paths must still be representable.
+ */
+static TunnelVariables tn_variables_build(Z3_context ctx, TunnelNetwork network, int length, tn_encoding encoding, bool backward)
+{
+    TunnelVariables variables = (TunnelVariables)malloc(sizeof(*variables));
+    variables->network = network;
+    variables->length = length;
+    variables->num_nodes = tn_get_num_nodes(network);
+    variables->stack_size = get_stack_size(length);
+    int N = variables->num_nodes;
+    int H = variables->stack_size;
+
+    long num_path = (long)(length + 1) * N * H;
+    long num_cells = (long)(length + 1) * H;
+    long num_node = (long)(length + 1) * N;
+    long num_factored = (encoding == tn_factored_encoding) ? num_node + num_cells : 0;
+    if (num_path + 2 * num_cells + num_factored >= (1L << 30))
+    {
+        fprintf(stderr, "Error: too many variables for the reduction (length %d, %d nodes).\n", length, variables->num_nodes);
+        exit(EXIT_FAILURE);
+    }
+
+    // une pile ne gagne qu'une case par pas, et doit être vidée avant la fin si la longueur est connue
+    variables->alive = (bool *)malloc(num_node * sizeof(bool));
+    variables->max_height = (int *)malloc((length + 1) * sizeof(int));
+    tn_compute_alive(network, length, backward, variables->alive);
+    for (int pos = 0; pos <= length; pos++)
+    {
+        int max_height = backward && length - pos < pos ? length - pos : pos;
+        variables->max_height[pos] = max_height < H - 1 ? max_height : H - 1;
+    }
+
+    Z3_ast false_ast = Z3_mk_false(ctx);
+    variables->num_variables = 0;
+    variables->path = (Z3_ast *)malloc(num_path * sizeof(Z3_ast));
+    variables->four = (Z3_ast *)malloc(num_cells * sizeof(Z3_ast));
+    variables->six = (Z3_ast *)malloc(num_cells * sizeof(Z3_ast));
+    for (long i = 0; i < num_path; i++)
+    {
+        long pos_node = i / H;
+        bool alive = variables->alive[pos_node] && i % H <= variables->max_height[pos_node / N];
+        variables->path[i] = alive ? tn_mk_int_variable(ctx, i) : false_ast;
+        variables->num_variables += alive;
+    }
+    for (long i = 0; i < num_cells; i++)
+    {
+        bool alive = i % H <= variables->max_height[i / H];
+        variables->four[i] = alive ? tn_mk_int_variable(ctx, num_path + i) : false_ast;
+        variables->six[i] = alive ? tn_mk_int_variable(ctx, num_path + num_cells + i) : false_ast;
+        variables->num_variables += 2 * alive;
+    }
+
+    variables->encoding = encoding;
+    variables->node = NULL;
+    variables->height = NULL;
+    if (encoding == tn_factored_encoding)
+    {
+        long first = num_path + 2 * num_cells;
+        variables->node = (Z3_ast *)malloc(num_node * sizeof(Z3_ast));
+        variables->height = (Z3_ast *)malloc(num_cells * sizeof(Z3_ast));
+        for (long i = 0; i < num_node; i++)
+        {
+            variables->node[i] = variables->alive[i] ? tn_mk_int_variable(ctx, first + i) : false_ast;
+            variables->num_variables += variables->alive[i];
+        }
+        for (long i = 0; i < num_cells; i++)
+        {
+            bool alive = i % H <= variables->max_height[i / H];
+            variables->height[i] = alive ? tn_mk_int_variable(ctx, first + num_node + i) : false_ast;
+            variables->num_variables += alive;
+        }
+    }
+    return variables;
+}
+
+TunnelVariables tn_variables_create(Z3_context ctx, TunnelNetwork network, int length, tn_encoding encoding)
+{
+    return tn_variables_build(ctx, network, length, encoding, true);
+}
+
+long tn_variables_get_num_variables(TunnelVariables variables)
+{
+    return variables->num_variables;
+}
+
+void tn_variables_delete(TunnelVariables variables)
+{
+    free(variables->path);
+    free(variables->four);
+    free(variables->six);
+    free(variables->node);
+    free(variables->height);
+    free(variables->alive);
+    free(variables->max_height);
+    free(variables);
+}
+
+/**
+ * @brief Gets the variable "x_{node,pos,stack_height}" of the reduction (described in the subject).
+ *
+ * @param variables The variables of the reduction.
  * @param node A node.
  * @param pos The path position.
  * @param stack_height The highest cell occupied of the stack at that position.
  * @return Z3_ast
  */
-Z3_ast tn_path_variable(Z3_context ctx, int node, int pos, int stack_height)
+static inline Z3_ast tn_path_variable(TunnelVariables variables, int node, int pos, int stack_height)
+{
+    return variables->path[(pos * variables->num_nodes + node) * variables->stack_size + stack_height];
+}
+
+/**
+ * @brief Tells if the variable x_{node,pos,stack_height} exists (i.e. is not the constant false).
+ */
+static inline bool tn_is_alive(TunnelVariables variables, int node, int pos, int stack_height)
 {
-    char name[60];
-    snprintf(name, 60, "node %d,pos %d, height %d", node, pos, stack_height);
-    return mk_bool_var(ctx, name);
+    return variables->alive[pos * variables->num_nodes + node] && stack_height <= variables->max_height[pos];
 }
 
 /**
- * @brief Creates the variable "y_{pos,height,4}" of the reduction (described in the subject).
+ * @brief Gets the variable "y_{pos,height,4}" of the reduction (described in the subject).
  *
- * @param ctx The solver context.
+ * @param variables The variables of the reduction.
  * @param pos The path position.
  * @param height The height of the cell described.
  * @return Z3_ast
  */
-Z3_ast tn_4_variable(Z3_context ctx, int pos, int height)
+static inline Z3_ast tn_4_variable(TunnelVariables variables, int pos, int height)
 {
-    char name[60];
-    snprintf(name, 60, "4 at height %d on pos %d", height, pos);
-    return mk_bool_var(ctx, name);
+    return variables->four[pos * variables->stack_size + height];
 }
 
-
-
-
 /**
- * @brief Creates the variable "y_{pos,height,6}" of the reduction (described in the subject).
+ * @brief Gets the variable "y_{pos,height,6}" of the reduction (described in the subject).
  *
- * @param ctx The solver context.
+ * @param variables The variables of the reduction.
  * @param pos The path position.
  * @param height The height of the cell described.
  * @return Z3_ast
  */
-Z3_ast tn_6_variable(Z3_context ctx, int pos, int height)
+static inline Z3_ast tn_6_variable(TunnelVariables variables, int pos, int height)
 {
-    char name[60];
-    snprintf(name, 60, "6 at height %d on pos %d", height, pos);
-    return mk_bool_var(ctx, name);
+    return variables->six[pos * variables->stack_size + height];
 }
 
 /**
- * @brief Wrapper to have the correct size of the array representing the stack (correct cells of the stack will be from 0 to (get_stack_size(length)-1)).
- *
- * @param length The length of the sought path.
- * @return int
+ * @brief Returns the class of the actions changing the height by @p delta (-1, 0 or 1).
  */
-int get_stack_size(int length)
+static inline tn_action_class tn_class_of_delta(int delta)
 {
-    return length / 2 + 1;
+    return delta == 0 ? tn_transmit_class : (delta > 0 ? tn_push_class : tn_pop_class);
 }
 
-
-
 /**
- * @brief on verifie s'il existe une arête entre (u,v)
+ * @brief Tells if @p node has an action changing the height by @p delta (-1, 0 or 1).
  */
-static int tn_has_edge_wrapper(const TunnelNetwork network, int u, int v)
+static inline bool tn_has_class_for(TunnelNetwork network, int node, int delta)
 {
-    return tn_is_edge(network, u, v) ? 1 : 0;
+    return (tn_get_action_classes(network, node) & (1 << tn_class_of_delta(delta))) != 0;
 }
 
+/**
+ * @brief Gets the variable "y_{pos,height,symbol}" of the reduction, @p symbol being 4 or 6 (as in tn_action_table).
+ */
+static inline Z3_ast tn_symbol_variable(TunnelVariables variables, int pos, int height, int symbol)
+{
+    return symbol == 4 ? tn_4_variable(variables, pos, height) : tn_6_variable(variables, pos, height);
+}
 
 /**
  * @brief---------------------------------------------------------------------------------------------------------
@@ -82,10 +279,15 @@ static int tn_has_edge_wrapper(const TunnelNetwork network, int u, int v)
 *------------- Organisation : chaque famille de contraintes a sa propre fonction :---------------------------
 *------------- tn_condition_initial_and_final : conditions terminales et initiales (pile vide).--------------
 *------------- tn_condition_uniqueness : exactement une paire (node,height) vraie par position.--------------
+*------------- tn_condition_uniqueness_factored : idem, avec des variables nœud et hauteur séparées.--------
 *------------- tn_condition_edges : contraintes de voisinage (suivant doit être voisin dans le graphe).------
 *------------- tn_condition_stack_wellformed : pas de double-occupation et pas de trous.---------------------
 *------------- tn_condition_occupancy : si le paquet est à (node,pos,h) alors la case pos,h est occupée.------
+*------------- tn_condition_stack_frame : les cases sous le sommet ne changent pas d'une position à l'autre.-
 *------------- tn_condition_actions : encode les opérations transmit/push/pop comme implications logiques.----
+*------------- Chaque famille (sauf initial/final) est la conjonction de ses couches tn_layer_* : la couche --
+*------------- pos ne parle que des positions pos et pos+1, ce qui permet au mode incrémental de n'ajouter---
+*------------- que les nouvelles couches quand la longueur augmente.------------------------------------------
 *-------------------------------------------------------------------------------------------------------------
 *------------------------------------------------------------------------------------------------------------
  *  @brief
@@ -98,46 +300,61 @@ static int tn_has_edge_wrapper(const TunnelNetwork network, int u, int v)
  * ------------------ Condition finale : on termine au nœud final avec une pile vide (hauteur = 0)------------
  */
 
-Z3_ast tn_condition_initial_and_final(Z3_context ctx, const TunnelNetwork network, int length)
+/**
+ * @brief Une famille de contraintes restreinte a une position.
+ */
+typedef Z3_ast (*tn_layer)(Z3_context ctx, TunnelVariables vars, int pos);
+
+/**
+ * @brief conjonction des couches @p layer pour les positions first..last.
+ */
+static Z3_ast tn_all_layers(Z3_context ctx, TunnelVariables vars, tn_layer layer, int first, int last)
+{
+    if (last < first)
+        return Z3_mk_true(ctx);
+    Z3_ast *conjs = malloc(sizeof(Z3_ast) * (last - first + 1));
+    int ci = 0;
+    for (int pos = first; pos <= last; ++pos)
+        conjs[ci++] = layer(ctx, vars, pos);
+    Z3_ast result = Z3_mk_and(ctx, ci, conjs);
+    free(conjs);
+    return result;
+}
+
+/**
+ * @brief le paquet est au nœud @p node a la position @p pos, avec une pile reduite a un paquet IPv4.
+ */
+static Z3_ast tn_condition_endpoint(Z3_context ctx, TunnelVariables vars, int node, int pos)
 {
-    int N = tn_get_num_nodes(network);
-    int H = get_stack_size(length);
-    int init = tn_get_initial(network);
+    int N = vars->num_nodes;
+    int H = vars->stack_size;
 
     // liste dynamique , maximum N*H contraintes
-    Z3_ast *init_list = malloc(sizeof(Z3_ast) * (N * H + 1));
+    Z3_ast *list = malloc(sizeof(Z3_ast) * (N * H + 2));
     int idx = 0;
 
-    // x_(init,0,0) est vrai 
-    init_list[idx++] = tn_path_variable(ctx, init, 0, 0);
+    // x_(node,pos,0) est vrai et le fond de pile est un paquet IPv4
+    list[idx++] = tn_path_variable(vars, node, pos, 0);
+    list[idx++] = tn_4_variable(vars, pos, 0);
 
-    // etvtoutes les autres paires (node, height) à pos 0 sont fausses 
+    // et toutes les autres paires (node, height) à pos sont fausses 
     for (int n = 0; n < N; ++n) {
         for (int h = 0; h < H; ++h) {
-            if (!(n == init && h == 0)) {
-                init_list[idx++] = Z3_mk_not(ctx, tn_path_variable(ctx, n, 0, h));
+            if (!(n == node && h == 0) && tn_is_alive(vars, n, pos, h)) {
+                list[idx++] = Z3_mk_not(ctx, tn_path_variable(vars, n, pos, h));
             }
         }
     }
-    Z3_ast init_form = Z3_mk_and(ctx, idx, init_list);
-    free(init_list);
-
-   
-    int fin = tn_get_final(network);
-    Z3_ast *final_list = malloc(sizeof(Z3_ast) * (N * H + 1));
-    int idxf = 0;
-
-    final_list[idxf++] = tn_path_variable(ctx, fin, length, 0);
+    Z3_ast result = Z3_mk_and(ctx, idx, list);
+    free(list);
+    return result;
+}
 
-    for (int n = 0; n < N; ++n) {
-        for (int h = 0; h < H; ++h) {
-            if (!(n == fin && h == 0)) {
-                final_list[idxf++] = Z3_mk_not(ctx, tn_path_variable(ctx, n, length, h));
-            }
-        }
-    }
-    Z3_ast final_form = Z3_mk_and(ctx, idxf, final_list);
-    free(final_list);
+Z3_ast tn_condition_initial_and_final(Z3_context ctx, TunnelVariables vars)
+{
+    TunnelNetwork network = vars->network;
+    Z3_ast init_form = tn_condition_endpoint(ctx, vars, tn_get_initial(network), 0);
+    Z3_ast final_form = tn_condition_endpoint(ctx, vars, tn_get_final(network), vars->length);
 
     Z3_ast both[2] = {init_form, final_form};
     return Z3_mk_and(ctx, 2, both);
@@ -154,49 +371,104 @@ Z3_ast tn_condition_initial_and_final(Z3_context ctx, const TunnelNetwork networ
  * ------------------- a chaque position pos, exactement un couple (node,height) est vrai ------------
  */
 
-Z3_ast tn_condition_uniqueness(Z3_context ctx, const TunnelNetwork network, int length)
+static Z3_ast tn_layer_uniqueness(Z3_context ctx, TunnelVariables vars, int pos)
 {
-    int N = tn_get_num_nodes(network);
-    int H = get_stack_size(length);
+    int N = vars->num_nodes;
+    int H = vars->stack_size;
+
+    // seules les variables qui existent a cette position participent
+    Z3_ast *or_args = malloc(sizeof(Z3_ast) * (N * H + 1));
+    int oi = 0;
+    for (int n = 0; n < N; ++n)
+        for (int h = 0; h < H; ++h)
+            if (tn_is_alive(vars, n, pos, h))
+                or_args[oi++] = tn_path_variable(vars, n, pos, h);
+
+    // aucun couple possible a cette position : la disjonction vide est fausse
+    if (oi == 0) {
+        free(or_args);
+        return Z3_mk_false(ctx);
+    }
 
     // Nous  accumulons les conjonctions dans un tableau dynamique 
-    int est_upper = (length + 1) * (1 + (N * H) + (N * H * (N * H - 1) / 2));
+    int est_upper = 1 + (oi * (oi - 1) / 2);
     Z3_ast *conjs = malloc(sizeof(Z3_ast) * est_upper);
     int ci = 0;
 
-    for (int pos = 0; pos <= length; ++pos) {
-        // au moins un : OR_(n,h) x_(n,pos,h)
-        //X(n1​,pos,h1​)∨X(n2​,pos,h2​)∨⋯∨X(nN​,pos,hH​)
-        Z3_ast *or_args = malloc(sizeof(Z3_ast) * (N * H));
-        int oi = 0;
-        for (int n = 0; n < N; ++n)
-            for (int h = 0; h < H; ++h)
-                or_args[oi++] = tn_path_variable(ctx, n, pos, h);
-        conjs[ci++] = Z3_mk_or(ctx, oi, or_args);
-        free(or_args);
+    // au moins un : OR_(n,h) x_(n,pos,h)
+    //X(n1​,pos,h1​)∨X(n2​,pos,h2​)∨⋯∨X(nN​,pos,hH​)
+    conjs[ci++] = Z3_mk_or(ctx, oi, or_args);
 
-        // au plus un : pour chaque paire distincte i<j on interdit (vi and vj) 
-        for (int n1 = 0; n1 < N; ++n1) {
-            for (int h1 = 0; h1 < H; ++h1) {
-                for (int n2 = n1; n2 < N; ++n2) {
-                    int h2start = (n1 == n2) ? h1 + 1 : 0; //on evite les doublons (i,j) et (j,i)
-                    for (int h2 = h2start; h2 < H; ++h2) {
-                        //¬(X(n1​,pos,h1​)∧X(n2​,pos,h2​))
-                        Z3_ast a = tn_path_variable(ctx, n1, pos, h1);
-                        Z3_ast b = tn_path_variable(ctx, n2, pos, h2);
-                        Z3_ast both = Z3_mk_and(ctx, 2, (Z3_ast[]){a, b});
-                        conjs[ci++] = Z3_mk_not(ctx, both);
-                    }
-                }
-            }
+    // au plus un : pour chaque paire distincte i<j on interdit (vi and vj) 
+    for (int i = 0; i < oi; ++i) {
+        for (int j = i + 1; j < oi; ++j) {
+            //¬(X(n1​,pos,h1​)∧X(n2​,pos,h2​))
+            Z3_ast both = Z3_mk_and(ctx, 2, (Z3_ast[]){or_args[i], or_args[j]});
+            conjs[ci++] = Z3_mk_not(ctx, both);
         }
     }
+    free(or_args);
 
     Z3_ast result = Z3_mk_and(ctx, ci, conjs);
     free(conjs);
     return result;
 }
 
+Z3_ast tn_condition_uniqueness(Z3_context ctx, TunnelVariables vars)
+{
+    return tn_all_layers(ctx, vars, tn_layer_uniqueness, 0, vars->length);
+}
+
+/**
+ * @brief
+* @param ctx The solver context.
+ * @param network.
+ * @param length la longueur du chemin.
+ * @return Z3_ast
+ * -------------------------------- Unicité, version factorisée ---------------------------------------
+ * ------------------- a chaque position pos, exactement un nœud n(.,pos) et une hauteur h(pos,.) -----
+ * ------------------- sont vrais, et x(n,pos,h) ⇔ n(n,pos) ∧ h(pos,h) ---------------------------------
+ * ------------------- O(N·H) clauses par position au lieu de O((N·H)²) -------------------------------
+ */
+
+static Z3_ast tn_layer_uniqueness_factored(Z3_context ctx, TunnelVariables vars, int pos)
+{
+    int N = vars->num_nodes;
+    int H = vars->stack_size;
+
+    Z3_ast *conjs = malloc(sizeof(Z3_ast) * (2 + N * H));
+    int ci = 0;
+
+    Z3_ast *nodes = vars->node + pos * N;
+    Z3_ast *heights = vars->height + pos * H;
+
+    Z3_ast *alive_nodes = malloc(sizeof(Z3_ast) * (N + 1));
+    int num_alive = 0;
+    for (int n = 0; n < N; ++n)
+        if (vars->alive[pos * N + n])
+            alive_nodes[num_alive++] = nodes[n];
+    conjs[ci++] = unique_sequential_formula(ctx, alive_nodes, num_alive);
+    conjs[ci++] = unique_sequential_formula(ctx, heights, vars->max_height[pos] + 1);
+    free(alive_nodes);
+
+    for (int n = 0; n < N; ++n) {
+        for (int h = 0; h < H; ++h) {
+            if (!tn_is_alive(vars, n, pos, h)) continue;
+            //X(n,pos,h)⇔(N(n,pos)∧H(pos,h))
+            Z3_ast both = Z3_mk_and(ctx, 2, (Z3_ast[]){nodes[n], heights[h]});
+            conjs[ci++] = Z3_mk_iff(ctx, tn_path_variable(vars, n, pos, h), both);
+        }
+    }
+
+    Z3_ast result = Z3_mk_and(ctx, ci, conjs);
+    free(conjs);
+    return result;
+}
+
+Z3_ast tn_condition_uniqueness_factored(Z3_context ctx, TunnelVariables vars)
+{
+    return tn_all_layers(ctx, vars, tn_layer_uniqueness_factored, 0, vars->length);
+}
 
 /**
  * @brief
@@ -207,51 +479,59 @@ Z3_ast tn_condition_uniqueness(Z3_context ctx, const TunnelNetwork network, int
  * -------------------------------- des arêtes bien definie ----------------------------------------
  * ------------------ Si on est au nœud u a pos, alors le nœud v a pos+1 doit être un voisin. ------------*/
 
-Z3_ast tn_condition_edges(Z3_context ctx, const TunnelNetwork network, int length)
+static Z3_ast tn_layer_edges(Z3_context ctx, TunnelVariables vars, int pos)
 {
-    int N = tn_get_num_nodes(network);
-    int H = get_stack_size(length);
+    TunnelNetwork network = vars->network;
+    int N = vars->num_nodes;
+    int H = vars->stack_size;
 
-    int est_upper = length * N * H * (N * H + 1);
-    Z3_ast *conjs = malloc(sizeof(Z3_ast) * est_upper);
+    Z3_ast *conjs = malloc(sizeof(Z3_ast) * (N * H + 1));
     int ci = 0;
 
-    for (int pos = 0; pos < length; ++pos) {
-        for (int u = 0; u < N; ++u) {
-            for (int h = 0; h < H; ++h) {
-                Z3_ast premise = tn_path_variable(ctx, u, pos, h);
-
-                // contruction la disjonction des positions possibles au pas suivant 
-                Z3_ast *nexts = malloc(sizeof(Z3_ast) * (N * H));
-                int ni = 0;
-                for (int v = 0; v < N; ++v) {
-                    if (!tn_has_edge_wrapper(network, u, v)) continue;
-                    for (int hp = 0; hp < H; ++hp) {
-                        nexts[ni++] = tn_path_variable(ctx, v, pos + 1, hp);
-                    }
-                }
+    for (int u = 0; u < N; ++u) {
+        int degree = tn_get_num_successors(network, u);
+        int *successors = tn_get_successors(network, u);
+        Z3_ast *nexts = malloc(sizeof(Z3_ast) * (3 * degree + 1));
 
-                if (ni == 0) {
-                    conjs[ci++] = Z3_mk_not(ctx, premise);
-                    free(nexts);
-                    continue;
+        for (int h = 0; h < H; ++h) {
+            if (!tn_is_alive(vars, u, pos, h)) continue;
+            Z3_ast premise = tn_path_variable(vars, u, pos, h);
+
+            /* seuls les successeurs de u et les hauteurs h-1, h, h+1 sont atteignables :
+               les autres couples sont exclus par l'unicité a pos+1.
+               une variation de hauteur n'est possible que si u a une action de cette classe */
+            int ni = 0;
+            for (int k = 0; k < degree; ++k) {
+                for (int hp = h - 1; hp <= h + 1; ++hp) {
+                    if (hp < 0 || hp >= H || !tn_has_class_for(network, u, hp - h) || !tn_is_alive(vars, successors[k], pos + 1, hp)) continue;
+                    nexts[ni++] = tn_path_variable(vars, successors[k], pos + 1, hp);
                 }
+            }
 
-                Z3_ast allowed = Z3_mk_or(ctx, ni, nexts);
-                free(nexts);
-
-                //X(u,pos,h)⇒(X(v1​,pos+1,h1​)∨⋯∨X(vk​,pos+1,hm​))
-
-                conjs[ci++] = Z3_mk_implies(ctx, premise, allowed);
+            if (ni == 0) {
+                conjs[ci++] = Z3_mk_not(ctx, premise);
+                continue;
             }
+
+            //X(u,pos,h)⇒(X(v1​,pos+1,h-1)∨⋯∨X(vk​,pos+1,h+1))
+            conjs[ci++] = Z3_mk_implies(ctx, premise, Z3_mk_or(ctx, ni, nexts));
         }
+        free(nexts);
     }
 
+    if (ci == 0)
+        conjs[ci++] = Z3_mk_true(ctx);
+
     Z3_ast result = Z3_mk_and(ctx, ci, conjs);
     free(conjs);
     return result;
 }
 
+Z3_ast tn_condition_edges(Z3_context ctx, TunnelVariables vars)
+{
+    return tn_all_layers(ctx, vars, tn_layer_edges, 0, vars->length - 1);
+}
+
 /**
  * @brief
 * @param ctx The solver context.
@@ -262,31 +542,30 @@ Z3_ast tn_condition_edges(Z3_context ctx, const TunnelNetwork network, int lengt
  * ----------------- interdit d’avoir a la fois une plaque IPv4 ET IPv6 au meme emplacement------------------------
  * ----------------- Si un niveau h est vide, alors tous les niveaux au-dessus doivent aussi être vides.------------*/
 
-Z3_ast tn_condition_stack_wellformed(Z3_context ctx, int length)
+static Z3_ast tn_layer_stack_wellformed(Z3_context ctx, TunnelVariables vars, int pos)
 {
-    int H = get_stack_size(length);
+    // les cases au-dessus de max_height sont la constante faux
+    int H = vars->max_height[pos] + 1;
 
-    int est_upper = (length + 1) * (H + H * (H - 1) / 2);
+    int est_upper = H + H * (H - 1) / 2;
     Z3_ast *conjs = malloc(sizeof(Z3_ast) * est_upper);
     int ci = 0;
 
-    for (int pos = 0; pos <= length; ++pos) {
-        for (int h = 0; h < H; ++h) {
-            // ¬(4(pos,h)∧6(pos,h))
-            Z3_ast both = Z3_mk_and(ctx, 2, (Z3_ast[]){tn_4_variable(ctx, pos, h), tn_6_variable(ctx, pos, h)});
-            conjs[ci++] = Z3_mk_not(ctx, both);
-
-            // si case h vide => toutes les cases >h vides 
-            //empty(pos,h)=¬4(pos,h)∧¬6(pos,h)
-            Z3_ast not4 = Z3_mk_not(ctx, tn_4_variable(ctx, pos, h));
-            Z3_ast not6 = Z3_mk_not(ctx, tn_6_variable(ctx, pos, h));
-            Z3_ast empty_h = Z3_mk_and(ctx, 2, (Z3_ast[]){not4, not6});
-            for (int hp = h + 1; hp < H; ++hp) {
-                Z3_ast not4p = Z3_mk_not(ctx, tn_4_variable(ctx, pos, hp));
-                Z3_ast not6p = Z3_mk_not(ctx, tn_6_variable(ctx, pos, hp));
-                Z3_ast empty_hp = Z3_mk_and(ctx, 2, (Z3_ast[]){not4p, not6p});
-                conjs[ci++] = Z3_mk_implies(ctx, empty_h, empty_hp);
-            }
+    for (int h = 0; h < H; ++h) {
+        // ¬(4(pos,h)∧6(pos,h))
+        Z3_ast both = Z3_mk_and(ctx, 2, (Z3_ast[]){tn_4_variable(vars, pos, h), tn_6_variable(vars, pos, h)});
+        conjs[ci++] = Z3_mk_not(ctx, both);
+
+        // si case h vide => toutes les cases >h vides 
+        //empty(pos,h)=¬4(pos,h)∧¬6(pos,h)
+        Z3_ast not4 = Z3_mk_not(ctx, tn_4_variable(vars, pos, h));
+        Z3_ast not6 = Z3_mk_not(ctx, tn_6_variable(vars, pos, h));
+        Z3_ast empty_h = Z3_mk_and(ctx, 2, (Z3_ast[]){not4, not6});
+        for (int hp = h + 1; hp < H; ++hp) {
+            Z3_ast not4p = Z3_mk_not(ctx, tn_4_variable(vars, pos, hp));
+            Z3_ast not6p = Z3_mk_not(ctx, tn_6_variable(vars, pos, hp));
+            Z3_ast empty_hp = Z3_mk_and(ctx, 2, (Z3_ast[]){not4p, not6p});
+            conjs[ci++] = Z3_mk_implies(ctx, empty_h, empty_hp);
         }
     }
 
@@ -295,8 +574,10 @@ Z3_ast tn_condition_stack_wellformed(Z3_context ctx, int length)
     return result;
 }
 
-
-
+Z3_ast tn_condition_stack_wellformed(Z3_context ctx, TunnelVariables vars)
+{
+    return tn_all_layers(ctx, vars, tn_layer_stack_wellformed, 0, vars->length);
+}
 
 /**
  * @brief
@@ -307,24 +588,28 @@ Z3_ast tn_condition_stack_wellformed(Z3_context ctx, int length)
  * ----------- Si x(n,pos,h) est vrai alors la cellule (pos,h) est occupée par (y4 ou y6).
  * ------------------ Ceci garantit l'absence d'incohérence ------------------------------*/
 
-Z3_ast tn_condition_occupancy(Z3_context ctx, const TunnelNetwork network, int length)
+static Z3_ast tn_layer_occupancy(Z3_context ctx, TunnelVariables vars, int pos)
 {
-    int N = tn_get_num_nodes(network);
-    int H = get_stack_size(length);
+    int N = vars->num_nodes;
+    int H = vars->stack_size;
 
-    int est_upper = (length + 1) * (N * H);
-    Z3_ast *conjs = malloc(sizeof(Z3_ast) * est_upper);
+    Z3_ast *conjs = malloc(sizeof(Z3_ast) * (N * H) * 2);
     int ci = 0;
 
-    for (int pos = 0; pos <= length; ++pos) {
-        for (int h = 0; h < H; ++h) {
-            //occ(pos,h)=4(pos,h)∨6(pos,h)
-            Z3_ast occ = Z3_mk_or(ctx, 2, (Z3_ast[]){tn_4_variable(ctx, pos, h), tn_6_variable(ctx, pos, h)});
-            for (int n = 0; n < N; ++n) {
-                Z3_ast nth = tn_path_variable(ctx, n, pos, h);
-                //x(n,pos,h)⇒occ(pos,h)
-                conjs[ci++] = Z3_mk_implies(ctx, nth, occ);
-            }
+    for (int h = 0; h < H; ++h) {
+        //occ(pos,h)=4(pos,h)∨6(pos,h)
+        Z3_ast occ = Z3_mk_or(ctx, 2, (Z3_ast[]){tn_4_variable(vars, pos, h), tn_6_variable(vars, pos, h)});
+        Z3_ast above = NULL;
+        if (h + 1 <= vars->max_height[pos])
+            above = Z3_mk_or(ctx, 2, (Z3_ast[]){tn_4_variable(vars, pos, h + 1), tn_6_variable(vars, pos, h + 1)});
+        for (int n = 0; n < N; ++n) {
+            if (!tn_is_alive(vars, n, pos, h)) continue;
+            Z3_ast nth = tn_path_variable(vars, n, pos, h);
+            //x(n,pos,h)⇒occ(pos,h)
+            conjs[ci++] = Z3_mk_implies(ctx, nth, occ);
+            //x(n,pos,h)⇒¬occ(pos,h+1) : h est bien le sommet
+            if (above != NULL)
+                conjs[ci++] = Z3_mk_implies(ctx, nth, Z3_mk_not(ctx, above));
         }
     }
 
@@ -333,6 +618,89 @@ Z3_ast tn_condition_occupancy(Z3_context ctx, const TunnelNetwork network, int l
     return result;
 }
 
+Z3_ast tn_condition_occupancy(Z3_context ctx, TunnelVariables vars)
+{
+    return tn_all_layers(ctx, vars, tn_layer_occupancy, 0, vars->length);
+}
+
+/**
+ * @brief
+* @param ctx The solver context.
+ * @param network.
+ * @param length la longueur du chemin.
+ * @return Z3_ast
+ * ----------------- les cases strictement sous le sommet sont recopiées de pos a pos+1 ----------
+ * ----------------- (une action ne touche que le sommet et la case juste en dessous) -------------*/
+
+static Z3_ast tn_layer_stack_frame(Z3_context ctx, TunnelVariables vars, int pos)
+{
+    int H = vars->stack_size;
+
+    Z3_ast *conjs = malloc(sizeof(Z3_ast) * H);
+    int ci = 0;
+
+    for (int k = 0; k + 1 < H && k + 1 <= vars->max_height[pos]; ++k) {
+        //occ(pos,k+1)⇒(4(pos,k)⇔4(pos+1,k))∧(6(pos,k)⇔6(pos+1,k))
+        Z3_ast occ = Z3_mk_or(ctx, 2, (Z3_ast[]){tn_4_variable(vars, pos, k + 1), tn_6_variable(vars, pos, k + 1)});
+        Z3_ast same4 = Z3_mk_iff(ctx, tn_4_variable(vars, pos, k), tn_4_variable(vars, pos + 1, k));
+        Z3_ast same6 = Z3_mk_iff(ctx, tn_6_variable(vars, pos, k), tn_6_variable(vars, pos + 1, k));
+        conjs[ci++] = Z3_mk_implies(ctx, occ, Z3_mk_and(ctx, 2, (Z3_ast[]){same4, same6}));
+    }
+
+    if (ci == 0)
+        conjs[ci++] = Z3_mk_true(ctx);
+
+    Z3_ast result = Z3_mk_and(ctx, ci, conjs);
+    free(conjs);
+    return result;
+}
+
+Z3_ast tn_condition_stack_frame(Z3_context ctx, TunnelVariables vars)
+{
+    return tn_all_layers(ctx, vars, tn_layer_stack_frame, 0, vars->length - 1);
+}
+
+/**
+ * @brief construit les cas permis pour une transition (n,pos,h) -> (.,pos+1,hp).
+ * @param cases tableau d'au moins 10 cases rempli par la fonction.
+ * @return le nombre de cas permis.
+ */
+static int tn_action_cases(Z3_context ctx, TunnelVariables vars, int n, int pos, int h, int hp, Z3_ast *cases)
+{
+    TunnelNetwork network = vars->network;
+    int H = vars->stack_size;
+    int nc = 0;
+
+    if (hp < 0 || hp >= H)
+        return 0;
+
+    // les actions de n dont la variation de hauteur est hp - h, lues dans tn_action_table
+    int mask = tn_get_actions_of_class(network, n, tn_class_of_delta(hp - h));
+    for (int action = tn_next_action(mask, 0); action < NumActions; action = tn_next_action(mask, action + 1)) {
+        const tn_action_semantics *semantics = &tn_action_table[action];
+
+        Z3_ast conj[3];
+        int k = 0;
+        // le sommet requis en (pos,h)
+        conj[k++] = tn_symbol_variable(vars, pos, h, semantics->top);
+        if (semantics->delta == 0) {
+            // transmit : le sommet est inchangé en (pos+1,h)
+            conj[k++] = tn_symbol_variable(vars, pos + 1, h, semantics->result_top);
+        } else if (semantics->delta > 0) {
+            // push : l'ancien sommet reste en (pos+1,h), le symbole empilé est en (pos+1,hp)
+            conj[k++] = tn_symbol_variable(vars, pos + 1, h, semantics->top);
+            conj[k++] = tn_symbol_variable(vars, pos + 1, hp, semantics->result_top);
+        } else {
+            // pop : le symbole requis sous le sommet en (pos,h-1) devient le sommet en (pos+1,hp)
+            conj[k++] = tn_symbol_variable(vars, pos, h - 1, semantics->second);
+            conj[k++] = tn_symbol_variable(vars, pos + 1, hp, semantics->result_top);
+        }
+        cases[nc++] = Z3_mk_and(ctx, k, conj);
+    }
+
+    return nc;
+}
+
 /**
  * @brief
 * @param ctx The solver context.
@@ -343,109 +711,66 @@ Z3_ast tn_condition_occupancy(Z3_context ctx, const TunnelNetwork network, int l
  * ------------------ Chaque action impose une relation entre :------------------------- 
  * ----------------- node courant, node suivant, hauteur, contenu de pile 
  */
-Z3_ast tn_condition_actions(Z3_context ctx, const TunnelNetwork network, int length)
+static Z3_ast tn_layer_actions(Z3_context ctx, TunnelVariables vars, int pos)
 {
-    int N = tn_get_num_nodes(network);
-    int H = get_stack_size(length);
+    TunnelNetwork network = vars->network;
+    int N = vars->num_nodes;
+    int H = vars->stack_size;
 
-    int est_upper = length * N * H * (N * H) * 2 + 1000;
-    Z3_ast *conjs = malloc(sizeof(Z3_ast) * est_upper);
+    int num_arcs = 0;
+    for (int n = 0; n < N; ++n)
+        num_arcs += tn_get_num_successors(network, n);
+
+    // une contrainte par arc, hauteur et variation de hauteur (-1, 0, +1)
+    Z3_ast *conjs = malloc(sizeof(Z3_ast) * ((size_t)H * 3 * num_arcs + 1));
     int ci = 0;
 
-    for (int pos = 0; pos < length; ++pos) {
-        for (int n = 0; n < N; ++n) {
-            for (int h = 0; h < H; ++h) {
-
-                Z3_ast cur = tn_path_variable(ctx, n, pos, h);
-
-                /* itèration sur toutes les paires (m, hp) possibles pour la position pos+1.
-                   pour chaque paire on construit une implication avec l'antécédent */
-                for (int m = 0; m < N; ++m) {
-                    for (int hp = 0; hp < H; ++hp) {
-                        Z3_ast nxt = tn_path_variable(ctx, m, pos + 1, hp);
-                        //cur(n,pos,h)∧nxt(m,pos+1,hp)
-                        Z3_ast antecedent = Z3_mk_and(ctx, 2, (Z3_ast[]){cur, nxt});
-
-                        // construire les cas permis
-                        Z3_ast cases[16];
-                        int nc = 0;
-
-                        // --- TRANSMIT (hp == h) ---
-                        if (hp == h) {
-                            if (tn_node_has_action(network, n, transmit_4)) {
-                                // pos,h == 4 && pos+1,h == 4 
-                                Z3_ast a = Z3_mk_and(ctx, 2, (Z3_ast[]){tn_4_variable(ctx, pos, h), tn_4_variable(ctx, pos + 1, h)});
-                                cases[nc++] = a;
-                            }
-                            if (tn_node_has_action(network, n, transmit_6)) {
-                                Z3_ast a = Z3_mk_and(ctx, 2, (Z3_ast[]){tn_6_variable(ctx, pos, h), tn_6_variable(ctx, pos + 1, h)});
-                                cases[nc++] = a;
-                            }
-                        }
-
-                        /* --- PUSH (hp == h + 1) --- */
-                        if (hp == h + 1 && hp < H) {
-                            // 4 possibilités (a,b) ∈ {4,6} × {4,6} */
-                            if (tn_node_has_action(network, n, push_4_4)) {
-                                // pos,h == 4 ; pos+1,h == 4 (below) ; pos+1,h+1 == 4 (new top) 
-                                Z3_ast c = Z3_mk_and(ctx, 3, (Z3_ast[]){tn_4_variable(ctx, pos, h), tn_4_variable(ctx, pos + 1, h), tn_4_variable(ctx, pos + 1, hp)});
-                                cases[nc++] = c;
-                            }
-                            if (tn_node_has_action(network, n, push_4_6)) {
-                                Z3_ast c = Z3_mk_and(ctx, 3, (Z3_ast[]){tn_4_variable(ctx, pos, h), tn_4_variable(ctx, pos + 1, h), tn_6_variable(ctx, pos + 1, hp)});
-                                cases[nc++] = c;
-                            }
-                            if (tn_node_has_action(network, n, push_6_4)) {
-                                Z3_ast c = Z3_mk_and(ctx, 3, (Z3_ast[]){tn_6_variable(ctx, pos, h), tn_4_variable(ctx, pos + 1, h), tn_4_variable(ctx, pos + 1, hp)});
-                                cases[nc++] = c;
-                            }
-                            if (tn_node_has_action(network, n, push_6_6)) {
-                                Z3_ast c = Z3_mk_and(ctx, 3, (Z3_ast[]){tn_6_variable(ctx, pos, h), tn_6_variable(ctx, pos + 1, h), tn_6_variable(ctx, pos + 1, hp)});
-                                cases[nc++] = c;
-                            }
-                        }
-
-                        // --- POP (hp == h - 1) ---
-                        if (hp + 1 == h && h >= 1) {
-                            // pop supprimme top b
-                            if (tn_node_has_action(network, n, pop_4_4)) {
-                                // top b = 4 at pos,h ; below a = 4 at pos,h-1 ; new top at pos+1,h-1 = 4 
-                                Z3_ast c = Z3_mk_and(ctx, 3, (Z3_ast[]){tn_4_variable(ctx, pos, h), tn_4_variable(ctx, pos, h - 1), tn_4_variable(ctx, pos + 1, hp)});
-                                cases[nc++] = c;
-                            }
-                            if (tn_node_has_action(network, n, pop_4_6)) {
-                                // pop_4_6 means below a=4, top b=6 
-                                Z3_ast c = Z3_mk_and(ctx, 3, (Z3_ast[]){tn_6_variable(ctx, pos, h), tn_4_variable(ctx, pos, h - 1), tn_4_variable(ctx, pos + 1, hp)});
-                                cases[nc++] = c;
-                            }
-                            if (tn_node_has_action(network, n, pop_6_4)) {
-                                Z3_ast c = Z3_mk_and(ctx, 3, (Z3_ast[]){tn_4_variable(ctx, pos, h), tn_6_variable(ctx, pos, h - 1), tn_6_variable(ctx, pos + 1, hp)});
-                                cases[nc++] = c;
-                            }
-                            if (tn_node_has_action(network, n, pop_6_6)) {
-                                Z3_ast c = Z3_mk_and(ctx, 3, (Z3_ast[]){tn_6_variable(ctx, pos, h), tn_6_variable(ctx, pos, h - 1), tn_6_variable(ctx, pos + 1, hp)});
-                                cases[nc++] = c;
-                            }
-                        }
-
-                        // Si aucune case permise -> interdire l'antécédent
-                        if (nc == 0) {
-                            conjs[ci++] = Z3_mk_not(ctx, antecedent);
-                        } else {
-                            Z3_ast disj = Z3_mk_or(ctx, nc, cases);
-                            conjs[ci++] = Z3_mk_implies(ctx, antecedent, disj);
-                        }
-                    } 
-                }     
-            }        
-        }             
-    }                 
+    for (int n = 0; n < N; ++n) {
+        int degree = tn_get_num_successors(network, n);
+        int *successors = tn_get_successors(network, n);
+        for (int h = 0; h < H; ++h) {
+            if (!tn_is_alive(vars, n, pos, h)) continue;
+
+            Z3_ast cur = tn_path_variable(vars, n, pos, h);
+
+            /* on ne parcourt que les successeurs m de n et les hauteurs voisines hp de h :
+               tn_condition_edges interdit déjà toutes les autres paires */
+            Z3_ast cases[10];
+            for (int k = 0; k < degree; ++k) {
+                int m = successors[k];
+                for (int hp = h - 1; hp <= h + 1; ++hp) {
+                    if (hp < 0 || hp >= H || !tn_has_class_for(network, n, hp - h) || !tn_is_alive(vars, m, pos + 1, hp)) continue;
+                    Z3_ast nxt = tn_path_variable(vars, m, pos + 1, hp);
+                    //cur(n,pos,h)∧nxt(m,pos+1,hp)
+                    Z3_ast antecedent = Z3_mk_and(ctx, 2, (Z3_ast[]){cur, nxt});
+
+                    int nc = tn_action_cases(ctx, vars, n, pos, h, hp, cases);
+
+                    // Si aucune case permise -> interdire l'antécédent
+                    if (nc == 0) {
+                        conjs[ci++] = Z3_mk_not(ctx, antecedent);
+                    } else {
+                        Z3_ast disj = Z3_mk_or(ctx, nc, cases);
+                        conjs[ci++] = Z3_mk_implies(ctx, antecedent, disj);
+                    }
+                }
+            }
+        }
+    }
+
+    if (ci == 0)
+        conjs[ci++] = Z3_mk_true(ctx);
 
     Z3_ast result = Z3_mk_and(ctx, ci, conjs);
     free(conjs);
     return result;
 }
 
+Z3_ast tn_condition_actions(Z3_context ctx, TunnelVariables vars)
+{
+    return tn_all_layers(ctx, vars, tn_layer_actions, 0, vars->length - 1);
+}
+
 /**
  * @brief
 * @param ctx The solver context.
@@ -456,35 +781,50 @@ Z3_ast tn_condition_actions(Z3_context ctx, const TunnelNetwork network, int len
 *-----construction complète de la formule Z3 représentant la réduction TUNNEL -> SAT. -------------------
 *------------------- -----------------------------------------------------------------------------------
  *  - initial/final
- *  - unicité
+ *  - unicité (par paires ou factorisée selon vars->encoding)
  *  - adjacency
  *  - cohérence pile (well-formed)
  *  - occupancy (si position alors cellule occupée)
+ *  - frame (cases sous le sommet inchangées)
  *  - actions (transmit/push/pop)
  */
 
-Z3_ast tn_reduction(Z3_context ctx, const TunnelNetwork network, int length)
+Z3_ast tn_reduction_with_variables(Z3_context ctx, TunnelVariables vars)
 {
-    assert(length >= 1);
+    assert(vars->length >= 1);
 
-    Z3_ast parts[6];
+    Z3_ast parts[7];
     int p = 0;
 
-    parts[p++] = tn_condition_initial_and_final(ctx, network, length);
-    parts[p++] = tn_condition_uniqueness(ctx, network, length);
-    parts[p++] = tn_condition_edges(ctx, network, length);
-    parts[p++] = tn_condition_stack_wellformed(ctx, length);
-    parts[p++] = tn_condition_occupancy(ctx, network, length);
-    parts[p++] = tn_condition_actions(ctx, network, length);
+    parts[p++] = tn_condition_initial_and_final(ctx, vars);
+    if (vars->encoding == tn_factored_encoding)
+        parts[p++] = tn_condition_uniqueness_factored(ctx, vars);
+    else
+        parts[p++] = tn_condition_uniqueness(ctx, vars);
+    parts[p++] = tn_condition_edges(ctx, vars);
+    parts[p++] = tn_condition_stack_wellformed(ctx, vars);
+    parts[p++] = tn_condition_occupancy(ctx, vars);
+    parts[p++] = tn_condition_stack_frame(ctx, vars);
+    parts[p++] = tn_condition_actions(ctx, vars);
 
     return Z3_mk_and(ctx, p, parts);
 }
 
+Z3_ast tn_reduction(Z3_context ctx, const TunnelNetwork network, int length)
+{
+    TunnelVariables vars = tn_variables_create(ctx, network, length, tn_pairwise_encoding);
+    Z3_ast result = tn_reduction_with_variables(ctx, vars);
+    tn_variables_delete(vars);
+    return result;
+}
 
-void tn_get_path_from_model(Z3_context ctx, Z3_model model, TunnelNetwork network, int bound, tn_step *path)
+/**
+ * @brief Decodes the first @p bound steps of the path described by @p model (@p bound may be smaller than the length of @p vars).
+ */
+static void tn_decode_path(Z3_context ctx, Z3_model model, TunnelVariables vars, int bound, tn_step *path)
 {
-    int num_nodes = tn_get_num_nodes(network);
-    int stack_size = get_stack_size(bound);
+    int num_nodes = vars->num_nodes;
+    int stack_size = vars->stack_size;
     for (int pos = 0; pos < bound; pos++)
     {
         int src = -1;
@@ -495,64 +835,48 @@ void tn_get_path_from_model(Z3_context ctx, Z3_model model, TunnelNetwork networ
         {
             for (int height = 0; height < stack_size; height++)
             {
-                if (value_of_var_in_model(ctx, model, tn_path_variable(ctx, n, pos, height)))
+                if (value_of_var_in_model(ctx, model, tn_path_variable(vars, n, pos, height)))
                 {
                     src = n;
                     src_height = height;
                 }
-                if (value_of_var_in_model(ctx, model, tn_path_variable(ctx, n, pos + 1, height)))
+                if (value_of_var_in_model(ctx, model, tn_path_variable(vars, n, pos + 1, height)))
                 {
                     tgt = n;
                     tgt_height = height;
                 }
             }
         }
-        int action = 0;
-        if (src_height == tgt_height)
-        {
-            if (value_of_var_in_model(ctx, model, tn_4_variable(ctx, pos, src_height)))
-                action = transmit_4;
-            else
-                action = transmit_6;
-        }
-        else if (src_height == tgt_height - 1)
-        {
-            if (value_of_var_in_model(ctx, model, tn_4_variable(ctx, pos, src_height)))
-            {
-                if (value_of_var_in_model(ctx, model, tn_4_variable(ctx, pos + 1, tgt_height)))
-                    action = push_4_4;
-                else
-                    action = push_4_6;
-            }
-            else if (value_of_var_in_model(ctx, model, tn_4_variable(ctx, pos + 1, tgt_height)))
-                action = push_6_4;
-            else
-                action = push_6_6;
-        }
-        else if (src_height == tgt_height + 1)
+        // the action is the one of tn_action_table with this height variation, this top before and this top after
+        int top = value_of_var_in_model(ctx, model, tn_4_variable(vars, pos, src_height)) ? 4 : 6;
+        int result_top = value_of_var_in_model(ctx, model, tn_4_variable(vars, pos + 1, tgt_height)) ? 4 : 6;
+        stack_action action = transmit_4;
+        for (stack_action act = 0; act < NumActions; act++)
         {
+            const tn_action_semantics *semantics = &tn_action_table[act];
+            if (semantics->delta == tgt_height - src_height && semantics->top == top && semantics->result_top == result_top)
             {
-                if (value_of_var_in_model(ctx, model, tn_4_variable(ctx, pos, src_height)))
-                {
-                    if (value_of_var_in_model(ctx, model, tn_4_variable(ctx, pos + 1, tgt_height)))
-                        action = pop_4_4;
-                    else
-                        action = pop_6_4;
-                }
-                else if (value_of_var_in_model(ctx, model, tn_4_variable(ctx, pos + 1, tgt_height)))
-                    action = pop_4_6;
-                else
-                    action = pop_6_6;
+                action = act;
+                break;
             }
         }
         path[pos] = tn_step_create(action, src, tgt);
     }
 }
 
-void tn_print_model(Z3_context ctx, Z3_model model, TunnelNetwork network, int bound)
+void tn_get_path_from_variables(Z3_context ctx, Z3_model model, TunnelVariables vars, tn_step *path)
 {
-    int num_nodes = tn_get_num_nodes(network);
-    int stack_size = get_stack_size(bound);
+    tn_decode_path(ctx, model, vars, vars->length, path);
+}
+
+/**
+ * @brief Prints the positions 0 to @p bound of @p model (@p bound may be smaller than the length of @p vars).
+ */
+static void tn_print_positions(Z3_context ctx, Z3_model model, TunnelVariables vars, int bound)
+{
+    TunnelNetwork network = vars->network;
+    int num_nodes = vars->num_nodes;
+    int stack_size = vars->stack_size;
     for (int pos = 0; pos < bound + 1; pos++)
     {
         printf("At pos %d:\nState: ", pos);
@@ -561,7 +885,7 @@ void tn_print_model(Z3_context ctx, Z3_model model, TunnelNetwork network, int b
         {
             for (int height = 0; height < stack_size; height++)
             {
-                if (value_of_var_in_model(ctx, model, tn_path_variable(ctx, node, pos, height)))
+                if (value_of_var_in_model(ctx, model, tn_path_variable(vars, node, pos, height)))
                 {
                     printf("(%s,%d) ", tn_get_node_name(network, node), height);
                     num_seen++;
@@ -579,9 +903,9 @@ void tn_print_model(Z3_context ctx, Z3_model model, TunnelNetwork network, int b
         bool above_top = false;
         for (int height = 0; height < stack_size; height++)
         {
-            if (value_of_var_in_model(ctx, model, tn_4_variable(ctx, pos, height)))
+            if (value_of_var_in_model(ctx, model, tn_4_variable(vars, pos, height)))
             {
-                if (value_of_var_in_model(ctx, model, tn_6_variable(ctx, pos, height)))
+                if (value_of_var_in_model(ctx, model, tn_6_variable(vars, pos, height)))
                 {
                     printf("|X");
                     misdefined = true;
@@ -593,7 +917,7 @@ void tn_print_model(Z3_context ctx, Z3_model model, TunnelNetwork network, int b
                         misdefined = true;
                 }
             }
-            else if (value_of_var_in_model(ctx, model, tn_6_variable(ctx, pos, height)))
+            else if (value_of_var_in_model(ctx, model, tn_6_variable(vars, pos, height)))
             {
                 printf("|6");
                 if (above_top)
@@ -610,4 +934,189 @@ void tn_print_model(Z3_context ctx, Z3_model model, TunnelNetwork network, int b
             printf("Warning: ill-defined stack\n");
     }
     return;
-}
\ No newline at end of file
+}
+
+void tn_print_model_from_variables(Z3_context ctx, Z3_model model, TunnelVariables vars)
+{
+    tn_print_positions(ctx, model, vars, vars->length);
+}
+
+void tn_get_path_from_model(Z3_context ctx, Z3_model model, TunnelNetwork network, int bound, tn_step *path)
+{
+    TunnelVariables vars = tn_variables_create(ctx, network, bound, tn_pairwise_encoding);
+    tn_get_path_from_variables(ctx, model, vars, path);
+    tn_variables_delete(vars);
+}
+
+void tn_print_model(Z3_context ctx, Z3_model model, TunnelNetwork network, int bound)
+{
+    TunnelVariables vars = tn_variables_create(ctx, network, bound, tn_pairwise_encoding);
+    tn_print_model_from_variables(ctx, model, vars);
+    tn_variables_delete(vars);
+}
+
+/**
+ * @brief A solver kept alive across lengths. The variables are created once for the largest length, so the stack has get_stack_size(bound) cells for every length (the extra cells just stay empty).
+ *
+ */
+struct TunnelIncremental_s
+{
+    TunnelVariables vars; ///< The variables, for paths of size bound.
+    Z3_solver solver;     ///< The solver, which contains the layers of the positions 0..num_positions-1.
+    int num_positions;    ///< The number of positions whose constraints have been asserted.
+    Z3_ast *guards;       ///< guards[l] implies the final condition for the length l (NULL if not created yet).
+};
+
+/**
+ * @brief Toutes les contraintes qui concernent la position pos : celles de la position elle-même, et celles de la transition pos-1 -> pos.
+ */
+static Z3_ast tn_layer_position(Z3_context ctx, TunnelVariables vars, int pos)
+{
+    Z3_ast parts[6];
+    int p = 0;
+
+    if (vars->encoding == tn_factored_encoding)
+        parts[p++] = tn_layer_uniqueness_factored(ctx, vars, pos);
+    else
+        parts[p++] = tn_layer_uniqueness(ctx, vars, pos);
+    parts[p++] = tn_layer_stack_wellformed(ctx, vars, pos);
+    parts[p++] = tn_layer_occupancy(ctx, vars, pos);
+    if (pos > 0)
+    {
+        parts[p++] = tn_layer_edges(ctx, vars, pos - 1);
+        parts[p++] = tn_layer_stack_frame(ctx, vars, pos - 1);
+        parts[p++] = tn_layer_actions(ctx, vars, pos - 1);
+    }
+
+    return Z3_mk_and(ctx, p, parts);
+}
+
+TunnelIncremental tn_incremental_create(Z3_context ctx, TunnelNetwork network, int bound, tn_encoding encoding)
+{
+    assert(bound >= 1);
+    TunnelIncremental incremental = (TunnelIncremental)malloc(sizeof(*incremental));
+    incremental->vars = tn_variables_build(ctx, network, bound, encoding, false);
+    incremental->solver = Z3_mk_solver(ctx);
+    Z3_solver_inc_ref(ctx, incremental->solver);
+    incremental->num_positions = 0;
+    incremental->guards = (Z3_ast *)calloc(bound + 1, sizeof(Z3_ast));
+
+    Z3_solver_assert(ctx, incremental->solver, tn_condition_endpoint(ctx, incremental->vars, tn_get_initial(network), 0));
+    return incremental;
+}
+
+Z3_ast tn_incremental_add_length(Z3_context ctx, TunnelIncremental incremental, int length)
+{
+    TunnelVariables vars = incremental->vars;
+    assert(length >= 1 && length <= vars->length);
+
+    Z3_ast *parts = (Z3_ast *)malloc((length + 2) * sizeof(Z3_ast));
+    int p = 0;
+    while (incremental->num_positions <= length)
+        parts[p++] = tn_layer_position(ctx, vars, incremental->num_positions++);
+
+    if (incremental->guards[length] == NULL)
+    {
+        incremental->guards[length] = Z3_mk_fresh_const(ctx, "final", Z3_mk_bool_sort(ctx));
+        Z3_ast final_form = tn_condition_endpoint(ctx, vars, tn_get_final(vars->network), length);
+        parts[p++] = Z3_mk_implies(ctx, incremental->guards[length], final_form);
+    }
+
+    Z3_ast result = (p == 0) ? Z3_mk_true(ctx) : Z3_mk_and(ctx, p, parts);
+    free(parts);
+    Z3_solver_assert(ctx, incremental->solver, result);
+    return result;
+}
+
+Z3_lbool tn_incremental_solve(Z3_context ctx, TunnelIncremental incremental, int length, Z3_model *model)
+{
+    if (incremental->num_positions <= length || incremental->guards[length] == NULL)
+        tn_incremental_add_length(ctx, incremental, length);
+
+    Z3_ast guard = incremental->guards[length];
+    Z3_lbool result = Z3_solver_check_assumptions(ctx, incremental->solver, 1, &guard);
+
+    switch (result)
+    {
+    case Z3_L_FALSE:
+        // cette longueur est impossible : on le dit au solveur pour les longueurs suivantes
+        Z3_solver_assert(ctx, incremental->solver, Z3_mk_not(ctx, guard));
+        break;
+    case Z3_L_UNDEF:
+        printf("Warning: Getting a partial model from a formula of unknown satisfiability.\n");
+        break;
+    case Z3_L_TRUE:
+        *model = Z3_solver_get_model(ctx, incremental->solver);
+        if (*model)
+            Z3_model_inc_ref(ctx, *model);
+        break;
+    }
+    return result;
+}
+
+void tn_incremental_get_path(Z3_context ctx, Z3_model model, TunnelIncremental incremental, int length, tn_step *path)
+{
+    tn_decode_path(ctx, model, incremental->vars, length, path);
+}
+
+void tn_incremental_print_model(Z3_context ctx, Z3_model model, TunnelIncremental incremental, int length)
+{
+    tn_print_positions(ctx, model, incremental->vars, length);
+}
+
+void tn_incremental_block_path(Z3_context ctx, TunnelIncremental incremental, int length, tn_step *path)
+{
+    TunnelVariables vars = incremental->vars;
+    assert(length >= 1 && length <= vars->length && incremental->guards[length] != NULL);
+
+    // la position pos du chemin est (nœud, hauteur, sommet) : la hauteur suit les deltas des actions, le sommet est celui que lit l'action suivante (ou que laisse la dernière)
+    Z3_ast *literals = (Z3_ast *)malloc(2 * (length + 1) * sizeof(Z3_ast));
+    int height = 0;
+    for (int pos = 0; pos <= length; pos++)
+    {
+        const tn_action_semantics *semantics = &tn_action_table[path[pos < length ? pos : length - 1].action];
+        int node = pos < length ? path[pos].source : path[length - 1].target;
+        int top = pos < length ? semantics->top : semantics->result_top;
+        literals[2 * pos] = Z3_mk_not(ctx, tn_path_variable(vars, node, pos, height));
+        literals[2 * pos + 1] = Z3_mk_not(ctx, tn_symbol_variable(vars, pos, height, top));
+        if (pos < length)
+            height += semantics->delta;
+    }
+
+    // la clause ne vaut que pour cette longueur : un chemin plus long peut passer par les mêmes positions
+    Z3_ast clause = Z3_mk_or(ctx, 2 * (length + 1), literals);
+    Z3_solver_assert(ctx, incremental->solver, Z3_mk_implies(ctx, incremental->guards[length], clause));
+    free(literals);
+}
+
+int tn_incremental_enumerate(Z3_context ctx, TunnelIncremental incremental, int max_paths, tn_path_callback callback, void *data)
+{
+    int bound = incremental->vars->length;
+    tn_step *path = (tn_step *)malloc((bound + 1) * sizeof(tn_step));
+    int num_paths = 0;
+    bool go_on = max_paths > 0;
+
+    for (int length = 1; length <= bound && go_on; length++)
+    {
+        Z3_model model;
+        while (go_on && tn_incremental_solve(ctx, incremental, length, &model) == Z3_L_TRUE)
+        {
+            tn_incremental_get_path(ctx, model, incremental, length, path);
+            Z3_model_dec_ref(ctx, model);
+            tn_incremental_block_path(ctx, incremental, length, path);
+            num_paths++;
+            go_on = callback(path, length, data) && num_paths < max_paths;
+        }
+    }
+
+    free(path);
+    return num_paths;
+}
+
+void tn_incremental_delete(Z3_context ctx, TunnelIncremental incremental)
+{
+    Z3_solver_dec_ref(ctx, incremental->solver);
+    tn_variables_delete(incremental->vars);
+    free(incremental->guards);
+    free(incremental);
+}
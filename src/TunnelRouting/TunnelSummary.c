@@ -0,0 +1,268 @@
+#include "TunnelSummary.h"
+#include "TunnelNetwork.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+/**
+ * @brief The summaries, as sets of target nodes (bitsets of num_words words).
+ * summaries[k][u][t] is the set of v such that (u, v, k, t) is a summary, and pops[m][u][t] is the set of y such that u pushes on the top t, a summary of size m-2 follows, and the matching pop leads to y (a "push ... pop" block of m steps).
+ * The top t is 0 for 4 and 1 for 6.
+ *
+ */
+struct TunnelSummary_s
+{
+    TunnelNetwork network; ///< The network.
+    int bound;             ///< The max size of the summaries.
+    int num_nodes;         ///< The number of nodes.
+    int num_words;         ///< The number of words of a set of nodes.
+    uint64_t *summaries;   ///< The summaries, indexed by ((k * num_nodes + u) * 2 + t) * num_words.
+    uint64_t *pops;        ///< The push-pop blocks, indexed like summaries.
+    stack_action transmit[2]; ///< transmit[t] transmits the top t.
+    stack_action push[2][2];  ///< push[t][b] pushes b on the top t.
+    stack_action pop[2][2];   ///< pop[t][b] pops the top b above t.
+};
+
+/**
+ * @brief The cell value of a top index.
+ */
+#define TOP_VALUE(t) ((t) == 0 ? 4 : 6)
+
+/**
+ * @brief Returns the set of the summaries (u, ., k, t).
+ */
+static inline uint64_t *tn_summary_set(TunnelSummary summary, uint64_t *table, int k, int u, int t)
+{
+    return table + (((size_t)k * summary->num_nodes + u) * 2 + t) * summary->num_words;
+}
+
+static inline bool tn_set_contains(uint64_t *set, int node)
+{
+    return (set[node / 64] >> (node % 64)) & 1;
+}
+
+static inline void tn_set_add(uint64_t *set, int node)
+{
+    set[node / 64] |= (uint64_t)1 << (node % 64);
+}
+
+static inline void tn_set_union(uint64_t *set, uint64_t *other, int num_words)
+{
+    for (int i = 0; i < num_words; i++)
+        set[i] |= other[i];
+}
+
+/**
+ * @brief The action of tn_action_table with height variation @p delta, required top @p top and resulting top @p result_top (tops given as 0 for 4 and 1 for 6). It is unique: a transmit keeps its top, a push is defined by its top and the pushed symbol, and a pop by its top and the symbol below.
+ */
+static stack_action tn_find_action(int delta, int top, int result_top)
+{
+    for (stack_action action = 0; action < NumActions; action++)
+    {
+        const tn_action_semantics *semantics = &tn_action_table[action];
+        if (semantics->delta == delta && semantics->top == TOP_VALUE(top) && semantics->result_top == TOP_VALUE(result_top))
+            return action;
+    }
+    printf("Erreur dans tn_find_action\n");
+    exit(EXIT_FAILURE);
+}
+
+TunnelSummary tn_summary_create(TunnelNetwork network, int bound)
+{
+    TunnelSummary summary = malloc(sizeof(*summary));
+    summary->network = network;
+    summary->bound = bound;
+    summary->num_nodes = tn_get_num_nodes(network);
+    summary->num_words = (summary->num_nodes + 63) / 64;
+    int N = summary->num_nodes;
+    int W = summary->num_words;
+    for (int t = 0; t < 2; t++)
+    {
+        summary->transmit[t] = tn_find_action(0, t, t);
+        for (int b = 0; b < 2; b++)
+        {
+            summary->push[t][b] = tn_find_action(1, t, b);
+            summary->pop[t][b] = tn_find_action(-1, b, t);
+        }
+    }
+    size_t table_size = (size_t)(bound + 1) * N * 2 * W;
+    summary->summaries = calloc(table_size, sizeof(uint64_t));
+    summary->pops = calloc(table_size, sizeof(uint64_t));
+    if (summary->summaries == NULL || summary->pops == NULL)
+    {
+        printf("Malloc failed\n");
+        exit(EXIT_FAILURE);
+    }
+
+    for (int k = 0; k <= bound; k++)
+    {
+        // push-pop blocks of k steps : push at u, summary of k-2 steps from w to x on the pushed top, pop at x
+        for (int u = 0; k >= 2 && u < N; u++)
+        {
+            if ((tn_get_action_classes(network, u) & (1 << tn_push_class)) == 0)
+                continue;
+            int *successors = tn_get_successors(network, u);
+            for (int t = 0; t < 2; t++)
+            {
+                uint64_t *block = tn_summary_set(summary, summary->pops, k, u, t);
+                for (int b = 0; b < 2; b++)
+                {
+                    if (!tn_node_has_action(network, u, summary->push[t][b]))
+                        continue;
+                    for (int i = 0; i < tn_get_num_successors(network, u); i++)
+                    {
+                        uint64_t *inner = tn_summary_set(summary, summary->summaries, k - 2, successors[i], b);
+                        for (int x = 0; x < N; x++)
+                        {
+                            if (!tn_set_contains(inner, x) || !tn_node_has_action(network, x, summary->pop[t][b]))
+                                continue;
+                            int *next = tn_get_successors(network, x);
+                            for (int j = 0; j < tn_get_num_successors(network, x); j++)
+                                tn_set_add(block, next[j]);
+                        }
+                    }
+                }
+            }
+        }
+
+        // summaries of k steps : transmit then summary of k-1 steps, or block of m steps then summary of k-m steps
+        for (int u = 0; u < N; u++)
+        {
+            int *successors = tn_get_successors(network, u);
+            for (int t = 0; t < 2; t++)
+            {
+                uint64_t *set = tn_summary_set(summary, summary->summaries, k, u, t);
+                if (k == 0)
+                {
+                    tn_set_add(set, u);
+                    continue;
+                }
+                if (tn_node_has_action(network, u, summary->transmit[t]))
+                {
+                    for (int i = 0; i < tn_get_num_successors(network, u); i++)
+                        tn_set_union(set, tn_summary_set(summary, summary->summaries, k - 1, successors[i], t), W);
+                }
+                for (int m = 2; m <= k; m++)
+                {
+                    uint64_t *block = tn_summary_set(summary, summary->pops, m, u, t);
+                    for (int y = 0; y < N; y++)
+                    {
+                        if (tn_set_contains(block, y))
+                            tn_set_union(set, tn_summary_set(summary, summary->summaries, k - m, y, t), W);
+                    }
+                }
+            }
+        }
+    }
+    return summary;
+}
+
+void tn_summary_delete(TunnelSummary summary)
+{
+    free(summary->summaries);
+    free(summary->pops);
+    free(summary);
+}
+
+bool tn_summary_has_path(TunnelSummary summary, int length)
+{
+    TunnelNetwork network = summary->network;
+    return tn_set_contains(tn_summary_set(summary, summary->summaries, length, tn_get_initial(network), 0), tn_get_final(network));
+}
+
+/**
+ * @brief Writes in @p path the steps of a path realising the summary (@p u, @p v, @p k, @p t).
+ *
+ * @pre (@p u, @p v, @p k, @p t) must be a summary.
+ */
+static void tn_summary_build(TunnelSummary summary, int u, int v, int k, int t, tn_step *path)
+{
+    TunnelNetwork network = summary->network;
+    int N = summary->num_nodes;
+
+    while (k > 0)
+    {
+        int *successors = tn_get_successors(network, u);
+        int next = -1;
+
+        // a transmit first
+        if (tn_node_has_action(network, u, summary->transmit[t]))
+        {
+            for (int i = 0; i < tn_get_num_successors(network, u) && next == -1; i++)
+            {
+                if (tn_set_contains(tn_summary_set(summary, summary->summaries, k - 1, successors[i], t), v))
+                    next = successors[i];
+            }
+        }
+        if (next != -1)
+        {
+            *(path++) = tn_step_create(summary->transmit[t], u, next);
+            u = next;
+            k--;
+            continue;
+        }
+
+        // otherwise a push-pop block of m steps
+        bool found = false;
+        for (int m = 2; m <= k && !found; m++)
+        {
+            for (int b = 0; b < 2 && !found; b++)
+            {
+                if (!tn_node_has_action(network, u, summary->push[t][b]))
+                    continue;
+                for (int i = 0; i < tn_get_num_successors(network, u) && !found; i++)
+                {
+                    int w = successors[i];
+                    uint64_t *inner = tn_summary_set(summary, summary->summaries, m - 2, w, b);
+                    for (int x = 0; x < N && !found; x++)
+                    {
+                        if (!tn_set_contains(inner, x) || !tn_node_has_action(network, x, summary->pop[t][b]))
+                            continue;
+                        int *after = tn_get_successors(network, x);
+                        for (int j = 0; j < tn_get_num_successors(network, x) && !found; j++)
+                        {
+                            int y = after[j];
+                            if (!tn_set_contains(tn_summary_set(summary, summary->summaries, k - m, y, t), v))
+                                continue;
+                            found = true;
+                            path[0] = tn_step_create(summary->push[t][b], u, w);
+                            tn_summary_build(summary, w, x, m - 2, b, path + 1);
+                            path[m - 1] = tn_step_create(summary->pop[t][b], x, y);
+                            path += m;
+                            u = y;
+                            k -= m;
+                        }
+                    }
+                }
+            }
+        }
+        if (!found)
+        {
+            printf("Erreur dans tn_summary_build\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+}
+
+void tn_summary_get_path(TunnelSummary summary, int length, tn_step *path)
+{
+    TunnelNetwork network = summary->network;
+    tn_summary_build(summary, tn_get_initial(network), tn_get_final(network), length, 0, path);
+}
+
+int tn_summary_solve(TunnelNetwork network, int length, tn_step *path)
+{
+    TunnelSummary summary = tn_summary_create(network, length);
+    int res = 0;
+    for (int l = 1; l <= length && res == 0; l++)
+    {
+        if (tn_summary_has_path(summary, l))
+        {
+            tn_summary_get_path(summary, l, path);
+            res = l;
+        }
+    }
+    tn_summary_delete(summary);
+    return res;
+}
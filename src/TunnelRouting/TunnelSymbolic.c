@@ -0,0 +1,357 @@
+#include "TunnelSymbolic.h"
+#include "TunnelNetwork.h"
+#include "TunnelStack.h"
+#include "TunnelBFS.h"
+#include "BDD.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+/**
+ * @brief The encoding of the configurations in BDD variables, and the BDDs used by every image computation.
+ * The node bits come first (most significant first), each current bit followed by the matching bit of the next node, then the height bits (most significant first, the height being the number of cells), then one bit per cell (1 for 6).
+ *
+ */
+typedef struct
+{
+    TunnelNetwork network;      ///< The network.
+    BDDManager manager;         ///< The manager of all the BDDs.
+    int num_node_bits;          ///< The number of bits of a node.
+    int num_height_bits;        ///< The number of bits of a height.
+    int capacity;               ///< The number of cells of the stacks.
+    int num_vars;               ///< The number of variables.
+    bdd edges;                  ///< The edge relation, over the current and next node bits.
+    bdd actions[NumActions];    ///< actions[a] is the set of the nodes having the action a.
+    bdd *heights;               ///< heights[h] is the set of the configurations of height h (1 to capacity).
+    bdd *cells;                 ///< cells[2c+b] is the set of the configurations whose cell c is b.
+    bdd *updates;               ///< updates[c] is the cube of the height bits and of the cell c, quantified when a push or pop changes the cell c.
+    bdd node_cube;              ///< The cube of the current node bits.
+    int renaming;               ///< The renaming of the next node bits into the current ones (and back).
+} tn_symbolic;
+
+/**
+ * @brief The statistics of the last call to tn_symbolic_solve.
+ */
+static int last_peak_nodes = 0;
+static double last_num_configurations = 0;
+
+static inline int tn_symbolic_node_var(int bit, bool next)
+{
+    return 2 * bit + next;
+}
+
+static inline int tn_symbolic_height_var(tn_symbolic *sym, int bit)
+{
+    return 2 * sym->num_node_bits + bit;
+}
+
+static inline int tn_symbolic_cell_var(tn_symbolic *sym, int cell)
+{
+    return 2 * sym->num_node_bits + sym->num_height_bits + cell;
+}
+
+/**
+ * @brief Replaces the BDD of @p target by @p value, protecting the new one and releasing the old one.
+ */
+static inline void tn_bdd_assign(BDDManager manager, bdd *target, bdd value)
+{
+    bdd_ref(manager, value);
+    bdd_deref(manager, *target);
+    *target = value;
+}
+
+/**
+ * @brief Writes in @p values the bits of @p node (as current node bits, or next node bits if @p next).
+ */
+static void tn_symbolic_write_node(tn_symbolic *sym, int node, bool next, bool *values)
+{
+    for (int bit = 0; bit < sym->num_node_bits; bit++)
+        values[tn_symbolic_node_var(bit, next)] = (node >> (sym->num_node_bits - 1 - bit)) & 1;
+}
+
+/**
+ * @brief Writes in @p values the bits of the height and of the cells of @p stack.
+ */
+static void tn_symbolic_write_stack(tn_symbolic *sym, tn_stack *stack, bool *values)
+{
+    for (int bit = 0; bit < sym->num_height_bits; bit++)
+        values[tn_symbolic_height_var(sym, bit)] = (stack->height >> (sym->num_height_bits - 1 - bit)) & 1;
+    for (int cell = 0; cell < sym->capacity; cell++)
+        values[tn_symbolic_cell_var(sym, cell)] = cell < stack->height && tn_stack_cell(stack, cell);
+}
+
+/**
+ * @brief The set containing only @p node (as current node, or next node if @p next).
+ */
+static bdd tn_symbolic_node(tn_symbolic *sym, int node, bool next)
+{
+    int vars[sym->num_node_bits];
+    bool bits[sym->num_node_bits];
+    for (int bit = 0; bit < sym->num_node_bits; bit++)
+    {
+        vars[bit] = tn_symbolic_node_var(bit, next);
+        bits[bit] = (node >> (sym->num_node_bits - 1 - bit)) & 1;
+    }
+    return bdd_literals(sym->manager, vars, bits, sym->num_node_bits);
+}
+
+/**
+ * @brief The set containing only the configuration (@p node, @p stack).
+ */
+static bdd tn_symbolic_configuration(tn_symbolic *sym, int node, tn_stack *stack)
+{
+    int num_vars = sym->num_node_bits + sym->num_height_bits + sym->capacity;
+    int vars[num_vars];
+    bool bits[num_vars];
+    bool values[sym->num_vars];
+    tn_symbolic_write_node(sym, node, false, values);
+    tn_symbolic_write_stack(sym, stack, values);
+    int n = 0;
+    for (int bit = 0; bit < sym->num_node_bits; bit++)
+        vars[n++] = tn_symbolic_node_var(bit, false);
+    for (int var = 2 * sym->num_node_bits; var < sym->num_vars; var++)
+        vars[n++] = var;
+    for (int i = 0; i < num_vars; i++)
+        bits[i] = values[vars[i]];
+    return bdd_literals(sym->manager, vars, bits, num_vars);
+}
+
+static void tn_symbolic_init(tn_symbolic *sym, TunnelNetwork network, int length)
+{
+    int num_nodes = tn_get_num_nodes(network);
+    sym->network = network;
+    // a path of size length never has more than length/2+1 cells in its stack
+    sym->capacity = length / 2 + 1;
+    sym->num_node_bits = 1;
+    while ((1 << sym->num_node_bits) < num_nodes)
+        sym->num_node_bits++;
+    sym->num_height_bits = 1;
+    while ((1 << sym->num_height_bits) <= sym->capacity)
+        sym->num_height_bits++;
+    sym->num_vars = 2 * sym->num_node_bits + sym->num_height_bits + sym->capacity;
+    BDDManager manager = bdd_manager_create(sym->num_vars);
+    sym->manager = manager;
+
+    sym->heights = malloc((sym->capacity + 1) * sizeof(bdd));
+    sym->cells = malloc(2 * sym->capacity * sizeof(bdd));
+    sym->updates = malloc(sym->capacity * sizeof(bdd));
+    if (sym->heights == NULL || sym->cells == NULL || sym->updates == NULL)
+    {
+        printf("Malloc failed\n");
+        exit(EXIT_FAILURE);
+    }
+
+    int height_vars[sym->num_height_bits + 1];
+    for (int bit = 0; bit < sym->num_height_bits; bit++)
+        height_vars[bit] = tn_symbolic_height_var(sym, bit);
+    for (int h = 1; h <= sym->capacity; h++)
+    {
+        bool bits[sym->num_height_bits];
+        for (int bit = 0; bit < sym->num_height_bits; bit++)
+            bits[bit] = (h >> (sym->num_height_bits - 1 - bit)) & 1;
+        sym->heights[h] = bdd_ref(manager, bdd_literals(manager, height_vars, bits, sym->num_height_bits));
+    }
+    for (int cell = 0; cell < sym->capacity; cell++)
+    {
+        sym->cells[2 * cell] = bdd_ref(manager, bdd_nvar(manager, tn_symbolic_cell_var(sym, cell)));
+        sym->cells[2 * cell + 1] = bdd_ref(manager, bdd_var(manager, tn_symbolic_cell_var(sym, cell)));
+        height_vars[sym->num_height_bits] = tn_symbolic_cell_var(sym, cell);
+        sym->updates[cell] = bdd_ref(manager, bdd_cube(manager, height_vars, sym->num_height_bits + 1));
+    }
+
+    int node_vars[sym->num_node_bits];
+    int map[sym->num_vars];
+    for (int var = 0; var < sym->num_vars; var++)
+        map[var] = var;
+    for (int bit = 0; bit < sym->num_node_bits; bit++)
+    {
+        node_vars[bit] = tn_symbolic_node_var(bit, false);
+        map[tn_symbolic_node_var(bit, false)] = tn_symbolic_node_var(bit, true);
+        map[tn_symbolic_node_var(bit, true)] = tn_symbolic_node_var(bit, false);
+    }
+    sym->node_cube = bdd_ref(manager, bdd_cube(manager, node_vars, sym->num_node_bits));
+    sym->renaming = bdd_new_renaming(manager, map);
+
+    // the nodes of each action, and the edges grouped by source
+    for (int action = 0; action < NumActions; action++)
+        sym->actions[action] = BDD_FALSE;
+    sym->edges = BDD_FALSE;
+    for (int node = 0; node < num_nodes; node++)
+    {
+        bdd source = bdd_ref(manager, tn_symbolic_node(sym, node, false));
+        int mask = tn_get_actions(network, node);
+        for (int action = tn_next_action(mask, 0); action < NumActions; action = tn_next_action(mask, action + 1))
+            tn_bdd_assign(manager, &sym->actions[action], bdd_or(manager, sym->actions[action], source));
+
+        bdd targets = BDD_FALSE;
+        int *successors = tn_get_successors(network, node);
+        for (int i = 0; i < tn_get_num_successors(network, node); i++)
+            tn_bdd_assign(manager, &targets, bdd_or(manager, targets, tn_symbolic_node(sym, successors[i], true)));
+        bdd arcs = bdd_ref(manager, bdd_and(manager, source, targets));
+        tn_bdd_assign(manager, &sym->edges, bdd_or(manager, sym->edges, arcs));
+        bdd_deref(manager, arcs);
+        bdd_deref(manager, targets);
+        bdd_deref(manager, source);
+    }
+}
+
+static void tn_symbolic_free(tn_symbolic *sym)
+{
+    bdd_manager_delete(sym->manager);
+    free(sym->heights);
+    free(sym->cells);
+    free(sym->updates);
+}
+
+/**
+ * @brief Computes the configurations reached in one step from the ones of @p layer, reached in @p depth steps, whose stack can still be emptied in the @p length - @p depth - 1 steps left.
+ *
+ * @return bdd The image, protected.
+ */
+static bdd tn_symbolic_image(tn_symbolic *sym, bdd layer, int depth, int length)
+{
+    BDDManager manager = sym->manager;
+    bdd updated = BDD_FALSE;
+    bdd x = BDD_FALSE;
+    bdd at_height = BDD_FALSE;
+
+    // the stacks are updated height by height, the cell read and written being known
+    for (int h = 1; h <= sym->capacity; h++)
+    {
+        tn_bdd_assign(manager, &at_height, bdd_and(manager, layer, sym->heights[h]));
+        if (at_height == BDD_FALSE)
+            continue;
+        for (int action = 0; action < NumActions; action++)
+        {
+            const tn_action_semantics *semantics = &tn_action_table[action];
+            int new_height = h + semantics->delta;
+            // the cells above the bottom must all be popped in the remaining steps
+            if (sym->actions[action] == BDD_FALSE || new_height < 1 || new_height > sym->capacity || new_height - 1 > length - (depth + 1))
+                continue;
+
+            tn_bdd_assign(manager, &x, bdd_and(manager, at_height, sym->actions[action]));
+            tn_bdd_assign(manager, &x, bdd_and(manager, x, sym->cells[2 * (h - 1) + tn_stack_bit(semantics->top)]));
+            if (semantics->delta < 0)
+                tn_bdd_assign(manager, &x, bdd_and(manager, x, sym->cells[2 * (h - 2) + tn_stack_bit(semantics->second)]));
+            if (x == BDD_FALSE)
+                continue;
+            if (semantics->delta != 0)
+            {
+                // a push writes the cell h, a pop clears the cell h-1
+                int cell = semantics->delta > 0 ? h : h - 1;
+                int bit = semantics->delta > 0 ? tn_stack_bit(semantics->result_top) : 0;
+                tn_bdd_assign(manager, &x, bdd_exists(manager, x, sym->updates[cell]));
+                tn_bdd_assign(manager, &x, bdd_and(manager, x, sym->heights[new_height]));
+                tn_bdd_assign(manager, &x, bdd_and(manager, x, sym->cells[2 * cell + bit]));
+            }
+            tn_bdd_assign(manager, &updated, bdd_or(manager, updated, x));
+        }
+    }
+    bdd_deref(manager, x);
+    bdd_deref(manager, at_height);
+
+    // then the nodes follow the edges
+    bdd moved = bdd_ref(manager, bdd_and_exists(manager, updated, sym->edges, sym->node_cube));
+    bdd_deref(manager, updated);
+    bdd image = bdd_ref(manager, bdd_replace(manager, moved, sym->renaming));
+    bdd_deref(manager, moved);
+    return image;
+}
+
+int tn_symbolic_solve(TunnelNetwork network, int length, tn_step *path)
+{
+    int initial = tn_get_initial(network);
+    int final = tn_get_final(network);
+    if (initial == final)
+    {
+        last_peak_nodes = 0;
+        last_num_configurations = 0;
+        return tn_bfs(network, length, path);
+    }
+
+    tn_symbolic sym;
+    tn_symbolic_init(&sym, network, length);
+    BDDManager manager = sym.manager;
+
+    tn_stack stack;
+    tn_stack_init(&stack, sym.capacity);
+    bdd target = bdd_ref(manager, tn_symbolic_configuration(&sym, final, &stack));
+    bdd *layers = malloc((length + 1) * sizeof(bdd));
+    if (layers == NULL)
+    {
+        printf("Malloc failed\n");
+        exit(EXIT_FAILURE);
+    }
+    layers[0] = bdd_ref(manager, tn_symbolic_configuration(&sym, initial, &stack));
+    bdd reached = bdd_ref(manager, layers[0]);
+
+    // layer k holds the configurations first reached after k steps
+    int res = 0;
+    int num_layers = 1;
+    for (int depth = 0; depth < length && res == 0; depth++)
+    {
+        bdd image = tn_symbolic_image(&sym, layers[depth], depth, length);
+        bdd layer = bdd_ref(manager, bdd_diff(manager, image, reached));
+        bdd_deref(manager, image);
+        if (layer == BDD_FALSE)
+        {
+            bdd_deref(manager, layer);
+            break;
+        }
+        layers[num_layers++] = layer;
+        tn_bdd_assign(manager, &reached, bdd_or(manager, reached, layer));
+        if (bdd_and(manager, layer, target) != BDD_FALSE)
+            res = depth + 1;
+    }
+
+    if (res > 0)
+    {
+        // each configuration of a layer comes from one of the previous layer
+        bool values[sym.num_vars];
+        memset(values, 0, sizeof(values));
+        tn_stack previous;
+        tn_stack_init(&previous, sym.capacity);
+        int node = final;
+        for (int step = res - 1; step >= 0; step--)
+        {
+            int *predecessors = tn_get_predecessors(network, node);
+            bool found = false;
+            for (int i = 0; i < tn_get_num_predecessors(network, node) && !found; i++)
+            {
+                int mask = tn_get_actions(network, predecessors[i]);
+                for (int action = tn_next_action(mask, 0); action < NumActions && !found; action = tn_next_action(mask, action + 1))
+                {
+                    tn_stack_copy(&previous, &stack);
+                    if (!tn_stack_unapply(&previous, action))
+                        continue;
+                    tn_symbolic_write_node(&sym, predecessors[i], false, values);
+                    tn_symbolic_write_stack(&sym, &previous, values);
+                    if (!bdd_eval(manager, layers[step], values))
+                        continue;
+                    path[step] = tn_step_create(action, predecessors[i], node);
+                    node = predecessors[i];
+                    tn_stack_copy(&stack, &previous);
+                    found = true;
+                }
+            }
+        }
+        tn_stack_free(&previous);
+    }
+
+    last_peak_nodes = bdd_get_peak_nodes(manager);
+    last_num_configurations = bdd_sat_count(manager, reached, 0, sym.num_vars);
+    // the next node bits are free in the sets of configurations
+    for (int bit = 0; bit < sym.num_node_bits; bit++)
+        last_num_configurations /= 2;
+
+    tn_stack_free(&stack);
+    free(layers);
+    tn_symbolic_free(&sym);
+    return res;
+}
+
+void tn_symbolic_get_stats(int *peak_nodes, double *num_configurations)
+{
+    *peak_nodes = last_peak_nodes;
+    *num_configurations = last_num_configurations;
+}
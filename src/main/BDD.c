@@ -0,0 +1,613 @@
+#include "BDD.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+
+/**
+ * @brief A node of a BDD: if var is true, the function is high, otherwise low. The terminals have the variable num_vars.
+ *
+ */
+typedef struct
+{
+    int var;  ///< The variable tested (-1 for a free node).
+    int low;  ///< The node for var false.
+    int high; ///< The node for var true.
+    int next; ///< The next node of the same bucket of the unique table, or of the free list.
+    int ref;  ///< The number of protections given by bdd_ref.
+} bdd_node;
+
+/**
+ * @brief An entry of the computed cache: the result of the operation op on a, b and c.
+ *
+ */
+typedef struct
+{
+    int op; ///< The operation (0 for an empty entry).
+    int a;
+    int b;
+    int c;
+    int result;
+} bdd_cache_entry;
+
+/**
+ * @brief The operations remembered in the computed cache.
+ *
+ */
+enum
+{
+    bdd_op_ite = 1,
+    bdd_op_exists,
+    bdd_op_and_exists,
+    bdd_op_replace
+};
+
+struct BDDManager_s
+{
+    int num_vars;             ///< The number of variables.
+    bdd_node *nodes;          ///< The nodes, 0 and 1 being the terminals.
+    int capacity;             ///< The allocated number of nodes.
+    int free_list;            ///< The first free node (-1 if none).
+    int num_nodes;            ///< The number of nodes in use.
+    int peak_nodes;           ///< The largest number of nodes in use.
+    int *buckets;             ///< The unique table: the first node of each bucket (-1 if empty).
+    int num_buckets;          ///< The number of buckets (a power of 2).
+    bdd_cache_entry *cache;   ///< The computed cache, direct mapped.
+    int cache_size;           ///< The number of entries of the cache (a power of 2).
+    int **renamings;          ///< The renamings registered by bdd_new_renaming.
+    int num_renamings;        ///< The number of renamings.
+    int gc_threshold;         ///< The number of nodes in use above which the next operation starts with a garbage collection.
+    int num_gc;               ///< The number of garbage collections done.
+};
+
+static void *bdd_malloc(size_t size)
+{
+    void *result = malloc(size);
+    if (result == NULL)
+    {
+        printf("Malloc failed\n");
+        exit(EXIT_FAILURE);
+    }
+    return result;
+}
+
+static inline unsigned bdd_hash3(int a, int b, int c)
+{
+    uint64_t h = (uint64_t)(unsigned)a * 0x9e3779b97f4a7c15ULL;
+    h ^= (uint64_t)(unsigned)b * 0xc2b2ae3d27d4eb4fULL;
+    h ^= (uint64_t)(unsigned)c * 0x165667b19e3779f9ULL;
+    return (unsigned)(h ^ (h >> 29));
+}
+
+static inline int bdd_top(BDDManager manager, bdd f)
+{
+    return manager->nodes[f].var;
+}
+
+/**
+ * @brief Rebuilds the unique table with @p num_buckets buckets.
+ */
+static void bdd_rehash(BDDManager manager, int num_buckets)
+{
+    free(manager->buckets);
+    manager->num_buckets = num_buckets;
+    manager->buckets = bdd_malloc(num_buckets * sizeof(int));
+    memset(manager->buckets, -1, num_buckets * sizeof(int));
+    for (int n = 2; n < manager->capacity; n++)
+    {
+        bdd_node *node = &manager->nodes[n];
+        if (node->var < 0)
+            continue;
+        unsigned b = bdd_hash3(node->var, node->low, node->high) & (num_buckets - 1);
+        node->next = manager->buckets[b];
+        manager->buckets[b] = n;
+    }
+}
+
+/**
+ * @brief Returns the node (@p var, @p low, @p high), creating it if it does not exist yet. The node is not created if @p low and @p high are the same (the test would be useless).
+ */
+static bdd bdd_make(BDDManager manager, int var, bdd low, bdd high)
+{
+    if (low == high)
+        return low;
+
+    unsigned b = bdd_hash3(var, low, high) & (manager->num_buckets - 1);
+    for (int n = manager->buckets[b]; n != -1; n = manager->nodes[n].next)
+    {
+        bdd_node *node = &manager->nodes[n];
+        if (node->var == var && node->low == low && node->high == high)
+            return n;
+    }
+
+    if (manager->free_list == -1)
+    {
+        // the nodes are only moved here, no pointer to them is kept across a call
+        int old_capacity = manager->capacity;
+        manager->capacity *= 2;
+        manager->nodes = realloc(manager->nodes, manager->capacity * sizeof(bdd_node));
+        if (manager->nodes == NULL)
+        {
+            printf("Malloc failed\n");
+            exit(EXIT_FAILURE);
+        }
+        for (int n = manager->capacity - 1; n >= old_capacity; n--)
+        {
+            manager->nodes[n].var = -1;
+            manager->nodes[n].next = manager->free_list;
+            manager->free_list = n;
+        }
+        bdd_rehash(manager, manager->num_buckets * 2);
+        b = bdd_hash3(var, low, high) & (manager->num_buckets - 1);
+    }
+
+    int n = manager->free_list;
+    manager->free_list = manager->nodes[n].next;
+    manager->nodes[n].var = var;
+    manager->nodes[n].low = low;
+    manager->nodes[n].high = high;
+    manager->nodes[n].ref = 0;
+    manager->nodes[n].next = manager->buckets[b];
+    manager->buckets[b] = n;
+    manager->num_nodes++;
+    if (manager->num_nodes > manager->peak_nodes)
+        manager->peak_nodes = manager->num_nodes;
+    return n;
+}
+
+BDDManager bdd_manager_create(int num_vars)
+{
+    BDDManager manager = bdd_malloc(sizeof(*manager));
+    manager->num_vars = num_vars;
+    manager->capacity = 1 << 12;
+    manager->nodes = bdd_malloc(manager->capacity * sizeof(bdd_node));
+    manager->free_list = -1;
+    for (int n = manager->capacity - 1; n >= 2; n--)
+    {
+        manager->nodes[n].var = -1;
+        manager->nodes[n].next = manager->free_list;
+        manager->free_list = n;
+    }
+    for (int n = 0; n < 2; n++)
+    {
+        manager->nodes[n].var = num_vars;
+        manager->nodes[n].low = n;
+        manager->nodes[n].high = n;
+        manager->nodes[n].next = -1;
+        manager->nodes[n].ref = 1;
+    }
+    manager->num_nodes = 2;
+    manager->peak_nodes = 2;
+    manager->buckets = NULL;
+    bdd_rehash(manager, manager->capacity);
+    manager->cache_size = 1 << 16;
+    manager->cache = calloc(manager->cache_size, sizeof(bdd_cache_entry));
+    if (manager->cache == NULL)
+    {
+        printf("Malloc failed\n");
+        exit(EXIT_FAILURE);
+    }
+    manager->renamings = NULL;
+    manager->num_renamings = 0;
+    manager->gc_threshold = 1 << 16;
+    manager->num_gc = 0;
+    return manager;
+}
+
+void bdd_manager_delete(BDDManager manager)
+{
+    for (int i = 0; i < manager->num_renamings; i++)
+        free(manager->renamings[i]);
+    free(manager->renamings);
+    free(manager->nodes);
+    free(manager->buckets);
+    free(manager->cache);
+    free(manager);
+}
+
+bdd bdd_ref(BDDManager manager, bdd f)
+{
+    manager->nodes[f].ref++;
+    return f;
+}
+
+void bdd_deref(BDDManager manager, bdd f)
+{
+    manager->nodes[f].ref--;
+}
+
+/**
+ * @brief Marks the nodes reachable from @p f, by setting their field next to -2 (the chains are not used while collecting).
+ */
+static void bdd_mark(BDDManager manager, bdd f)
+{
+    while (f >= 2 && manager->nodes[f].next >= 0)
+    {
+        manager->nodes[f].next = -2;
+        bdd_mark(manager, manager->nodes[f].low);
+        f = manager->nodes[f].high;
+    }
+}
+
+void bdd_gc(BDDManager manager)
+{
+    // the chains of the unique table are rebuilt afterwards, so their field next can hold the marks
+    for (int n = 2; n < manager->capacity; n++)
+        if (manager->nodes[n].var >= 0)
+            manager->nodes[n].next = 0;
+    for (int n = 2; n < manager->capacity; n++)
+        if (manager->nodes[n].var >= 0 && manager->nodes[n].ref > 0)
+            bdd_mark(manager, n);
+
+    manager->free_list = -1;
+    manager->num_nodes = 2;
+    for (int n = manager->capacity - 1; n >= 2; n--)
+    {
+        bdd_node *node = &manager->nodes[n];
+        if (node->var >= 0 && node->next == -2)
+        {
+            manager->num_nodes++;
+            continue;
+        }
+        node->var = -1;
+        node->next = manager->free_list;
+        manager->free_list = n;
+    }
+    bdd_rehash(manager, manager->num_buckets);
+    memset(manager->cache, 0, manager->cache_size * sizeof(bdd_cache_entry));
+    manager->num_gc++;
+}
+
+/**
+ * @brief Collects the garbage if many nodes were created since the last collection, @p a, @p b and @p c (the arguments of the operation starting) being kept.
+ */
+static void bdd_check_gc(BDDManager manager, bdd a, bdd b, bdd c)
+{
+    if (manager->num_nodes < manager->gc_threshold)
+        return;
+    manager->nodes[a].ref++;
+    manager->nodes[b].ref++;
+    manager->nodes[c].ref++;
+    bdd_gc(manager);
+    manager->nodes[a].ref--;
+    manager->nodes[b].ref--;
+    manager->nodes[c].ref--;
+    // if most nodes are still in use, the next collection waits for the table to grow
+    if (2 * manager->num_nodes > manager->gc_threshold)
+        manager->gc_threshold *= 2;
+}
+
+int bdd_get_num_nodes(BDDManager manager)
+{
+    return manager->num_nodes;
+}
+
+int bdd_get_peak_nodes(BDDManager manager)
+{
+    return manager->peak_nodes;
+}
+
+int bdd_get_num_gc(BDDManager manager)
+{
+    return manager->num_gc;
+}
+
+/**
+ * @brief Looks up the result of (@p op, @p a, @p b, @p c) in the cache.
+ *
+ * @return int The result, or -1 if it is not in the cache.
+ */
+static inline int bdd_cache_lookup(BDDManager manager, int op, int a, int b, int c)
+{
+    bdd_cache_entry *entry = &manager->cache[(bdd_hash3(a, b, c) + op) & (manager->cache_size - 1)];
+    if (entry->op == op && entry->a == a && entry->b == b && entry->c == c)
+        return entry->result;
+    return -1;
+}
+
+static inline void bdd_cache_insert(BDDManager manager, int op, int a, int b, int c, int result)
+{
+    bdd_cache_entry *entry = &manager->cache[(bdd_hash3(a, b, c) + op) & (manager->cache_size - 1)];
+    entry->op = op;
+    entry->a = a;
+    entry->b = b;
+    entry->c = c;
+    entry->result = result;
+}
+
+/**
+ * @brief The cofactor of @p f for the variable @p var set to @p value (@p var being at or above the top of @p f).
+ */
+static inline bdd bdd_cofactor(BDDManager manager, bdd f, int var, bool value)
+{
+    if (manager->nodes[f].var != var)
+        return f;
+    return value ? manager->nodes[f].high : manager->nodes[f].low;
+}
+
+static bdd bdd_ite_rec(BDDManager manager, bdd f, bdd g, bdd h)
+{
+    if (f == BDD_TRUE)
+        return g;
+    if (f == BDD_FALSE)
+        return h;
+    if (g == h)
+        return g;
+    if (g == BDD_TRUE && h == BDD_FALSE)
+        return f;
+
+    int result = bdd_cache_lookup(manager, bdd_op_ite, f, g, h);
+    if (result >= 0)
+        return result;
+
+    int var = bdd_top(manager, f);
+    if (bdd_top(manager, g) < var)
+        var = bdd_top(manager, g);
+    if (bdd_top(manager, h) < var)
+        var = bdd_top(manager, h);
+    bdd low = bdd_ite_rec(manager, bdd_cofactor(manager, f, var, false), bdd_cofactor(manager, g, var, false), bdd_cofactor(manager, h, var, false));
+    bdd high = bdd_ite_rec(manager, bdd_cofactor(manager, f, var, true), bdd_cofactor(manager, g, var, true), bdd_cofactor(manager, h, var, true));
+    result = bdd_make(manager, var, low, high);
+
+    bdd_cache_insert(manager, bdd_op_ite, f, g, h, result);
+    return result;
+}
+
+bdd bdd_var(BDDManager manager, int var)
+{
+    bdd_check_gc(manager, BDD_FALSE, BDD_FALSE, BDD_FALSE);
+    return bdd_make(manager, var, BDD_FALSE, BDD_TRUE);
+}
+
+bdd bdd_nvar(BDDManager manager, int var)
+{
+    bdd_check_gc(manager, BDD_FALSE, BDD_FALSE, BDD_FALSE);
+    return bdd_make(manager, var, BDD_TRUE, BDD_FALSE);
+}
+
+bdd bdd_ite(BDDManager manager, bdd f, bdd g, bdd h)
+{
+    bdd_check_gc(manager, f, g, h);
+    return bdd_ite_rec(manager, f, g, h);
+}
+
+bdd bdd_not(BDDManager manager, bdd f)
+{
+    return bdd_ite(manager, f, BDD_FALSE, BDD_TRUE);
+}
+
+bdd bdd_and(BDDManager manager, bdd f, bdd g)
+{
+    return bdd_ite(manager, f, g, BDD_FALSE);
+}
+
+bdd bdd_or(BDDManager manager, bdd f, bdd g)
+{
+    return bdd_ite(manager, f, BDD_TRUE, g);
+}
+
+bdd bdd_diff(BDDManager manager, bdd f, bdd g)
+{
+    bdd_check_gc(manager, f, g, BDD_FALSE);
+    bdd not_g = bdd_ite_rec(manager, g, BDD_FALSE, BDD_TRUE);
+    return bdd_ite_rec(manager, f, not_g, BDD_FALSE);
+}
+
+bdd bdd_cube(BDDManager manager, int *vars, int num_vars)
+{
+    bdd_check_gc(manager, BDD_FALSE, BDD_FALSE, BDD_FALSE);
+    bdd result = BDD_TRUE;
+    for (int i = 0; i < num_vars; i++)
+        result = bdd_ite_rec(manager, bdd_make(manager, vars[i], BDD_FALSE, BDD_TRUE), result, BDD_FALSE);
+    return result;
+}
+
+bdd bdd_literals(BDDManager manager, int *vars, bool *values, int num_vars)
+{
+    bdd_check_gc(manager, BDD_FALSE, BDD_FALSE, BDD_FALSE);
+    bdd result = BDD_TRUE;
+    for (int i = 0; i < num_vars; i++)
+    {
+        bdd literal = values[i] ? bdd_make(manager, vars[i], BDD_FALSE, BDD_TRUE) : bdd_make(manager, vars[i], BDD_TRUE, BDD_FALSE);
+        result = bdd_ite_rec(manager, literal, result, BDD_FALSE);
+    }
+    return result;
+}
+
+static bdd bdd_exists_rec(BDDManager manager, bdd f, bdd cube)
+{
+    // the variables of the cube above f do not matter
+    while (cube != BDD_TRUE && bdd_top(manager, cube) < bdd_top(manager, f))
+        cube = manager->nodes[cube].high;
+    if (f < 2 || cube == BDD_TRUE)
+        return f;
+
+    int result = bdd_cache_lookup(manager, bdd_op_exists, f, cube, 0);
+    if (result >= 0)
+        return result;
+
+    int var = bdd_top(manager, f);
+    if (bdd_top(manager, cube) == var)
+    {
+        bdd next = manager->nodes[cube].high;
+        bdd low = bdd_exists_rec(manager, manager->nodes[f].low, next);
+        result = low == BDD_TRUE ? BDD_TRUE : bdd_ite_rec(manager, low, BDD_TRUE, bdd_exists_rec(manager, manager->nodes[f].high, next));
+    }
+    else
+    {
+        bdd low = bdd_exists_rec(manager, manager->nodes[f].low, cube);
+        bdd high = bdd_exists_rec(manager, manager->nodes[f].high, cube);
+        result = bdd_make(manager, var, low, high);
+    }
+
+    bdd_cache_insert(manager, bdd_op_exists, f, cube, 0, result);
+    return result;
+}
+
+bdd bdd_exists(BDDManager manager, bdd f, bdd cube)
+{
+    bdd_check_gc(manager, f, cube, BDD_FALSE);
+    return bdd_exists_rec(manager, f, cube);
+}
+
+static bdd bdd_and_exists_rec(BDDManager manager, bdd f, bdd g, bdd cube)
+{
+    if (f == BDD_FALSE || g == BDD_FALSE)
+        return BDD_FALSE;
+    if (f == BDD_TRUE && g == BDD_TRUE)
+        return BDD_TRUE;
+    if (f == BDD_TRUE || f == g)
+        return bdd_exists_rec(manager, g, cube);
+    if (g == BDD_TRUE)
+        return bdd_exists_rec(manager, f, cube);
+    // the conjunction is commutative, the cache sees a single order
+    if (f > g)
+    {
+        bdd tmp = f;
+        f = g;
+        g = tmp;
+    }
+
+    int var = bdd_top(manager, f);
+    if (bdd_top(manager, g) < var)
+        var = bdd_top(manager, g);
+    while (cube != BDD_TRUE && bdd_top(manager, cube) < var)
+        cube = manager->nodes[cube].high;
+    if (cube == BDD_TRUE)
+        return bdd_ite_rec(manager, f, g, BDD_FALSE);
+
+    int result = bdd_cache_lookup(manager, bdd_op_and_exists, f, g, cube);
+    if (result >= 0)
+        return result;
+
+    bdd f0 = bdd_cofactor(manager, f, var, false);
+    bdd f1 = bdd_cofactor(manager, f, var, true);
+    bdd g0 = bdd_cofactor(manager, g, var, false);
+    bdd g1 = bdd_cofactor(manager, g, var, true);
+    if (bdd_top(manager, cube) == var)
+    {
+        bdd next = manager->nodes[cube].high;
+        bdd low = bdd_and_exists_rec(manager, f0, g0, next);
+        result = low == BDD_TRUE ? BDD_TRUE : bdd_ite_rec(manager, low, BDD_TRUE, bdd_and_exists_rec(manager, f1, g1, next));
+    }
+    else
+    {
+        bdd low = bdd_and_exists_rec(manager, f0, g0, cube);
+        bdd high = bdd_and_exists_rec(manager, f1, g1, cube);
+        result = bdd_make(manager, var, low, high);
+    }
+
+    bdd_cache_insert(manager, bdd_op_and_exists, f, g, cube, result);
+    return result;
+}
+
+bdd bdd_and_exists(BDDManager manager, bdd f, bdd g, bdd cube)
+{
+    bdd_check_gc(manager, f, g, cube);
+    return bdd_and_exists_rec(manager, f, g, cube);
+}
+
+int bdd_new_renaming(BDDManager manager, int *map)
+{
+    manager->renamings = realloc(manager->renamings, (manager->num_renamings + 1) * sizeof(int *));
+    if (manager->renamings == NULL)
+    {
+        printf("Malloc failed\n");
+        exit(EXIT_FAILURE);
+    }
+    int *copy = bdd_malloc(manager->num_vars * sizeof(int));
+    memcpy(copy, map, manager->num_vars * sizeof(int));
+    manager->renamings[manager->num_renamings] = copy;
+    return manager->num_renamings++;
+}
+
+static bdd bdd_replace_rec(BDDManager manager, bdd f, int renaming)
+{
+    if (f < 2)
+        return f;
+
+    int result = bdd_cache_lookup(manager, bdd_op_replace, f, renaming, 0);
+    if (result >= 0)
+        return result;
+
+    bdd low = bdd_replace_rec(manager, manager->nodes[f].low, renaming);
+    bdd high = bdd_replace_rec(manager, manager->nodes[f].high, renaming);
+    // the renamed variable may not be above the ones of low and high any more, ite puts it at its place
+    bdd var = bdd_make(manager, manager->renamings[renaming][bdd_top(manager, f)], BDD_FALSE, BDD_TRUE);
+    result = bdd_ite_rec(manager, var, high, low);
+
+    bdd_cache_insert(manager, bdd_op_replace, f, renaming, 0, result);
+    return result;
+}
+
+bdd bdd_replace(BDDManager manager, bdd f, int renaming)
+{
+    bdd_check_gc(manager, f, BDD_FALSE, BDD_FALSE);
+    return bdd_replace_rec(manager, f, renaming);
+}
+
+bool bdd_pick_one(BDDManager manager, bdd f, bool *values)
+{
+    if (f == BDD_FALSE)
+        return false;
+    memset(values, 0, manager->num_vars * sizeof(bool));
+    while (f != BDD_TRUE)
+    {
+        // a node is never false as a whole, so one of its children leads to true
+        bdd_node *node = &manager->nodes[f];
+        if (node->low != BDD_FALSE)
+            f = node->low;
+        else
+        {
+            values[node->var] = true;
+            f = node->high;
+        }
+    }
+    return true;
+}
+
+bool bdd_eval(BDDManager manager, bdd f, bool *values)
+{
+    while (f >= 2)
+        f = values[manager->nodes[f].var] ? manager->nodes[f].high : manager->nodes[f].low;
+    return f == BDD_TRUE;
+}
+
+/**
+ * @brief 2 to the power @p n, as a double (@p n may exceed 63).
+ */
+static double bdd_pow2(int n)
+{
+    double result = 1;
+    for (int i = 0; i < n; i++)
+        result *= 2;
+    return result;
+}
+
+static double bdd_sat_count_rec(BDDManager manager, bdd f, int end, double *memo)
+{
+    if (f < 2)
+        return f;
+    if (memo[f] >= 0)
+        return memo[f];
+    bdd_node *node = &manager->nodes[f];
+    int low_var = node->low < 2 ? end : bdd_top(manager, node->low);
+    int high_var = node->high < 2 ? end : bdd_top(manager, node->high);
+    double low = bdd_sat_count_rec(manager, node->low, end, memo);
+    double high = bdd_sat_count_rec(manager, node->high, end, memo);
+    // the variables skipped between a node and its child can take both values
+    memo[f] = low * bdd_pow2(low_var - node->var - 1) + high * bdd_pow2(high_var - node->var - 1);
+    return memo[f];
+}
+
+double bdd_sat_count(BDDManager manager, bdd f, int first_var, int num_vars)
+{
+    int end = first_var + num_vars;
+    int top = f < 2 ? end : bdd_top(manager, f);
+    double *memo = bdd_malloc(manager->capacity * sizeof(double));
+    for (int n = 0; n < manager->capacity; n++)
+        memo[n] = -1;
+    double result = bdd_sat_count_rec(manager, f, end, memo) * bdd_pow2(top - first_var);
+    free(memo);
+    return result;
+}
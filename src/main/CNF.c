@@ -0,0 +1,80 @@
+#include "CNF.h"
+#include <stdlib.h>
+#include <stdio.h>
+
+SatSolver cnf_create_solver(void)
+{
+    SatSolver solver = sat_create();
+    int constant = sat_new_var(solver);
+    sat_add_clause(solver, &constant, 1);
+    return solver;
+}
+
+void cnf_add_binary(SatSolver solver, int a, int b)
+{
+    int clause[2] = {a, b};
+    sat_add_clause(solver, clause, 2);
+}
+
+void cnf_add_ternary(SatSolver solver, int a, int b, int c)
+{
+    int clause[3] = {a, b, c};
+    sat_add_clause(solver, clause, 3);
+}
+
+void cnf_add_implies(SatSolver solver, const int *premises, int num_premises, const int *conclusions, int num_conclusions)
+{
+    int size = num_premises + num_conclusions;
+    int small[16];
+    int *clause = size <= 16 ? small : malloc(size * sizeof(int));
+    if (clause == NULL)
+    {
+        printf("Malloc failed\n");
+        exit(EXIT_FAILURE);
+    }
+    for (int i = 0; i < num_premises; i++)
+        clause[i] = -premises[i];
+    for (int i = 0; i < num_conclusions; i++)
+        clause[num_premises + i] = conclusions[i];
+    sat_add_clause(solver, clause, size);
+    if (clause != small)
+        free(clause);
+}
+
+void cnf_at_most_one(SatSolver solver, const int *lits, int size)
+{
+    for (int i = 0; i < size; i++)
+        for (int j = i + 1; j < size; j++)
+            cnf_add_binary(solver, -lits[i], -lits[j]);
+}
+
+void cnf_unique(SatSolver solver, const int *lits, int size)
+{
+    sat_add_clause(solver, lits, size);
+    cnf_at_most_one(solver, lits, size);
+}
+
+void cnf_at_most_one_sequential(SatSolver solver, const int *lits, int size)
+{
+    // counter is true iff one of lits[0..i] is true
+    int previous = 0;
+    for (int i = 0; i < size; i++)
+    {
+        int counter = (i < size - 1) ? sat_new_var(solver) : 0;
+        if (counter != 0)
+            cnf_add_binary(solver, -lits[i], counter);
+        if (previous != 0)
+        {
+            cnf_add_binary(solver, -lits[i], -previous);
+            if (counter != 0)
+                cnf_add_binary(solver, -previous, counter);
+        }
+        previous = counter;
+    }
+}
+
+void cnf_unique_sequential(SatSolver solver, const int *lits, int size)
+{
+    sat_add_clause(solver, lits, size);
+    cnf_at_most_one_sequential(solver, lits, size);
+}
@@ -15,6 +15,11 @@
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
+#include <stdint.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 parameterList *parameter_list_add_parameter(parameterList *list, char *name, char *value)
 {
@@ -92,10 +97,9 @@ void graph_print(Graph graph)
 	printf("\nEdges:\n");
 	for (int i = 0; i < graph.numNodes; i++)
 	{
-		for (int j = 0; j < graph.numNodes; j++)
-		{
-			printf("%d ", graph.edges[i * graph.numNodes + j]);
-		}
+		printf("%d :", i);
+		for (int e = graph.edge_offsets[i]; e < graph.edge_offsets[i + 1]; e++)
+			printf(" %d", graph.edge_targets[e]);
 		printf("\n");
 	}
 
@@ -122,29 +126,113 @@ Graph graph_copy(Graph graph)
 	copy.numNodes = graph.numNodes;
 	copy.numEdges = graph.numEdges;
 	copy.nodes = (char **)malloc(copy.numNodes * sizeof(char *));
-	copy.edges = (bool *)malloc(copy.numNodes * copy.numNodes * sizeof(bool));
+	for (int i = 0; i < copy.numNodes; i++)
+	{
+		copy.nodes[i] = (char *)malloc((strlen(graph.nodes[i]) + 1) * sizeof(char));
+		strcpy(copy.nodes[i], graph.nodes[i]);
+	}
 
-	for (int i = 0; i < copy.numNodes * copy.numNodes; i++)
-		copy.edges[i] = graph.edges[i];
+	int num_arcs = graph.edge_offsets[graph.numNodes];
+	copy.edge_offsets = (int *)malloc((copy.numNodes + 1) * sizeof(int));
+	memcpy(copy.edge_offsets, graph.edge_offsets, (copy.numNodes + 1) * sizeof(int));
+	copy.edge_targets = (int *)malloc(num_arcs * sizeof(int));
+	memcpy(copy.edge_targets, graph.edge_targets, num_arcs * sizeof(int));
 
 	copy.parameters = (parameterList **)malloc(graph.numNodes * sizeof(parameterList *));
 	for (int i = 0; i < graph.numNodes; i++)
 		copy.parameters[i] = parameter_list_copy(graph.parameters[i]);
 
-	copy.edge_parameters = (parameterList **)malloc(graph.numNodes * graph.numNodes * sizeof(parameterList *));
-	for (int i = 0; i < graph.numNodes * graph.numNodes; i++)
+	copy.edge_parameters = (parameterList **)malloc(num_arcs * sizeof(parameterList *));
+	for (int i = 0; i < num_arcs; i++)
 		copy.edge_parameters[i] = parameter_list_copy(graph.edge_parameters[i]);
 
+	copy.node_masks = NULL;
+	if (graph.node_masks != NULL)
+	{
+		copy.node_masks = (int *)malloc(copy.numNodes * sizeof(int));
+		memcpy(copy.node_masks, graph.node_masks, copy.numNodes * sizeof(int));
+	}
+	copy.mapping = NULL;
+	copy.mapping_size = 0;
+
 	return copy;
 }
 
+Graph graph_induced_subgraph(Graph graph, bool *kept, bool *kept_arcs)
+{
+	Graph sub;
+	sub.name = NULL;
+	if (graph.name != NULL)
+	{
+		sub.name = (char *)malloc((strlen(graph.name) + 1) * sizeof(char));
+		strcpy(sub.name, graph.name);
+	}
+
+	int *index = (int *)malloc(graph.numNodes * sizeof(int));
+	sub.numNodes = 0;
+	for (int i = 0; i < graph.numNodes; i++)
+		index[i] = kept[i] ? sub.numNodes++ : -1;
+
+	sub.nodes = (char **)malloc(sub.numNodes * sizeof(char *));
+	sub.parameters = (parameterList **)malloc(sub.numNodes * sizeof(parameterList *));
+	sub.edge_offsets = (int *)malloc((sub.numNodes + 1) * sizeof(int));
+	int num_arcs = 0;
+	for (int i = 0; i < graph.numNodes; i++)
+	{
+		if (index[i] == -1)
+			continue;
+		sub.nodes[index[i]] = (char *)malloc((strlen(graph.nodes[i]) + 1) * sizeof(char));
+		strcpy(sub.nodes[index[i]], graph.nodes[i]);
+		sub.parameters[index[i]] = parameter_list_copy(graph.parameters[i]);
+		for (int e = graph.edge_offsets[i]; e < graph.edge_offsets[i + 1]; e++)
+			num_arcs += index[graph.edge_targets[e]] != -1 && (kept_arcs == NULL || kept_arcs[e]);
+	}
+
+	// the targets stay sorted, as the renumbering is increasing
+	sub.edge_targets = (int *)malloc((num_arcs + 1) * sizeof(int));
+	sub.edge_parameters = (parameterList **)malloc((num_arcs + 1) * sizeof(parameterList *));
+	sub.numEdges = num_arcs;
+	num_arcs = 0;
+	for (int i = 0; i < graph.numNodes; i++)
+	{
+		if (index[i] == -1)
+			continue;
+		sub.edge_offsets[index[i]] = num_arcs;
+		for (int e = graph.edge_offsets[i]; e < graph.edge_offsets[i + 1]; e++)
+		{
+			if (index[graph.edge_targets[e]] == -1 || (kept_arcs != NULL && !kept_arcs[e]))
+				continue;
+			sub.edge_targets[num_arcs] = index[graph.edge_targets[e]];
+			sub.edge_parameters[num_arcs] = parameter_list_copy(graph.edge_parameters[e]);
+			num_arcs++;
+		}
+	}
+	sub.edge_offsets[sub.numNodes] = num_arcs;
+
+	sub.node_masks = NULL;
+	if (graph.node_masks != NULL)
+	{
+		sub.node_masks = (int *)malloc((sub.numNodes + 1) * sizeof(int));
+		for (int i = 0; i < graph.numNodes; i++)
+			if (index[i] != -1)
+				sub.node_masks[index[i]] = graph.node_masks[i];
+	}
+	sub.mapping = NULL;
+	sub.mapping_size = 0;
+
+	free(index);
+	return sub;
+}
+
 void graph_delete(Graph graph)
 {
-	if (graph.edges != NULL)
-		free(graph.edges);
+	int num_arcs = graph.edge_offsets[graph.numNodes];
+	bool mapped = graph.mapping != NULL;
+	if (!mapped)
+		free(graph.edge_targets);
 	if (graph.nodes != NULL)
 	{
-		for (int i = 0; i < graph.numNodes; i++)
+		for (int i = 0; i < graph.numNodes && !mapped; i++)
 		{
 			if (graph.nodes[i] != NULL)
 				free(graph.nodes[i]);
@@ -157,12 +245,19 @@ void graph_delete(Graph graph)
 		parameter_list_delete(graph.parameters[i]);
 	free(graph.parameters);
 
-	for (int i = 0; i < graph.numNodes * graph.numNodes; i++)
+	for (int i = 0; i < num_arcs; i++)
 		parameter_list_delete(graph.edge_parameters[i]);
 	free(graph.edge_parameters);
 
 	graph.numEdges = 0;
 	graph.numNodes = 0;
+	if (mapped)
+	{
+		munmap(graph.mapping, graph.mapping_size);
+		return;
+	}
+	free(graph.edge_offsets);
+	free(graph.node_masks);
 	free(graph.name);
 }
 
@@ -181,14 +276,53 @@ int graph_num_edges(Graph graph)
 	return graph.numEdges;
 }
 
+/**
+ * @brief Searches the index of the edge (@p source, @p target) in the arrays edge_targets and edge_parameters of @p graph.
+ *
+ * @param graph A graph.
+ * @param source The source of the edge.
+ * @param target The target of the edge.
+ * @return int The index of the edge, or -1 if it is not an edge of @p graph.
+ */
+static int graph_find_edge(Graph graph, int source, int target)
+{
+	int low = graph.edge_offsets[source];
+	int high = graph.edge_offsets[source + 1] - 1;
+	while (low <= high)
+	{
+		int middle = low + (high - low) / 2;
+		int current = graph.edge_targets[middle];
+		if (current == target)
+			return middle;
+		if (current < target)
+			low = middle + 1;
+		else
+			high = middle - 1;
+	}
+	return -1;
+}
+
 bool graph_is_edge(Graph graph, int source, int target)
 {
-	return graph.edges[(source * graph.numNodes) + target];
+	return graph_find_edge(graph, source, target) != -1;
+}
+
+int graph_out_degree(Graph graph, int node)
+{
+	return graph.edge_offsets[node + 1] - graph.edge_offsets[node];
+}
+
+int *graph_get_successors(Graph graph, int node)
+{
+	return graph.edge_targets + graph.edge_offsets[node];
 }
 
 parameterList *graph_get_edge_parameter(Graph graph, int source, int target)
 {
-	return graph.edge_parameters[(source * graph.numNodes) + target];
+	int edge = graph_find_edge(graph, source, target);
+	if (edge == -1)
+		return NULL;
+	return graph.edge_parameters[edge];
 }
 
 parameterList *graph_get_node_parameter(Graph graph, int node)
@@ -201,6 +335,11 @@ char *graph_get_node_name(Graph graph, int node)
 	return graph.nodes[node];
 }
 
+int *graph_get_node_masks(Graph graph)
+{
+	return graph.node_masks;
+}
+
 void graph_fill_dot_content(Graph graph, FILE *file)
 {
 	int num_nodes = graph.numNodes;
@@ -225,14 +364,14 @@ void graph_fill_dot_content(Graph graph, FILE *file)
 	}
 	for (int node = 0; node < num_nodes; node++)
 	{
-		for (int node2 = 0; node2 < node; node2++)
+		int degree = graph_out_degree(graph, node);
+		int *successors = graph_get_successors(graph, node);
+		for (int i = 0; i < degree && successors[i] < node; i++)
 		{
-			if (graph_is_edge(graph, node, node2))
-			{
-				fprintf(file, "%s -- %s", graph_get_node_name(graph, node), graph_get_node_name(graph, node2));
-				fprintf(file, ";\n");
-				// todo : edge parameters
-			}
+			int node2 = successors[i];
+			fprintf(file, "%s -- %s", graph_get_node_name(graph, node), graph_get_node_name(graph, node2));
+			fprintf(file, ";\n");
+			// todo : edge parameters
 		}
 	}
 }
@@ -261,15 +400,421 @@ void digraph_fill_dot_content(Graph graph, FILE *file)
 	}
 	for (int node = 0; node < num_nodes; node++)
 	{
-		for (int node2 = 0; node2 < num_nodes; node2++)
+		int degree = graph_out_degree(graph, node);
+		int *successors = graph_get_successors(graph, node);
+		for (int i = 0; i < degree; i++)
 		{
-			if (graph_is_edge(graph, node, node2))
-			{
-				fprintf(file, "%s -> %s", graph_get_node_name(graph, node), graph_get_node_name(graph, node2));
-				fprintf(file, ";\n");
+			int node2 = successors[i];
+			fprintf(file, "%s -> %s", graph_get_node_name(graph, node), graph_get_node_name(graph, node2));
+			fprintf(file, ";\n");
 
-				// todo : edge parameters.
-			}
+			// todo : edge parameters.
+		}
+	}
+}
+
+/* ------------------------------------------------------------------------- */
+/* Snapshots                                                                 */
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief Magic bytes at the start of every snapshot.
+ */
+#define SNAPSHOT_MAGIC "COCAGRPH"
+
+/**
+ * @brief Version of the snapshot format. Must be increased whenever the layout below changes.
+ */
+#define SNAPSHOT_VERSION 1
+
+/**
+ * @brief Header of a snapshot. Every section is designated by its offset from the start of the file, and aligned on 8 bytes.
+ * Strings are designated by their offset in the string pool, and are null-terminated.
+ * Parameters are stored as pairs (name, value) of strings: the parameters of node i are the pairs param_starts[i] to param_starts[i+1]-1, and similarly for edges with edge_param_starts.
+ */
+typedef struct
+{
+	char magic[8];				   ///< SNAPSHOT_MAGIC.
+	uint32_t version;			   ///< SNAPSHOT_VERSION.
+	uint32_t has_masks;			   ///< 1 if the masks section is present.
+	int32_t num_nodes;			   ///< Number of nodes.
+	int32_t num_edges;			   ///< Number of edges (as given by graph_num_edges).
+	int32_t num_arcs;			   ///< Number of entries of the compressed sparse rows.
+	int32_t num_params;			   ///< Total number of node parameters.
+	int32_t num_edge_params;	   ///< Total number of edge parameters.
+	uint32_t name;				   ///< Name of the graph (offset in the pool).
+	uint64_t offsets_section;	   ///< int32_t[num_nodes+1]: edge_offsets.
+	uint64_t targets_section;	   ///< int32_t[num_arcs]: edge_targets.
+	uint64_t masks_section;		   ///< int32_t[num_nodes]: node masks.
+	uint64_t names_section;		   ///< uint32_t[num_nodes]: names of the nodes.
+	uint64_t param_starts_section; ///< int32_t[num_nodes+1].
+	uint64_t params_section;	   ///< uint32_t[2*num_params].
+	uint64_t edge_starts_section;  ///< int32_t[num_arcs+1].
+	uint64_t edge_params_section;  ///< uint32_t[2*num_edge_params].
+	uint64_t pool_section;		   ///< The string pool.
+	uint64_t pool_size;			   ///< The size of the string pool.
+	uint64_t file_size;			   ///< The total size of the file.
+} snapshotHeader;
+
+/**
+ * @brief String pool under construction, where every string is stored only once (an open-addressing table gives the offset of already stored strings).
+ */
+typedef struct
+{
+	char *data;		  ///< The content of the pool.
+	size_t size;	  ///< The used size of data.
+	size_t capacity;  ///< The allocated size of data.
+	uint32_t *slots;  ///< Offset+1 of the string stored in each slot of the table (0 if the slot is empty).
+	size_t num_slots; ///< The number of slots (a power of two).
+	size_t num_used;  ///< The number of slots used.
+} stringPool;
+
+/**
+ * @brief FNV-1a hash of a string.
+ */
+static uint32_t snapshot_hash(const char *string)
+{
+	uint32_t hash = 2166136261u;
+	for (const unsigned char *c = (const unsigned char *)string; *c != '\0'; c++)
+	{
+		hash ^= *c;
+		hash *= 16777619u;
+	}
+	return hash;
+}
+
+/**
+ * @brief Returns the slot of @p pool where @p string is stored, or the empty slot where it should be.
+ */
+static size_t string_pool_slot(stringPool *pool, const char *string)
+{
+	size_t slot = snapshot_hash(string) & (pool->num_slots - 1);
+	while (pool->slots[slot] != 0 && strcmp(pool->data + pool->slots[slot] - 1, string) != 0)
+		slot = (slot + 1) & (pool->num_slots - 1);
+	return slot;
+}
+
+/**
+ * @brief Returns the offset of @p string in @p pool, adding it if it is not already present.
+ */
+static uint32_t string_pool_intern(stringPool *pool, const char *string)
+{
+	size_t slot = string_pool_slot(pool, string);
+	if (pool->slots[slot] != 0)
+		return pool->slots[slot] - 1;
+
+	size_t length = strlen(string) + 1;
+	while (pool->size + length > pool->capacity)
+	{
+		pool->capacity *= 2;
+		pool->data = (char *)realloc(pool->data, pool->capacity);
+	}
+	uint32_t offset = pool->size;
+	memcpy(pool->data + offset, string, length);
+	pool->size += length;
+	pool->slots[slot] = offset + 1;
+	pool->num_used++;
+
+	if (2 * pool->num_used > pool->num_slots)
+	{
+		uint32_t *old_slots = pool->slots;
+		size_t old_num_slots = pool->num_slots;
+		pool->num_slots *= 2;
+		pool->slots = (uint32_t *)calloc(pool->num_slots, sizeof(uint32_t));
+		for (size_t i = 0; i < old_num_slots; i++)
+			if (old_slots[i] != 0)
+				pool->slots[string_pool_slot(pool, pool->data + old_slots[i] - 1)] = old_slots[i];
+		free(old_slots);
+	}
+	return offset;
+}
+
+/**
+ * @brief Counts the parameters of @p list.
+ */
+static int parameter_list_length(parameterList *list)
+{
+	int length = 0;
+	for (; list != NULL; list = list->next)
+		length++;
+	return length;
+}
+
+/**
+ * @brief Stores the parameters of @p lists in the arrays starts (size @p num_lists+1) and pairs, and interns their strings in @p pool.
+ */
+static void snapshot_flatten_parameters(parameterList **lists, int num_lists, stringPool *pool, int32_t *starts, uint32_t *pairs)
+{
+	int count = 0;
+	for (int i = 0; i < num_lists; i++)
+	{
+		starts[i] = count;
+		for (parameterList *param = lists[i]; param != NULL; param = param->next)
+		{
+			pairs[2 * count] = string_pool_intern(pool, param->name);
+			pairs[2 * count + 1] = string_pool_intern(pool, param->value);
+			count++;
+		}
+	}
+	starts[num_lists] = count;
+}
+
+/**
+ * @brief Returns @p offset rounded up to a multiple of 8.
+ */
+static uint64_t snapshot_align(uint64_t offset)
+{
+	return (offset + 7) & ~(uint64_t)7;
+}
+
+/**
+ * @brief Writes @p size bytes of @p data at offset @p offset of @p file, padding with zeros from the current position.
+ */
+static bool snapshot_write_section(FILE *file, uint64_t offset, const void *data, size_t size)
+{
+	while ((uint64_t)ftell(file) < offset)
+		if (fputc(0, file) == EOF)
+			return false;
+	return size == 0 || fwrite(data, 1, size, file) == size;
+}
+
+bool graph_save_snapshot(Graph graph, int *node_masks, char *file_name)
+{
+	int num_nodes = graph.numNodes;
+	int num_arcs = graph.edge_offsets[num_nodes];
+
+	stringPool pool;
+	pool.capacity = 1024;
+	pool.size = 0;
+	pool.data = (char *)malloc(pool.capacity);
+	pool.num_slots = 1024;
+	pool.num_used = 0;
+	pool.slots = (uint32_t *)calloc(pool.num_slots, sizeof(uint32_t));
+
+	snapshotHeader header;
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, SNAPSHOT_MAGIC, 8);
+	header.version = SNAPSHOT_VERSION;
+	header.has_masks = node_masks != NULL;
+	header.num_nodes = num_nodes;
+	header.num_edges = graph.numEdges;
+	header.num_arcs = num_arcs;
+	header.name = string_pool_intern(&pool, graph.name != NULL ? graph.name : "");
+
+	uint32_t *names = (uint32_t *)malloc((num_nodes + 1) * sizeof(uint32_t));
+	for (int node = 0; node < num_nodes; node++)
+		names[node] = string_pool_intern(&pool, graph.nodes[node]);
+
+	int num_params = 0;
+	for (int node = 0; node < num_nodes; node++)
+		num_params += parameter_list_length(graph.parameters[node]);
+	int num_edge_params = 0;
+	for (int arc = 0; arc < num_arcs; arc++)
+		num_edge_params += parameter_list_length(graph.edge_parameters[arc]);
+	header.num_params = num_params;
+	header.num_edge_params = num_edge_params;
+
+	int32_t *param_starts = (int32_t *)malloc((num_nodes + 1) * sizeof(int32_t));
+	uint32_t *params = (uint32_t *)malloc((2 * num_params + 1) * sizeof(uint32_t));
+	snapshot_flatten_parameters(graph.parameters, num_nodes, &pool, param_starts, params);
+	int32_t *edge_starts = (int32_t *)malloc((num_arcs + 1) * sizeof(int32_t));
+	uint32_t *edge_params = (uint32_t *)malloc((2 * num_edge_params + 1) * sizeof(uint32_t));
+	snapshot_flatten_parameters(graph.edge_parameters, num_arcs, &pool, edge_starts, edge_params);
+
+	uint64_t offset = snapshot_align(sizeof(snapshotHeader));
+	header.offsets_section = offset;
+	offset = snapshot_align(offset + (num_nodes + 1) * sizeof(int32_t));
+	header.targets_section = offset;
+	offset = snapshot_align(offset + num_arcs * sizeof(int32_t));
+	header.masks_section = offset;
+	if (node_masks != NULL)
+		offset = snapshot_align(offset + num_nodes * sizeof(int32_t));
+	header.names_section = offset;
+	offset = snapshot_align(offset + num_nodes * sizeof(uint32_t));
+	header.param_starts_section = offset;
+	offset = snapshot_align(offset + (num_nodes + 1) * sizeof(int32_t));
+	header.params_section = offset;
+	offset = snapshot_align(offset + 2 * num_params * sizeof(uint32_t));
+	header.edge_starts_section = offset;
+	offset = snapshot_align(offset + (num_arcs + 1) * sizeof(int32_t));
+	header.edge_params_section = offset;
+	offset = snapshot_align(offset + 2 * num_edge_params * sizeof(uint32_t));
+	header.pool_section = offset;
+	header.pool_size = pool.size;
+	header.file_size = offset + pool.size;
+
+	bool ok = false;
+	FILE *file = fopen(file_name, "wb");
+	if (file != NULL)
+	{
+		ok = snapshot_write_section(file, 0, &header, sizeof(header)) &&
+			 snapshot_write_section(file, header.offsets_section, graph.edge_offsets, (num_nodes + 1) * sizeof(int32_t)) &&
+			 snapshot_write_section(file, header.targets_section, graph.edge_targets, num_arcs * sizeof(int32_t)) &&
+			 (node_masks == NULL || snapshot_write_section(file, header.masks_section, node_masks, num_nodes * sizeof(int32_t))) &&
+			 snapshot_write_section(file, header.names_section, names, num_nodes * sizeof(uint32_t)) &&
+			 snapshot_write_section(file, header.param_starts_section, param_starts, (num_nodes + 1) * sizeof(int32_t)) &&
+			 snapshot_write_section(file, header.params_section, params, 2 * num_params * sizeof(uint32_t)) &&
+			 snapshot_write_section(file, header.edge_starts_section, edge_starts, (num_arcs + 1) * sizeof(int32_t)) &&
+			 snapshot_write_section(file, header.edge_params_section, edge_params, 2 * num_edge_params * sizeof(uint32_t)) &&
+			 snapshot_write_section(file, header.pool_section, pool.data, pool.size);
+		ok = (fclose(file) == 0) && ok;
+	}
+
+	free(names);
+	free(param_starts);
+	free(params);
+	free(edge_starts);
+	free(edge_params);
+	free(pool.data);
+	free(pool.slots);
+	return ok;
+}
+
+bool graph_is_snapshot(char *file_name)
+{
+	FILE *file = fopen(file_name, "rb");
+	if (file == NULL)
+		return false;
+	char magic[8];
+	bool result = fread(magic, sizeof(magic), 1, file) == 1 && memcmp(magic, SNAPSHOT_MAGIC, 8) == 0;
+	fclose(file);
+	return result;
+}
+
+/**
+ * @brief Checks that the sections described by @p header fit in a file of size @p size, and that the string pool ends with a null character.
+ */
+static bool snapshot_check_header(const snapshotHeader *header, size_t size)
+{
+	const char *base = (const char *)header;
+	if (memcmp(header->magic, SNAPSHOT_MAGIC, 8) != 0 || header->version != SNAPSHOT_VERSION || header->file_size != size)
+		return false;
+	if (header->num_nodes < 0 || header->num_edges < 0 || header->num_arcs < 0 || header->num_params < 0 || header->num_edge_params < 0)
+		return false;
+	uint64_t starts[] = {header->offsets_section, header->targets_section, header->masks_section, header->names_section, header->param_starts_section,
+						 header->params_section, header->edge_starts_section, header->edge_params_section, header->pool_section};
+	for (size_t i = 0; i < sizeof(starts) / sizeof(starts[0]); i++)
+		if (starts[i] > size || starts[i] % 8 != 0)
+			return false;
+	if (header->pool_size > size)
+		return false;
+	uint64_t ends[] = {
+		header->offsets_section + (header->num_nodes + 1) * sizeof(int32_t),
+		header->targets_section + header->num_arcs * sizeof(int32_t),
+		header->masks_section + (header->has_masks ? header->num_nodes * sizeof(int32_t) : 0),
+		header->names_section + header->num_nodes * sizeof(uint32_t),
+		header->param_starts_section + (header->num_nodes + 1) * sizeof(int32_t),
+		header->params_section + 2 * header->num_params * sizeof(uint32_t),
+		header->edge_starts_section + (header->num_arcs + 1) * sizeof(int32_t),
+		header->edge_params_section + 2 * header->num_edge_params * sizeof(uint32_t),
+		header->pool_section + header->pool_size};
+	for (size_t i = 0; i < sizeof(ends) / sizeof(ends[0]); i++)
+		if (ends[i] > size)
+			return false;
+	return header->pool_size > 0 && header->name < header->pool_size && base[header->pool_section + header->pool_size - 1] == '\0';
+}
+
+/**
+ * @brief Checks that the parameter lists described by @p starts and @p pairs are well formed: the starts go from 0 to @p num_params without decreasing, and the names and values are in the pool.
+ */
+static bool snapshot_check_parameters(int num_lists, const int32_t *starts, int num_params, const uint32_t *pairs, uint64_t pool_size)
+{
+	if (starts[0] != 0 || starts[num_lists] != num_params)
+		return false;
+	for (int i = 0; i < num_lists; i++)
+		if (starts[i] > starts[i + 1])
+			return false;
+	for (int p = 0; p < 2 * num_params; p++)
+		if (pairs[p] >= pool_size)
+			return false;
+	return true;
+}
+
+/**
+ * @brief Checks the contents of the sections of the snapshot @p header (whose sections are known to fit in the file, see snapshot_check_header): the compressed sparse rows go from 0 to num_arcs without decreasing and only target nodes of the graph, and every string is in the pool.
+ */
+static bool snapshot_check_contents(const snapshotHeader *header)
+{
+	const char *base = (const char *)header;
+	int num_nodes = header->num_nodes;
+	const int32_t *offsets = (const int32_t *)(base + header->offsets_section);
+	if (offsets[0] != 0 || offsets[num_nodes] != header->num_arcs)
+		return false;
+	for (int node = 0; node < num_nodes; node++)
+		if (offsets[node] > offsets[node + 1])
+			return false;
+	const int32_t *targets = (const int32_t *)(base + header->targets_section);
+	for (int arc = 0; arc < header->num_arcs; arc++)
+		if (targets[arc] < 0 || targets[arc] >= num_nodes)
+			return false;
+	const uint32_t *names = (const uint32_t *)(base + header->names_section);
+	for (int node = 0; node < num_nodes; node++)
+		if (names[node] >= header->pool_size)
+			return false;
+	return snapshot_check_parameters(num_nodes, (const int32_t *)(base + header->param_starts_section), header->num_params, (const uint32_t *)(base + header->params_section), header->pool_size) &&
+		   snapshot_check_parameters(header->num_arcs, (const int32_t *)(base + header->edge_starts_section), header->num_edge_params, (const uint32_t *)(base + header->edge_params_section), header->pool_size);
+}
+
+/**
+ * @brief Rebuilds the parameter lists described by @p starts and @p pairs (see snapshotHeader).
+ */
+static parameterList **snapshot_read_parameters(int num_lists, const int32_t *starts, const uint32_t *pairs, const char *pool)
+{
+	parameterList **lists = (parameterList **)malloc((num_lists + 1) * sizeof(parameterList *));
+	for (int i = 0; i < num_lists; i++)
+	{
+		parameterList *list = NULL;
+		parameterList **last = &list;
+		for (int p = starts[i]; p < starts[i + 1]; p++)
+		{
+			*last = parameter_list_add_parameter(NULL, (char *)pool + pairs[2 * p], (char *)pool + pairs[2 * p + 1]);
+			last = &(*last)->next;
 		}
+		lists[i] = list;
+	}
+	return lists;
+}
+
+Graph graph_load_snapshot(char *file_name)
+{
+	int descriptor = open(file_name, O_RDONLY);
+	if (descriptor == -1)
+	{
+		printf("file %s does not exist. Exiting.\n", file_name);
+		exit(-1);
 	}
-}
\ No newline at end of file
+	struct stat st;
+	void *mapping = MAP_FAILED;
+	if (fstat(descriptor, &st) == 0 && (size_t)st.st_size >= sizeof(snapshotHeader))
+		mapping = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+	close(descriptor);
+	if (mapping == MAP_FAILED || !snapshot_check_header((const snapshotHeader *)mapping, st.st_size) || !snapshot_check_contents((const snapshotHeader *)mapping))
+	{
+		printf("file %s is not a valid graph snapshot. Exiting.\n", file_name);
+		exit(-1);
+	}
+
+	const char *base = (const char *)mapping;
+	const snapshotHeader *header = (const snapshotHeader *)mapping;
+	const char *pool = base + header->pool_section;
+
+	Graph graph;
+	graph.mapping = mapping;
+	graph.mapping_size = st.st_size;
+	graph.name = (char *)pool + header->name;
+	graph.numNodes = header->num_nodes;
+	graph.numEdges = header->num_edges;
+	graph.edge_offsets = (int *)(base + header->offsets_section);
+	graph.edge_targets = (int *)(base + header->targets_section);
+	graph.node_masks = header->has_masks ? (int *)(base + header->masks_section) : NULL;
+
+	const uint32_t *names = (const uint32_t *)(base + header->names_section);
+	graph.nodes = (char **)malloc((graph.numNodes + 1) * sizeof(char *));
+	for (int node = 0; node < graph.numNodes; node++)
+		graph.nodes[node] = (char *)pool + names[node];
+
+	graph.parameters = snapshot_read_parameters(graph.numNodes, (const int32_t *)(base + header->param_starts_section), (const uint32_t *)(base + header->params_section), pool);
+	graph.edge_parameters = snapshot_read_parameters(header->num_arcs, (const int32_t *)(base + header->edge_starts_section), (const uint32_t *)(base + header->edge_params_section), pool);
+
+	return graph;
+}
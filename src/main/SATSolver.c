@@ -0,0 +1,905 @@
+#include "SATSolver.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+
+/*
+ * Inside the solver, the variables are numbered from 0 and the literal of the variable v is 2v (positive) or 2v+1 (negative), so that the opposite of a literal is
+ * obtained by flipping its last bit.
+ */
+
+/**
+ * @brief A clause. The two first literals are the watched ones, and when the clause is the reason of a literal, this literal is the first one.
+ *
+ */
+typedef struct
+{
+    int size;        ///< The number of literals.
+    bool learnt;     ///< Tells if the clause was learnt (and can be thrown away).
+    int lbd;         ///< For a learnt clause, the number of distinct decision levels of its literals when it was learnt.
+    double activity; ///< For a learnt clause, how often it took part in the recent conflicts.
+    int lits[];      ///< The literals.
+} sat_clause;
+
+/**
+ * @brief An entry of a watch list: a clause watching the literal, and another literal of the clause (if it is true, the clause is satisfied and need not be looked at).
+ *
+ */
+typedef struct
+{
+    sat_clause *clause;
+    int blocker;
+} sat_watch;
+
+/**
+ * @brief The clauses watching a literal.
+ *
+ */
+typedef struct
+{
+    sat_watch *watches;
+    int size;
+    int capacity;
+} sat_watch_list;
+
+/**
+ * @brief A growable array of clauses.
+ *
+ */
+typedef struct
+{
+    sat_clause **clauses;
+    long size;
+    long capacity;
+} sat_clause_list;
+
+struct SatSolver_s
+{
+    int num_vars;             ///< The number of variables.
+    int capacity;             ///< The number of variables allocated.
+    bool ok;                  ///< False once the clauses are known to be unsatisfiable.
+    signed char *values;      ///< The value of each literal: 1 (true), -1 (false) or 0 (unassigned).
+    signed char *model;       ///< The value of each variable in the last model found.
+    int *levels;              ///< The decision level of each assigned variable.
+    sat_clause **reasons;     ///< The clause which propagated each assigned variable (NULL for a decision or a literal fixed at level 0).
+    double *activities;       ///< The activity of each variable.
+    bool *phases;             ///< The last value of each variable (phase saving).
+    char *seen;               ///< Marks of the conflict analysis.
+    sat_watch_list *watches;  ///< The clauses watching each literal.
+    int *trail;               ///< The assigned literals, in the order of assignment.
+    int trail_size;           ///< The number of assigned literals.
+    int *trail_limits;        ///< The position in the trail of the first literal of each decision level.
+    int num_levels;           ///< The current decision level.
+    int propagated;           ///< The number of literals of the trail already propagated.
+    int *heap;                ///< The unassigned variables (and some assigned ones), as a max-heap on the activity.
+    int heap_size;            ///< The number of variables in the heap.
+    int *heap_index;          ///< The position of each variable in the heap (-1 if absent).
+    double var_increment;     ///< The amount added to the activity of a variable bumped.
+    double clause_increment;  ///< The amount added to the activity of a learnt clause bumped.
+    sat_clause_list clauses;  ///< The clauses given.
+    sat_clause_list learnts;  ///< The learnt clauses kept.
+    int *learnt;              ///< Buffer of the clause being learnt.
+    int *to_clear;            ///< Buffer of the variables marked during the analysis.
+    int *level_stamps;        ///< Marks of the levels, to compute the LBD.
+    int stamp;                ///< The current mark of level_stamps.
+    long next_reduce;         ///< The number of conflicts at which the learnt clauses are reduced next.
+    long num_reductions;      ///< The number of reductions of the learnt clauses done.
+    long num_conflicts;
+    long num_decisions;
+    long num_propagations;
+    long num_restarts;
+};
+
+static void *sat_malloc(size_t size)
+{
+    void *result = malloc(size);
+    if (result == NULL && size > 0)
+    {
+        printf("Malloc failed\n");
+        exit(EXIT_FAILURE);
+    }
+    return result;
+}
+
+static void *sat_realloc(void *pointer, size_t size)
+{
+    void *result = realloc(pointer, size);
+    if (result == NULL && size > 0)
+    {
+        printf("Malloc failed\n");
+        exit(EXIT_FAILURE);
+    }
+    return result;
+}
+
+/**
+ * @brief The activity of the variables and the clauses decays by these factors at each conflict (their increments grow by the inverse).
+ */
+#define SAT_VAR_DECAY 0.95
+#define SAT_CLAUSE_DECAY 0.999
+
+/**
+ * @brief The number of conflicts of the first step of the Luby sequence of restarts.
+ */
+#define SAT_RESTART_UNIT 100
+
+/**
+ * @brief The learnt clauses are reduced after SAT_REDUCE_FIRST conflicts, then every SAT_REDUCE_FIRST + k * SAT_REDUCE_INCREMENT conflicts.
+ */
+#define SAT_REDUCE_FIRST 2000
+#define SAT_REDUCE_INCREMENT 300
+
+static inline int sat_var(int lit)
+{
+    return lit >> 1;
+}
+
+/**
+ * @brief Converts the literal @p lit of the interface (DIMACS) into an internal literal.
+ */
+static inline int sat_import(int lit)
+{
+    return lit > 0 ? 2 * (lit - 1) : 2 * (-lit - 1) + 1;
+}
+
+/**
+ * @brief Converts the internal literal @p lit into a literal of the interface (DIMACS).
+ */
+static inline int sat_export(int lit)
+{
+    return (lit & 1) ? -(sat_var(lit) + 1) : sat_var(lit) + 1;
+}
+
+static void sat_clause_list_push(sat_clause_list *list, sat_clause *clause)
+{
+    if (list->size == list->capacity)
+    {
+        list->capacity = list->capacity == 0 ? 64 : 2 * list->capacity;
+        list->clauses = sat_realloc(list->clauses, list->capacity * sizeof(sat_clause *));
+    }
+    list->clauses[list->size++] = clause;
+}
+
+static void sat_watch_push(sat_watch_list *list, sat_clause *clause, int blocker)
+{
+    if (list->size == list->capacity)
+    {
+        list->capacity = list->capacity == 0 ? 4 : 2 * list->capacity;
+        list->watches = sat_realloc(list->watches, list->capacity * sizeof(sat_watch));
+    }
+    list->watches[list->size].clause = clause;
+    list->watches[list->size].blocker = blocker;
+    list->size++;
+}
+
+/*
+ * The heap of the variables, ordered by decreasing activity.
+ */
+
+static void sat_heap_up(SatSolver solver, int position)
+{
+    int var = solver->heap[position];
+    while (position > 0)
+    {
+        int parent = (position - 1) / 2;
+        if (solver->activities[solver->heap[parent]] >= solver->activities[var])
+            break;
+        solver->heap[position] = solver->heap[parent];
+        solver->heap_index[solver->heap[position]] = position;
+        position = parent;
+    }
+    solver->heap[position] = var;
+    solver->heap_index[var] = position;
+}
+
+static void sat_heap_down(SatSolver solver, int position)
+{
+    int var = solver->heap[position];
+    while (2 * position + 1 < solver->heap_size)
+    {
+        int child = 2 * position + 1;
+        if (child + 1 < solver->heap_size && solver->activities[solver->heap[child + 1]] > solver->activities[solver->heap[child]])
+            child++;
+        if (solver->activities[solver->heap[child]] <= solver->activities[var])
+            break;
+        solver->heap[position] = solver->heap[child];
+        solver->heap_index[solver->heap[position]] = position;
+        position = child;
+    }
+    solver->heap[position] = var;
+    solver->heap_index[var] = position;
+}
+
+static void sat_heap_insert(SatSolver solver, int var)
+{
+    if (solver->heap_index[var] >= 0)
+        return;
+    solver->heap[solver->heap_size] = var;
+    solver->heap_index[var] = solver->heap_size++;
+    sat_heap_up(solver, solver->heap_size - 1);
+}
+
+static int sat_heap_pop(SatSolver solver)
+{
+    int var = solver->heap[0];
+    solver->heap_index[var] = -1;
+    solver->heap_size--;
+    if (solver->heap_size > 0)
+    {
+        solver->heap[0] = solver->heap[solver->heap_size];
+        solver->heap_index[solver->heap[0]] = 0;
+        sat_heap_down(solver, 0);
+    }
+    return var;
+}
+
+/*
+ * Activities (EVSIDS): instead of decaying every activity at each conflict, the increment grows, and everything is scaled down when the numbers get too large.
+ */
+
+static void sat_bump_var(SatSolver solver, int var)
+{
+    solver->activities[var] += solver->var_increment;
+    if (solver->activities[var] > 1e100)
+    {
+        for (int v = 0; v < solver->num_vars; v++)
+            solver->activities[v] *= 1e-100;
+        solver->var_increment *= 1e-100;
+    }
+    if (solver->heap_index[var] >= 0)
+        sat_heap_up(solver, solver->heap_index[var]);
+}
+
+static void sat_bump_clause(SatSolver solver, sat_clause *clause)
+{
+    clause->activity += solver->clause_increment;
+    if (clause->activity > 1e20)
+    {
+        for (long i = 0; i < solver->learnts.size; i++)
+            solver->learnts.clauses[i]->activity *= 1e-20;
+        solver->clause_increment *= 1e-20;
+    }
+}
+
+SatSolver sat_create(void)
+{
+    SatSolver solver = sat_malloc(sizeof(*solver));
+    memset(solver, 0, sizeof(*solver));
+    solver->ok = true;
+    solver->var_increment = 1;
+    solver->clause_increment = 1;
+    solver->next_reduce = SAT_REDUCE_FIRST;
+    return solver;
+}
+
+void sat_delete(SatSolver solver)
+{
+    for (long i = 0; i < solver->clauses.size; i++)
+        free(solver->clauses.clauses[i]);
+    for (long i = 0; i < solver->learnts.size; i++)
+        free(solver->learnts.clauses[i]);
+    free(solver->clauses.clauses);
+    free(solver->learnts.clauses);
+    for (int lit = 0; lit < 2 * solver->num_vars; lit++)
+        free(solver->watches[lit].watches);
+    free(solver->watches);
+    free(solver->values);
+    free(solver->model);
+    free(solver->levels);
+    free(solver->reasons);
+    free(solver->activities);
+    free(solver->phases);
+    free(solver->seen);
+    free(solver->trail);
+    free(solver->trail_limits);
+    free(solver->heap);
+    free(solver->heap_index);
+    free(solver->learnt);
+    free(solver->to_clear);
+    free(solver->level_stamps);
+    free(solver);
+}
+
+int sat_new_var(SatSolver solver)
+{
+    if (solver->num_vars == solver->capacity)
+    {
+        int capacity = solver->capacity == 0 ? 1024 : 2 * solver->capacity;
+        solver->values = sat_realloc(solver->values, 2 * capacity * sizeof(signed char));
+        solver->model = sat_realloc(solver->model, capacity * sizeof(signed char));
+        solver->levels = sat_realloc(solver->levels, capacity * sizeof(int));
+        solver->reasons = sat_realloc(solver->reasons, capacity * sizeof(sat_clause *));
+        solver->activities = sat_realloc(solver->activities, capacity * sizeof(double));
+        solver->phases = sat_realloc(solver->phases, capacity * sizeof(bool));
+        solver->seen = sat_realloc(solver->seen, capacity * sizeof(char));
+        solver->watches = sat_realloc(solver->watches, 2 * capacity * sizeof(sat_watch_list));
+        solver->trail = sat_realloc(solver->trail, capacity * sizeof(int));
+        solver->trail_limits = sat_realloc(solver->trail_limits, (capacity + 1) * sizeof(int));
+        solver->heap = sat_realloc(solver->heap, capacity * sizeof(int));
+        solver->heap_index = sat_realloc(solver->heap_index, capacity * sizeof(int));
+        solver->learnt = sat_realloc(solver->learnt, (capacity + 1) * sizeof(int));
+        solver->to_clear = sat_realloc(solver->to_clear, (capacity + 1) * sizeof(int));
+        solver->level_stamps = sat_realloc(solver->level_stamps, (capacity + 1) * sizeof(int));
+        memset(solver->level_stamps + solver->capacity, 0, (capacity + 1 - solver->capacity) * sizeof(int));
+        solver->capacity = capacity;
+    }
+
+    int var = solver->num_vars++;
+    solver->values[2 * var] = 0;
+    solver->values[2 * var + 1] = 0;
+    solver->model[var] = 0;
+    solver->levels[var] = 0;
+    solver->reasons[var] = NULL;
+    solver->activities[var] = 0;
+    // les encodages des réductions sont pleins de variables qui valent faux : on essaie faux d'abord
+    solver->phases[var] = false;
+    solver->seen[var] = 0;
+    memset(&solver->watches[2 * var], 0, 2 * sizeof(sat_watch_list));
+    solver->heap_index[var] = -1;
+    sat_heap_insert(solver, var);
+    return var + 1;
+}
+
+static inline signed char sat_lit_get(SatSolver solver, int lit)
+{
+    return solver->values[lit];
+}
+
+static void sat_assign(SatSolver solver, int lit, sat_clause *reason)
+{
+    int var = sat_var(lit);
+    solver->values[lit] = 1;
+    solver->values[lit ^ 1] = -1;
+    solver->levels[var] = solver->num_levels;
+    solver->reasons[var] = reason;
+    solver->trail[solver->trail_size++] = lit;
+}
+
+static void sat_new_level(SatSolver solver)
+{
+    solver->trail_limits[solver->num_levels++] = solver->trail_size;
+}
+
+/**
+ * @brief Undoes the assignments of the levels above @p level, saving their phases.
+ */
+static void sat_backtrack(SatSolver solver, int level)
+{
+    if (solver->num_levels <= level)
+        return;
+    for (int i = solver->trail_size - 1; i >= solver->trail_limits[level]; i--)
+    {
+        int lit = solver->trail[i];
+        int var = sat_var(lit);
+        solver->values[lit] = 0;
+        solver->values[lit ^ 1] = 0;
+        solver->reasons[var] = NULL;
+        solver->phases[var] = !(lit & 1);
+        sat_heap_insert(solver, var);
+    }
+    solver->trail_size = solver->trail_limits[level];
+    solver->propagated = solver->trail_size;
+    solver->num_levels = level;
+}
+
+static void sat_attach(SatSolver solver, sat_clause *clause)
+{
+    sat_watch_push(&solver->watches[clause->lits[0]], clause, clause->lits[1]);
+    sat_watch_push(&solver->watches[clause->lits[1]], clause, clause->lits[0]);
+}
+
+static sat_clause *sat_clause_create(const int *lits, int size, bool learnt)
+{
+    sat_clause *clause = sat_malloc(sizeof(sat_clause) + size * sizeof(int));
+    clause->size = size;
+    clause->learnt = learnt;
+    clause->lbd = 0;
+    clause->activity = 0;
+    memcpy(clause->lits, lits, size * sizeof(int));
+    return clause;
+}
+
+/**
+ * @brief Propagates the literals of the trail not propagated yet: each clause watching a literal which became false looks for another literal to watch, and if it has none, its other watched literal is implied (or the clause is in conflict).
+ * @return sat_clause* The clause in conflict, NULL if there is none.
+ */
+static sat_clause *sat_propagate(SatSolver solver)
+{
+    sat_clause *conflict = NULL;
+    while (solver->propagated < solver->trail_size)
+    {
+        int false_lit = solver->trail[solver->propagated++] ^ 1;
+        sat_watch_list *list = &solver->watches[false_lit];
+        sat_watch *read = list->watches;
+        sat_watch *write = list->watches;
+        sat_watch *end = list->watches + list->size;
+        solver->num_propagations++;
+
+        while (read < end)
+        {
+            sat_watch watch = *read++;
+            if (sat_lit_get(solver, watch.blocker) == 1)
+            {
+                *write++ = watch;
+                continue;
+            }
+
+            // le littéral devenu faux est mis en deuxième position
+            sat_clause *clause = watch.clause;
+            int *lits = clause->lits;
+            if (lits[0] == false_lit)
+            {
+                lits[0] = lits[1];
+                lits[1] = false_lit;
+            }
+            int first = lits[0];
+            bool satisfied = first != watch.blocker && sat_lit_get(solver, first) == 1;
+            watch.blocker = first;
+            if (satisfied)
+            {
+                *write++ = watch;
+                continue;
+            }
+
+            // un autre littéral non faux à surveiller ?
+            bool moved = false;
+            for (int k = 2; k < clause->size; k++)
+            {
+                if (sat_lit_get(solver, lits[k]) != -1)
+                {
+                    lits[1] = lits[k];
+                    lits[k] = false_lit;
+                    sat_watch_push(&solver->watches[lits[1]], clause, first);
+                    moved = true;
+                    break;
+                }
+            }
+            if (moved)
+                continue;
+
+            // la clause est unitaire ou en conflit
+            *write++ = watch;
+            if (sat_lit_get(solver, first) == -1)
+            {
+                conflict = clause;
+                solver->propagated = solver->trail_size;
+                while (read < end)
+                    *write++ = *read++;
+            }
+            else
+                sat_assign(solver, first, clause);
+        }
+        list->size = (int)(write - list->watches);
+        if (conflict != NULL)
+            break;
+    }
+    return conflict;
+}
+
+/**
+ * @brief Tells if the literal @p lit of the learnt clause is implied by the other ones: all the literals of its reason are in the clause or fixed at level 0.
+ */
+static bool sat_redundant(SatSolver solver, int lit)
+{
+    sat_clause *reason = solver->reasons[sat_var(lit)];
+    if (reason == NULL)
+        return false;
+    for (int k = 1; k < reason->size; k++)
+    {
+        int var = sat_var(reason->lits[k]);
+        if (!solver->seen[var] && solver->levels[var] > 0)
+            return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Computes the number of distinct decision levels of the literals of @p lits.
+ */
+static int sat_compute_lbd(SatSolver solver, const int *lits, int size)
+{
+    solver->stamp++;
+    int lbd = 0;
+    for (int i = 0; i < size; i++)
+    {
+        int level = solver->levels[sat_var(lits[i])];
+        if (solver->level_stamps[level] != solver->stamp)
+        {
+            solver->level_stamps[level] = solver->stamp;
+            lbd++;
+        }
+    }
+    return lbd;
+}
+
+/**
+ * @brief Analyses @p conflict: learns the clause of the first unique implication point (in solver->learnt, the asserting literal first and a literal of the backtrack level second), minimized by removing the literals implied by the other ones.
+ * @param backtrack_level Set to the level where the learnt clause becomes unit.
+ * @return int The size of the learnt clause.
+ */
+static int sat_analyze(SatSolver solver, sat_clause *conflict, int *backtrack_level)
+{
+    int *learnt = solver->learnt;
+    int size = 1;
+    int num_to_clear = 0;
+    int pending = 0;
+    int lit = -1;
+    int index = solver->trail_size - 1;
+    sat_clause *clause = conflict;
+
+    do
+    {
+        if (clause->learnt)
+            sat_bump_clause(solver, clause);
+        for (int k = (lit == -1) ? 0 : 1; k < clause->size; k++)
+        {
+            int q = clause->lits[k];
+            int var = sat_var(q);
+            if (solver->seen[var] || solver->levels[var] == 0)
+                continue;
+            sat_bump_var(solver, var);
+            solver->seen[var] = 1;
+            solver->to_clear[num_to_clear++] = var;
+            if (solver->levels[var] >= solver->num_levels)
+                pending++;
+            else
+                learnt[size++] = q;
+        }
+        // le prochain littéral marqué du trail, en remontant
+        while (!solver->seen[sat_var(solver->trail[index])])
+            index--;
+        lit = solver->trail[index--];
+        clause = solver->reasons[sat_var(lit)];
+        solver->seen[sat_var(lit)] = 0;
+        pending--;
+    } while (pending > 0);
+    learnt[0] = lit ^ 1;
+
+    int kept = 1;
+    for (int i = 1; i < size; i++)
+        if (!sat_redundant(solver, learnt[i]))
+            learnt[kept++] = learnt[i];
+    size = kept;
+
+    for (int i = 0; i < num_to_clear; i++)
+        solver->seen[solver->to_clear[i]] = 0;
+
+    *backtrack_level = 0;
+    if (size > 1)
+    {
+        int max = 1;
+        for (int i = 2; i < size; i++)
+            if (solver->levels[sat_var(learnt[i])] > solver->levels[sat_var(learnt[max])])
+                max = i;
+        int swap = learnt[1];
+        learnt[1] = learnt[max];
+        learnt[max] = swap;
+        *backtrack_level = solver->levels[sat_var(learnt[1])];
+    }
+    return size;
+}
+
+/**
+ * @brief Tells if @p clause is the reason of an assigned literal (and cannot be thrown away).
+ */
+static inline bool sat_locked(SatSolver solver, sat_clause *clause)
+{
+    return sat_lit_get(solver, clause->lits[0]) == 1 && solver->reasons[sat_var(clause->lits[0])] == clause;
+}
+
+/**
+ * @brief Orders the learnt clauses from the least useful to the most useful: largest LBD first, then least active first.
+ */
+static int sat_compare_learnts(const void *a, const void *b)
+{
+    const sat_clause *x = *(sat_clause *const *)a;
+    const sat_clause *y = *(sat_clause *const *)b;
+    if (x->lbd != y->lbd)
+        return x->lbd > y->lbd ? -1 : 1;
+    if (x->activity != y->activity)
+        return x->activity < y->activity ? -1 : 1;
+    return 0;
+}
+
+/**
+ * @brief Throws away the least useful half of the learnt clauses, except the ones with an LBD at most 2 ("glue" clauses) and the reasons of assigned literals.
+ */
+static void sat_reduce_learnts(SatSolver solver)
+{
+    sat_clause_list *learnts = &solver->learnts;
+    qsort(learnts->clauses, learnts->size, sizeof(sat_clause *), sat_compare_learnts);
+
+    long limit = learnts->size / 2;
+    long num_removed = 0;
+    for (long i = 0; i < limit; i++)
+    {
+        sat_clause *clause = learnts->clauses[i];
+        if (clause->lbd > 2 && clause->size > 2 && !sat_locked(solver, clause))
+        {
+            // marquée (taille négative) pour être retirée des listes de surveillance
+            clause->size = -clause->size;
+            num_removed++;
+        }
+    }
+    if (num_removed == 0)
+        return;
+
+    for (int lit = 0; lit < 2 * solver->num_vars; lit++)
+    {
+        sat_watch_list *list = &solver->watches[lit];
+        int kept = 0;
+        for (int i = 0; i < list->size; i++)
+            if (list->watches[i].clause->size > 0)
+                list->watches[kept++] = list->watches[i];
+        list->size = kept;
+    }
+
+    long kept = 0;
+    for (long i = 0; i < learnts->size; i++)
+    {
+        if (learnts->clauses[i]->size < 0)
+            free(learnts->clauses[i]);
+        else
+            learnts->clauses[kept++] = learnts->clauses[i];
+    }
+    learnts->size = kept;
+}
+
+bool sat_add_clause(SatSolver solver, const int *lits, int size)
+{
+    if (!solver->ok)
+        return false;
+    assert(solver->num_levels == 0);
+
+    int *buffer = sat_malloc((size + 1) * sizeof(int));
+    int kept = 0;
+    for (int i = 0; i < size; i++)
+    {
+        assert(lits[i] != 0 && abs(lits[i]) <= solver->num_vars);
+        int lit = sat_import(lits[i]);
+        signed char value = sat_lit_get(solver, lit);
+        if (value == 1)
+        {
+            free(buffer);
+            return true;
+        }
+        if (value == -1)
+            continue;
+        // doublons et tautologies
+        bool duplicate = false;
+        for (int j = 0; j < kept; j++)
+        {
+            if (buffer[j] == lit)
+                duplicate = true;
+            else if (buffer[j] == (lit ^ 1))
+            {
+                free(buffer);
+                return true;
+            }
+        }
+        if (!duplicate)
+            buffer[kept++] = lit;
+    }
+
+    if (kept == 0)
+        solver->ok = false;
+    else if (kept == 1)
+    {
+        sat_assign(solver, buffer[0], NULL);
+        solver->ok = (sat_propagate(solver) == NULL);
+    }
+    else
+    {
+        sat_clause *clause = sat_clause_create(buffer, kept, false);
+        sat_clause_list_push(&solver->clauses, clause);
+        sat_attach(solver, clause);
+    }
+    free(buffer);
+    return solver->ok;
+}
+
+/**
+ * @brief The @p i-th term of the Luby sequence 1 1 2 1 1 2 4 1 1 2 1 1 2 4 8 ...
+ */
+static long sat_luby(long i)
+{
+    long size = 1;
+    int power = 0;
+    while (size < i + 1)
+    {
+        power++;
+        size = 2 * size + 1;
+    }
+    while (size - 1 != i)
+    {
+        size = (size - 1) / 2;
+        power--;
+        i = i % size;
+    }
+    return 1L << power;
+}
+
+/**
+ * @brief Picks the unassigned variable of highest activity, with its saved phase.
+ * @return int The literal to decide, -1 if every variable is assigned.
+ */
+static int sat_pick_branch(SatSolver solver)
+{
+    while (solver->heap_size > 0)
+    {
+        int var = sat_heap_pop(solver);
+        if (sat_lit_get(solver, 2 * var) == 0)
+            return solver->phases[var] ? 2 * var : 2 * var + 1;
+    }
+    return -1;
+}
+
+/**
+ * @brief Searches until a model is found (1), the clauses are unsatisfiable with the assumptions (-1), or @p max_conflicts conflicts (0, to restart).
+ */
+static int sat_search(SatSolver solver, const int *assumptions, int num_assumptions, long max_conflicts)
+{
+    long conflicts = 0;
+    for (;;)
+    {
+        sat_clause *conflict = sat_propagate(solver);
+        if (conflict != NULL)
+        {
+            solver->num_conflicts++;
+            conflicts++;
+            if (solver->num_levels == 0)
+            {
+                solver->ok = false;
+                return -1;
+            }
+
+            int backtrack_level;
+            int size = sat_analyze(solver, conflict, &backtrack_level);
+            sat_backtrack(solver, backtrack_level);
+            if (size == 1)
+                sat_assign(solver, solver->learnt[0], NULL);
+            else
+            {
+                sat_clause *clause = sat_clause_create(solver->learnt, size, true);
+                clause->lbd = sat_compute_lbd(solver, solver->learnt, size);
+                sat_bump_clause(solver, clause);
+                sat_clause_list_push(&solver->learnts, clause);
+                sat_attach(solver, clause);
+                sat_assign(solver, solver->learnt[0], clause);
+            }
+            solver->var_increment /= SAT_VAR_DECAY;
+            solver->clause_increment /= SAT_CLAUSE_DECAY;
+            continue;
+        }
+
+        if (conflicts >= max_conflicts)
+        {
+            sat_backtrack(solver, 0);
+            return 0;
+        }
+
+        if (solver->num_conflicts >= solver->next_reduce)
+        {
+            solver->num_reductions++;
+            solver->next_reduce = solver->num_conflicts + SAT_REDUCE_FIRST + SAT_REDUCE_INCREMENT * solver->num_reductions;
+            sat_reduce_learnts(solver);
+        }
+
+        // les hypothèses sont décidées d'abord, une par niveau
+        int next = -1;
+        while (solver->num_levels < num_assumptions)
+        {
+            int lit = sat_import(assumptions[solver->num_levels]);
+            signed char value = sat_lit_get(solver, lit);
+            if (value == 1)
+                sat_new_level(solver);
+            else if (value == -1)
+                return -1;
+            else
+            {
+                next = lit;
+                break;
+            }
+        }
+        if (next == -1)
+        {
+            solver->num_decisions++;
+            next = sat_pick_branch(solver);
+            if (next == -1)
+                return 1;
+        }
+        sat_new_level(solver);
+        sat_assign(solver, next, NULL);
+    }
+}
+
+bool sat_solve(SatSolver solver, const int *assumptions, int num_assumptions)
+{
+    if (!solver->ok)
+        return false;
+    for (int i = 0; i < num_assumptions; i++)
+        assert(assumptions[i] != 0 && abs(assumptions[i]) <= solver->num_vars);
+
+    int result = 0;
+    for (long restart = 0; result == 0; restart++)
+    {
+        result = sat_search(solver, assumptions, num_assumptions, sat_luby(restart) * SAT_RESTART_UNIT);
+        if (result == 0)
+            solver->num_restarts++;
+    }
+
+    if (result == 1)
+        for (int var = 0; var < solver->num_vars; var++)
+            solver->model[var] = sat_lit_get(solver, 2 * var);
+    sat_backtrack(solver, 0);
+    return result == 1;
+}
+
+bool sat_value(SatSolver solver, int var)
+{
+    assert(var >= 1 && var <= solver->num_vars);
+    return solver->model[var - 1] == 1;
+}
+
+bool sat_lit_value(SatSolver solver, int lit)
+{
+    return lit > 0 ? sat_value(solver, lit) : !sat_value(solver, -lit);
+}
+
+void sat_write_dimacs(SatSolver solver, FILE *file)
+{
+    // entre deux appels à sat_solve, le trail ne contient que les littéraux fixés au niveau 0
+    int num_units = solver->trail_size;
+    long num_clauses = solver->ok ? solver->clauses.size + num_units : 1;
+    fprintf(file, "p cnf %d %ld\n", solver->num_vars, num_clauses);
+    if (!solver->ok)
+    {
+        fprintf(file, "0\n");
+        return;
+    }
+    for (int i = 0; i < num_units; i++)
+        fprintf(file, "%d 0\n", sat_export(solver->trail[i]));
+    for (long i = 0; i < solver->clauses.size; i++)
+    {
+        sat_clause *clause = solver->clauses.clauses[i];
+        for (int k = 0; k < clause->size; k++)
+            fprintf(file, "%d ", sat_export(clause->lits[k]));
+        fprintf(file, "0\n");
+    }
+}
+
+int sat_get_num_vars(SatSolver solver)
+{
+    return solver->num_vars;
+}
+
+long sat_get_num_clauses(SatSolver solver)
+{
+    return solver->clauses.size;
+}
+
+long sat_get_num_learnts(SatSolver solver)
+{
+    return solver->learnts.size;
+}
+
+long sat_get_num_conflicts(SatSolver solver)
+{
+    return solver->num_conflicts;
+}
+
+long sat_get_num_decisions(SatSolver solver)
+{
+    return solver->num_decisions;
+}
+
+long sat_get_num_propagations(SatSolver solver)
+{
+    return solver->num_propagations;
+}
+
+long sat_get_num_restarts(SatSolver solver)
+{
+    return solver->num_restarts;
+}
@@ -56,6 +56,45 @@ Z3_ast uniqueFormula(Z3_context ctx, Z3_ast *formulae, int size)
     return Z3_mk_and(ctx, count + 1, result);
 }
 
+Z3_ast at_most_one_sequential_formula(Z3_context ctx, Z3_ast *formulae, int size)
+{
+    if (size <= 1)
+        return Z3_mk_true(ctx);
+
+    // counter[i] is true iff one of formulae[0..i] is true
+    Z3_sort bool_sort = Z3_mk_bool_sort(ctx);
+    Z3_ast *counter = malloc((size - 1) * sizeof(Z3_ast));
+    Z3_ast *result = malloc(3 * size * sizeof(Z3_ast));
+    int count = 0;
+    for (int i = 0; i < size - 1; i++)
+        counter[i] = Z3_mk_fresh_const(ctx, "amo", bool_sort);
+
+    for (int i = 0; i < size; i++)
+    {
+        if (i < size - 1)
+            result[count++] = Z3_mk_implies(ctx, formulae[i], counter[i]);
+        if (i > 0)
+        {
+            result[count++] = Z3_mk_implies(ctx, formulae[i], Z3_mk_not(ctx, counter[i - 1]));
+            if (i < size - 1)
+                result[count++] = Z3_mk_implies(ctx, counter[i - 1], counter[i]);
+        }
+    }
+
+    Z3_ast formula = Z3_mk_and(ctx, count, result);
+    free(counter);
+    free(result);
+    return formula;
+}
+
+Z3_ast unique_sequential_formula(Z3_context ctx, Z3_ast *formulae, int size)
+{
+    Z3_ast result[2];
+    result[0] = Z3_mk_or(ctx, size, formulae);
+    result[1] = at_most_one_sequential_formula(ctx, formulae, size);
+    return Z3_mk_and(ctx, 2, result);
+}
+
 Z3_lbool is_formula_sat(Z3_context ctx, Z3_ast formula)
 {
     Z3_solver s = Z3_mk_solver(ctx);
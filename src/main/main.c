@@ -12,6 +12,7 @@
 #include "Graph.h"
 #include "Parsing.h"
 #include "Z3Tools.h"
+#include "CNF.h"
 #include "Parser.h"
 #ifdef REPARTITION
 #include "RepartitionGraph.h"
@@ -31,7 +32,16 @@
 #ifdef TUNNEL
 #include "TunnelNetwork.h"
 #include "TunnelBF.h"
+#include "TunnelBFS.h"
+#include "TunnelMeet.h"
+#include "TunnelSymbolic.h"
+#include "TunnelCount.h"
+#include "TunnelBatch.h"
+#include "TunnelReach.h"
+#include "TunnelSummary.h"
+#include "TunnelPrune.h"
 #include "TunnelReduction.h"
+#include "TunnelCNF.h"
 #endif
 #include <stdio.h>
 #include <stdlib.h>
@@ -90,7 +100,20 @@ void usage()
     printf("\n");
     printf(" -v         Activate verbose mode (displays parsed graphs)\n");
     printf(" -B         Solves the problem using the brute force algorithm\n");
+#ifdef TUNNEL
+    printf(" -A ENGINE  Tunnel only: algorithm used by -B. \"dfs\" (default) explores the paths one by one, \"bfs\" expands the configurations (node, stack) position by position without duplicates and finds a shortest path, \"bidir\" searches the configurations both forward from the initial node and backward from the final node until they meet in the middle and finds a shortest path, \"summary\" computes the push/pop summaries of the network in polynomial time, lists all the sizes at most VAL of valid paths and gives a shortest path, \"all\" lists the same sizes with a single traversal of the paths explored by \"dfs\" and gives the first shortest path it meets, \"bdd\" expands the sets of configurations layer by layer as BDDs and finds a shortest path.\n");
+    printf(" -C         Tunnel only: counts the valid paths of each size at most VAL (two paths differ if one of their steps does), without listing them. When the tables of all the pairs of nodes fit in memory, the paths are counted over the push/pop summaries of the network, in polynomial time whatever the stacks. Otherwise, the paths reaching the same configuration (node, stack) at a position are merged, and the number of configurations may grow exponentially with VAL. The counts saturate at 2^128-1.\n");
+    printf(" -K N       Tunnel only: enumerates the first N distinct valid paths of size at most VAL, by increasing size, and prints each of them as soon as it is found. With -R, the paths come from the incremental solver, each path found being forbidden before the next call, otherwise from the exploration of \"dfs\". -B and -R then do nothing else.\n");
+    printf(" -J FILE    Tunnel only: with -K, also writes the paths in FILE, one JSON object per line.\n");
+    printf(" -Q FILE    Tunnel only: answers the questions of FILE, one per line as \"INITIAL FINAL SIZE\" (node names and max size of the path), on the network given as input. The questions with the same initial node are answered with a single exploration of the configurations (node, stack) reachable from it. Gives a shortest valid path for each question, displayed with -t.\n");
+    printf(" -O         Tunnel only: one-to-all mode. Explores once the configurations (node, stack) reachable from the initial node in at most VAL steps, and gives for every node the smallest size of a valid path from the initial node to it (ending with the stack [4]), the nodes drawn as final nodes being marked as egress. The paths are displayed with -t.\n");
+    printf(" -j N       Tunnel only: runs the \"dfs\" engine of -B on N threads. The path found is the same as with a single thread.\n");
+#endif
     printf(" -R         Solves the problem using a reduction\n");
+    printf(" -S SOLVER  Solver used by -R. \"z3\" (default) builds the formula of the reduction and gives it to Z3, \"builtin\" writes the reduction directly as clauses of the CDCL solver of this program (with -F, the clauses are written in the DIMACS format).\n");
+#ifdef TUNNEL
+    printf(" -I         Tunnel only: with -R, uses a single incremental solver for all the sizes instead of a new formula per size. The constraints of each position are added once, and the final condition of each size is checked as an assumption.\n");
+#endif
     printf(" -F         Displays the formula computed ");
 #ifdef SUBJECT
     printf("(obviously not in this version)");
@@ -99,9 +122,52 @@ void usage()
     printf(" -M         Displays the model of the satisfied formula, to help understanding why it is true, especially when there are variables not representing a part of the solution.\n");
     printf(" -t         Displays the solution found [if not present, only displays the existence of the solution].\n");
     printf(" -f         Writes the result with colors in a .dot file. See next option for the name. These files will be produced in the folder 'sol'.\n");
+    printf(" -s FILE    Writes the (first) input in the binary snapshot format in FILE. A snapshot can be given instead of a .dot file as input, which avoids parsing it again. For the Tunnel problem, the actions of the nodes are stored in the snapshot.\n");
+#ifdef TUNNEL
+    printf(" -E ENC     Tunnel only: encoding of the \"one node and one height per position\" constraints of the reduction. \"pairwise\" (default) excludes the pairs of (node, height) couples, \"factored\" uses separate node and height variables with linear at-most-one constraints.\n");
+#endif
     printf(" -o NAME    Writes the output graph in \"NAME_Brute.dot\" or \"NAME_SAT.dot\" depending of the algorithm used and the formula in \"NAME.formula\". [if not present: \"default_SAT.dot\", \"default_Brute.dot\" and \"default.formula\"]\n");
 }
 
+#ifdef TUNNEL
+/**
+ * @brief What the paths enumerated with -K are given to.
+ *
+ */
+typedef struct
+{
+    TunnelNetwork network; ///< The network given as input.
+    TunnelPruning pruning; ///< The pruning of network, on which the paths are found.
+    char *engine;          ///< The name of the back end, written in the JSON lines.
+    FILE *json;            ///< The file of the JSON lines (NULL if none).
+    int num_routes;        ///< The number of paths received.
+} tn_routes;
+
+/**
+ * @brief Prints the path found by an enumeration (on the pruned network), and writes it in the JSON lines if asked.
+ */
+static bool tn_print_route(tn_step *path, int size_path, void *data)
+{
+    tn_routes *routes = (tn_routes *)data;
+    tn_step route[size_path];
+    memcpy(route, path, size_path * sizeof(tn_step));
+    tn_pruning_restore_path(routes->pruning, route, size_path);
+    routes->num_routes++;
+
+    printf("Route %d (size %d): ", routes->num_routes, size_path);
+    tn_print_path(routes->network, route, size_path);
+    fflush(stdout);
+    if (routes->json != NULL)
+    {
+        fprintf(routes->json, "{\"route\": %d, \"engine\": \"%s\", \"path\": ", routes->num_routes, routes->engine);
+        tn_fprint_path_json(routes->json, routes->network, route, size_path);
+        fprintf(routes->json, "}\n");
+        fflush(routes->json);
+    }
+    return true;
+}
+#endif
+
 enum problemType
 {
     Repartition,
@@ -125,15 +191,26 @@ int main(int argc, char *argv[])
     bool printformula = false;
     bool bruteForce = false;
     bool reduction = false;
+    bool incremental = false;
+    bool counting = false;
+    bool oneToAll = false;
     bool printModel = false;
     char *problem_parameter = "";
     char *solutionName = "default";
+    char *snapshotName = NULL;
+    char *encodingName = "pairwise";
+    char *engineName = "dfs";
+    char *solverName = "z3";
+    int numThreads = 1;
+    int numRoutes = 0;
+    char *routesName = NULL;
+    char *queriesName = NULL;
     /*char *realArgs[argc];
     int numArgs = 0;*/
 
     int option;
 
-    while ((option = getopt(argc, argv, ":hP:c:vFBGRMtfo:")) != -1)
+    while ((option = getopt(argc, argv, ":hP:c:vFBGRIMCOtfo:s:E:A:S:j:K:J:Q:")) != -1)
     {
         switch (option)
         {
@@ -165,6 +242,15 @@ int main(int argc, char *argv[])
         case 'R':
             reduction = true;
             break;
+        case 'I':
+            incremental = true;
+            break;
+        case 'C':
+            counting = true;
+            break;
+        case 'O':
+            oneToAll = true;
+            break;
         case 'F':
             // printf("Don't insist, I'm not showing you the solution of the assignment yet!\n");
             printformula = true;
@@ -181,6 +267,30 @@ int main(int argc, char *argv[])
         case 'o':
             solutionName = optarg;
             break;
+        case 's':
+            snapshotName = optarg;
+            break;
+        case 'E':
+            encodingName = optarg;
+            break;
+        case 'A':
+            engineName = optarg;
+            break;
+        case 'S':
+            solverName = optarg;
+            break;
+        case 'j':
+            numThreads = atoi(optarg);
+            break;
+        case 'K':
+            numRoutes = atoi(optarg);
+            break;
+        case 'J':
+            routesName = optarg;
+            break;
+        case 'Q':
+            queriesName = optarg;
+            break;
         case '?':
             printf("unknown option: %c\n", optopt);
             break;
@@ -193,6 +303,10 @@ int main(int argc, char *argv[])
         return 0;
     }
 
+    bool builtinSolver = strcmp(solverName, "builtin") == 0;
+    if (!builtinSolver && strcmp(solverName, "z3") != 0)
+        printf("Unknown solver %s, using z3.\n", solverName);
+
     int num_graphs = argc - optind;
     Graph graphs[argc - optind];
     for (int i = optind; i < argc; i++)
@@ -339,6 +453,14 @@ int main(int argc, char *argv[])
 
         ColouredGraph coloured_graph = cg_initialize(graph);
 
+        if (snapshotName != NULL)
+        {
+            if (graph_save_snapshot(graph, NULL, snapshotName))
+                printf("Snapshot written in %s.\n", snapshotName);
+            else
+                printf("Could not write snapshot %s.\n", snapshotName);
+        }
+
         if (verbose)
             cg_print(coloured_graph);
 
@@ -367,7 +489,65 @@ int main(int argc, char *argv[])
                 printf("There is no %d-colouring of this graph.\n", num_colours);
         }
 
-        if (reduction)
+        if (reduction && builtinSolver)
+        {
+            printf("\n************************\n*** Reduction to SAT ***\n************************\n\n");
+
+            clock_t start = clock();
+
+            SatSolver solver = cnf_create_solver();
+            int first_variable = colouring_reduction_cnf(solver, coloured_graph, num_colours);
+
+            clock_t timeFormula = clock();
+
+            printf("clauses computed in %g seconds (%d variables, %ld clauses)\n", (double)(timeFormula - start) / CLOCKS_PER_SEC, sat_get_num_vars(solver), sat_get_num_clauses(solver));
+
+            if (printformula)
+            {
+                struct stat st = {0};
+                if (stat("./sol", &st) == -1)
+                    mkdir("./sol", 0777);
+                int length = strlen(solutionName) + 9;
+                char nameFile[length];
+                snprintf(nameFile, length, "sol/%s.cnf", solutionName);
+                FILE *file = fopen(nameFile, "w");
+                sat_write_dimacs(solver, file);
+                fclose(file);
+                printf("Clauses printed in sol/%s.cnf\n", solutionName);
+            }
+
+            bool isSat = sat_solve(solver, NULL, 0);
+
+            clock_t timeSat = clock();
+
+            printf("solution computed in %g seconds (%ld conflicts)\n", (double)(timeSat - timeFormula) / CLOCKS_PER_SEC, sat_get_num_conflicts(solver));
+
+            if (isSat)
+            {
+                printf("There is a %d-colouring of this graph.\n", num_colours);
+
+                if (displayTerminal || outputFile)
+                    colour_graph_from_solver(solver, first_variable, coloured_graph, num_colours);
+                if (displayTerminal)
+                    cg_print_colors(coloured_graph);
+                if (printModel)
+                    colouring_print_solver_model(solver, first_variable, coloured_graph, num_colours);
+                if (outputFile)
+                {
+                    int length = strlen(solutionName) + 12;
+                    char nameFile[length];
+                    snprintf(nameFile, length, "%s_Sat", solutionName);
+                    cg_create_dot(coloured_graph, nameFile);
+                    printf("Solution printed in sol/%s.dot.\n", nameFile);
+                }
+            }
+            else
+                printf("No %d-colouring of this graph is possible\n", num_colours);
+
+            sat_delete(solver);
+        }
+
+        if (reduction && !builtinSolver)
         {
             printf("\n************************\n*** Reduction to SAT ***\n************************\n\n");
 
@@ -596,6 +776,62 @@ int main(int argc, char *argv[])
             tn_print(network);
         }
 
+        if (snapshotName != NULL)
+        {
+            if (tn_save_snapshot(network, snapshotName))
+                printf("Snapshot written in %s.\n", snapshotName);
+            else
+                printf("Could not write snapshot %s.\n", snapshotName);
+        }
+
+        if (queriesName != NULL)
+        {
+            printf("\n*********************\n*** Batch Queries ***\n*********************\n\n");
+            tn_query *queries;
+            int numQueries = tn_batch_read_queries(network, queriesName, &queries);
+            if (numQueries < 0)
+                printf("Could not open %s.\n", queriesName);
+            else if (numQueries == 0)
+            {
+                printf("No query read from %s.\n", queriesName);
+                free(queries);
+            }
+            else
+            {
+                printf("%d queries read from %s.\n", numQueries, queriesName);
+                clock_t start = clock();
+                int *results = malloc(numQueries * sizeof(int));
+                tn_step **paths = malloc(numQueries * sizeof(tn_step *));
+                for (int q = 0; q < numQueries; q++)
+                    paths[q] = malloc(queries[q].length * sizeof(tn_step));
+                int numExplorations = tn_batch_solve(network, queries, numQueries, results, paths);
+                double end = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+                for (int q = 0; q < numQueries; q++)
+                {
+                    printf("Query %d (%s -> %s, size at most %d): ", q + 1, tn_get_node_name(network, queries[q].initial), tn_get_node_name(network, queries[q].final), queries[q].length);
+                    if (results[q] > 0)
+                    {
+                        printf("There is a simple path of size %d.\n", results[q]);
+                        if (displayTerminal)
+                            tn_print_path(network, paths[q], results[q]);
+                    }
+                    else
+                        printf("There is no simple path of size at most %d.\n", queries[q].length);
+                    free(paths[q]);
+                }
+                printf("%d queries answered with %d explorations in %g seconds.\n", numQueries, numExplorations, end);
+                free(results);
+                free(paths);
+                free(queries);
+            }
+        }
+
+        // the solvers work on the network without the nodes that cannot be on a path, the paths found are translated back
+        TunnelPruning pruning = tn_prune(network);
+        TunnelNetwork reduced = tn_pruning_get_network(pruning);
+        printf("Pruning removed %d nodes, %d edges and %d actions (%d nodes and %d edges left).\n", tn_pruning_get_num_removed_nodes(pruning), tn_pruning_get_num_removed_edges(pruning), tn_pruning_get_num_removed_actions(pruning), tn_get_num_nodes(reduced), tn_get_num_edges(reduced));
+
         int bound = 10;
         if (strcmp(problem_parameter, "") != 0)
             bound = atoi(problem_parameter);
@@ -606,17 +842,136 @@ int main(int argc, char *argv[])
             path[step] = tn_step_empty();
         }
 
-        if (bruteForce)
+        // every engine starts from the initial node, which a network without nodes does not have
+        if (tn_get_num_nodes(network) == 0)
+        {
+            printf("The network has no node.\nThere is no simple path of size at most %d.\n", bound);
+            numRoutes = 0;
+            bruteForce = false;
+            oneToAll = false;
+            counting = false;
+            reduction = false;
+        }
+
+        if (numRoutes > 0)
+        {
+            printf("\n**************\n*** Routes ***\n**************\n\n");
+            tn_routes routes = {network, pruning, reduction ? "sat" : "search", NULL, 0};
+            if (routesName != NULL)
+            {
+                routes.json = fopen(routesName, "w");
+                if (routes.json == NULL)
+                    printf("Could not open %s, the routes are not written in it.\n", routesName);
+            }
+
+            clock_t start = clock();
+            int numFound = 0;
+            if (reduction && bound >= 1)
+            {
+                tn_encoding encoding = tn_pairwise_encoding;
+                if (strcmp(encodingName, "factored") == 0)
+                    encoding = tn_factored_encoding;
+                else if (strcmp(encodingName, "pairwise") != 0)
+                    printf("Unknown encoding %s, using pairwise.\n", encodingName);
+
+                if (builtinSolver)
+                {
+                    TunnelCNF cnf = tn_cnf_incremental_create(reduced, bound, encoding);
+                    numFound = tn_cnf_enumerate(cnf, numRoutes, tn_print_route, &routes);
+                    tn_cnf_delete(cnf);
+                }
+                else
+                {
+                    Z3_context ctx = make_context();
+                    TunnelIncremental incremental_solver = tn_incremental_create(ctx, reduced, bound, encoding);
+                    numFound = tn_incremental_enumerate(ctx, incremental_solver, numRoutes, tn_print_route, &routes);
+                    tn_incremental_delete(ctx, incremental_solver);
+                    Z3_del_context(ctx);
+                }
+            }
+            else if (!reduction)
+                numFound = tn_brute_force_enumerate(reduced, bound, numRoutes, tn_print_route, &routes);
+
+            printf("%d distinct valid paths of size at most %d found in %g seconds.\n", numFound, bound, (double)(clock() - start) / CLOCKS_PER_SEC);
+            if (routes.json != NULL)
+            {
+                fclose(routes.json);
+                printf("Routes written in %s.\n", routesName);
+            }
+        }
+
+        if (bruteForce && numRoutes == 0)
         {
             printf("\n*******************\n*** Brute Force ***\n*******************\n\n");
 #ifndef SUBJECT
             clock_t start = clock();
-            int res = tn_brute_force(network, bound, path);
+            int res;
+            if (strcmp(engineName, "bfs") == 0)
+                res = tn_bfs(reduced, bound, path);
+            else if (strcmp(engineName, "bidir") == 0)
+                res = tn_meet_in_the_middle(reduced, bound, path);
+            else if (strcmp(engineName, "bdd") == 0)
+            {
+                res = tn_symbolic_solve(reduced, bound, path);
+                int peakNodes;
+                double numConfigurations;
+                tn_symbolic_get_stats(&peakNodes, &numConfigurations);
+                printf("BDD: at most %d nodes, %g configurations reached.\n", peakNodes, numConfigurations);
+            }
+            else if (strcmp(engineName, "all") == 0)
+            {
+                tn_step *witnesses[bound + 1];
+                bool found[bound + 1];
+                for (int l = 1; l <= bound; l++)
+                    witnesses[l] = malloc(l * sizeof(tn_step));
+                res = tn_brute_force_all_lengths(reduced, bound, witnesses, found);
+                printf("Sizes of the valid paths:");
+                for (int l = 1; l <= bound; l++)
+                    if (found[l])
+                        printf(" %d", l);
+                printf("\n");
+                long distanceCuts, stackCuts;
+                tn_brute_force_get_cuts(&distanceCuts, &stackCuts);
+                printf("Subtrees cut: %ld (final node too far), %ld (stack too high).\n", distanceCuts, stackCuts);
+                if (res > 0)
+                    memcpy(path, witnesses[res], res * sizeof(tn_step));
+                for (int l = 1; l <= bound; l++)
+                    free(witnesses[l]);
+            }
+            else if (strcmp(engineName, "summary") == 0)
+            {
+                TunnelSummary summary = tn_summary_create(reduced, bound);
+                res = 0;
+                printf("Sizes of the valid paths:");
+                for (int l = 1; l <= bound; l++)
+                {
+                    if (!tn_summary_has_path(summary, l))
+                        continue;
+                    printf(" %d", l);
+                    if (res == 0)
+                    {
+                        tn_summary_get_path(summary, l, path);
+                        res = l;
+                    }
+                }
+                printf("\n");
+                tn_summary_delete(summary);
+            }
+            else
+            {
+                if (strcmp(engineName, "dfs") != 0)
+                    printf("Unknown engine %s, using dfs.\n", engineName);
+                res = tn_brute_force_parallel(reduced, bound, path, numThreads);
+                long distanceCuts, stackCuts;
+                tn_brute_force_get_cuts(&distanceCuts, &stackCuts);
+                printf("Subtrees cut: %ld (final node too far), %ld (stack too high).\n", distanceCuts, stackCuts);
+            }
             double end = (double)(clock() - start) / CLOCKS_PER_SEC;
             printf("Brute force computed the solution in %g seconds:\n", end);
             if (res > 0)
             {
                 printf("There is a simple path of size %d.\n", res);
+                tn_pruning_restore_path(pruning, path, res);
                 if (displayTerminal)
                     tn_print_path(network, path, res);
                 if (outputFile)
@@ -635,11 +990,77 @@ int main(int argc, char *argv[])
 #endif
         }
 
-        if (reduction)
+        if (oneToAll)
+        {
+            printf("\n******************\n*** One-to-all ***\n******************\n\n");
+            // the pruning keeps only what leads to the final node, the exploration is done on the whole network
+            clock_t start = clock();
+            TunnelReach reach = tn_reach_create(network, tn_get_initial(network), bound);
+            printf("%d configurations explored in %g seconds.\n", tn_reach_get_num_configurations(reach), (double)(clock() - start) / CLOCKS_PER_SEC);
+
+            int numNodes = tn_get_num_nodes(network);
+            bool egress[numNodes];
+            memset(egress, 0, sizeof(egress));
+            for (int i = 0; i < tn_get_num_finals(network); i++)
+                egress[tn_get_finals(network)[i]] = true;
+            int numReached = 0;
+            tn_step route[bound > 0 ? bound : 1];
+            for (int node = 0; node < numNodes; node++)
+            {
+                int size = tn_reach_get_length(reach, node);
+                if (size == 0)
+                {
+                    if (egress[node])
+                        printf("%s (egress): no valid path of size at most %d.\n", tn_get_node_name(network, node), bound);
+                    continue;
+                }
+                numReached++;
+                printf("%s%s: smallest valid path of size %d.\n", tn_get_node_name(network, node), egress[node] ? " (egress)" : "", size);
+                if (displayTerminal)
+                {
+                    tn_reach_get_path(reach, node, route);
+                    tn_print_path(network, route, size);
+                }
+            }
+            printf("%d nodes reached with the stack [4] from %s in at most %d steps.\n", numReached, tn_get_node_name(network, tn_get_initial(network)), bound);
+            tn_reach_delete(reach);
+        }
+
+        if (counting)
+        {
+            printf("\n*********************\n*** Path Counting ***\n*********************\n\n");
+            clock_t start = clock();
+            tn_count counts[bound + 1];
+            tn_count_paths(reduced, bound, counts);
+            printf("Paths counted in %g seconds:\n", (double)(clock() - start) / CLOCKS_PER_SEC);
+            for (int l = 1; l <= bound; l++)
+            {
+                char number[TN_COUNT_STRING_SIZE];
+                printf("size %d: %s%s valid paths\n", l, counts[l] == TN_COUNT_MAX ? "at least " : "", tn_count_to_string(counts[l], number));
+            }
+        }
+
+        if (reduction && numRoutes == 0)
         {
             printf("\n************************\n*** Reduction to SAT ***\n************************\n\n");
 
-            Z3_context ctx = make_context();
+            tn_encoding encoding = tn_pairwise_encoding;
+            if (strcmp(encodingName, "factored") == 0)
+                encoding = tn_factored_encoding;
+            else if (strcmp(encodingName, "pairwise") != 0)
+                printf("Unknown encoding %s, using pairwise.\n", encodingName);
+
+            Z3_context ctx = builtinSolver ? NULL : make_context();
+
+            TunnelIncremental incremental_solver = NULL;
+            TunnelCNF incremental_cnf = NULL;
+            if (incremental && bound >= 1)
+            {
+                if (builtinSolver)
+                    incremental_cnf = tn_cnf_incremental_create(reduced, bound, encoding);
+                else
+                    incremental_solver = tn_incremental_create(ctx, reduced, bound, encoding);
+            }
 
             for (int l = 1; l <= bound; l++)
             {
@@ -647,12 +1068,29 @@ int main(int argc, char *argv[])
 
                 clock_t start = clock();
 
-                Z3_ast formula;
-                formula = tn_reduction(ctx, network, l);
+                TunnelVariables variables = NULL;
+                TunnelCNF cnf = NULL;
+                Z3_ast formula = NULL;
+                if (builtinSolver)
+                {
+                    cnf = incremental_cnf != NULL ? incremental_cnf : tn_cnf_create(reduced, l, encoding);
+                    tn_cnf_add_length(cnf, l);
+                }
+                else if (incremental_solver != NULL)
+                    formula = tn_incremental_add_length(ctx, incremental_solver, l);
+                else
+                {
+                    variables = tn_variables_create(ctx, reduced, l, encoding);
+                    formula = tn_reduction_with_variables(ctx, variables);
+                }
 
                 clock_t timeFormula = clock();
 
                 printf("formula for size %d computed in %g seconds\n", l, (double)(timeFormula - start) / CLOCKS_PER_SEC);
+                if (verbose && variables != NULL)
+                    printf("%ld variables created for size %d\n", tn_variables_get_num_variables(variables), l);
+                if (verbose && cnf != NULL)
+                    printf("%d variables and %ld clauses in the solver for size %d\n", sat_get_num_vars(tn_cnf_get_solver(cnf)), sat_get_num_clauses(tn_cnf_get_solver(cnf)), l);
 
                 if (printformula)
                 {
@@ -660,24 +1098,35 @@ int main(int argc, char *argv[])
                     struct stat st = {0};
                     if (stat("./sol", &st) == -1)
                         mkdir("./sol", 0777);
-                    int length = strlen(solutionName) + 13;
+                    int length = strlen(solutionName) + 24;
                     char nameFile[length];
-                    snprintf(nameFile, length, "sol/%s_%d.formula", solutionName, l);
+                    snprintf(nameFile, length, "sol/%s_%d.%s", solutionName, l, cnf != NULL ? "cnf" : "formula");
                     FILE *file = fopen(nameFile, "w");
-                    fprintf(file, "%s\n", Z3_ast_to_string(ctx, formula));
+                    if (cnf != NULL)
+                        sat_write_dimacs(tn_cnf_get_solver(cnf), file);
+                    else
+                        fprintf(file, "%s\n", Z3_ast_to_string(ctx, formula));
                     fclose(file);
-                    printf("Formula for size %d printed in sol/%s_%d.formula\n", l, solutionName, l);
+                    printf("Formula for size %d printed in %s\n", l, nameFile);
 #else
                     printf("Nah, I'm not displaying the formula in the given executable\n");
 #endif
                 }
 
-                Z3_model model;
-                Z3_lbool isSat = solve_formula(ctx, formula, &model);
+                Z3_model model = NULL;
+                Z3_lbool isSat;
+                if (cnf != NULL)
+                    isSat = tn_cnf_solve(cnf, l) ? Z3_L_TRUE : Z3_L_FALSE;
+                else if (incremental_solver != NULL)
+                    isSat = tn_incremental_solve(ctx, incremental_solver, l, &model);
+                else
+                    isSat = solve_formula(ctx, formula, &model);
 
                 clock_t timeSat = clock();
 
                 printf("solution computed in %g seconds\n", (double)(timeSat - timeFormula) / CLOCKS_PER_SEC);
+                if (verbose && cnf != NULL)
+                    printf("%ld conflicts, %ld decisions, %ld restarts so far\n", sat_get_num_conflicts(tn_cnf_get_solver(cnf)), sat_get_num_decisions(tn_cnf_get_solver(cnf)), sat_get_num_restarts(tn_cnf_get_solver(cnf)));
 
                 switch (isSat)
                 {
@@ -693,16 +1142,37 @@ int main(int argc, char *argv[])
                     printf("There is a simple path of size %d.\n", l);
 
                     if (!(displayTerminal || outputFile || printModel))
+                    {
+                        if (cnf == NULL && model != NULL)
+                            Z3_model_dec_ref(ctx, model);
+                        if (variables != NULL)
+                            tn_variables_delete(variables);
+                        if (cnf != NULL && cnf != incremental_cnf)
+                            tn_cnf_delete(cnf);
                         goto TN_end;
+                    }
 
-                    tn_get_path_from_model(ctx, model, network, l, path);
+                    if (cnf != NULL)
+                        tn_cnf_get_path(cnf, l, path);
+                    else if (incremental_solver != NULL)
+                        tn_incremental_get_path(ctx, model, incremental_solver, l, path);
+                    else
+                        tn_get_path_from_variables(ctx, model, variables, path);
+                    tn_pruning_restore_path(pruning, path, l);
 
                     if (displayTerminal)
                     {
                         tn_print_path(network, path, l);
                     }
                     if (printModel)
-                        tn_print_model(ctx, model, network, l);
+                    {
+                        if (cnf != NULL)
+                            tn_cnf_print_model(cnf, l);
+                        else if (incremental_solver != NULL)
+                            tn_incremental_print_model(ctx, model, incremental_solver, l);
+                        else
+                            tn_print_model_from_variables(ctx, model, variables);
+                    }
 
                     if (outputFile)
                     {
@@ -713,14 +1183,30 @@ int main(int argc, char *argv[])
                         printf("Solution printed in sol/%s.dot.\n", nameFile);
                     }
 
+                    if (cnf == NULL && model != NULL)
+                        Z3_model_dec_ref(ctx, model);
+                    if (variables != NULL)
+                        tn_variables_delete(variables);
+                    if (cnf != NULL && cnf != incremental_cnf)
+                        tn_cnf_delete(cnf);
                     goto TN_end;
                 }
+                if (variables != NULL)
+                    tn_variables_delete(variables);
+                if (cnf != NULL && cnf != incremental_cnf)
+                    tn_cnf_delete(cnf);
             }
 
         TN_end:
-            Z3_del_context(ctx);
+            if (incremental_solver != NULL)
+                tn_incremental_delete(ctx, incremental_solver);
+            if (incremental_cnf != NULL)
+                tn_cnf_delete(incremental_cnf);
+            if (ctx != NULL)
+                Z3_del_context(ctx);
         }
 
+        tn_pruning_delete(pruning);
         tn_delete(network);
     }
 #endif
@@ -152,18 +152,18 @@ idrhs : T_ID        { $$ = (char*)malloc((strlen($1)+1)*sizeof(char)); strcpy($$
 
 node_stmt : node_id         { free($1); }
     | node_id attr_list     {   
-                                add_parameters_to_node($1,$2.parameters,graph->nodes);
+                                node_table_add_parameters(graph->node_table,$1,$2.parameters);
                                 free($1);
                             }
     ;
 
 node_id : T_ID      { 
                       $$ = (char*)malloc((strlen($1)+1)*sizeof(char)); strcpy($$,$1);
-                      if(graph->nodes == NULL) graph->nodes = addNode($1,NULL); else addOrUpdateNode($1,graph->nodes);
+                      node_table_add_node(graph->node_table,$1,&graph->nodes);
                     }
     | T_ID port     { 
                       $$ = (char*)malloc((strlen($1)+1)*sizeof(char)); strcpy($$,$1);
-                      if(graph->nodes == NULL) graph->nodes = addNode($1,NULL); else addOrUpdateNode($1,graph->nodes);
+                      node_table_add_node(graph->node_table,$1,&graph->nodes);
                     }
     ;
 
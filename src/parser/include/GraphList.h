@@ -14,6 +14,7 @@
 
 #include "EdgeList.h"
 #include "NodeList.h"
+#include "NodeTable.h"
 
 /**
  * @brief The EdgeList structure. Contains a list of nodes and a list of edges.
@@ -24,6 +25,7 @@ typedef struct tagGraphList
 	SNodeList *nodes;
     SEdgeList *edges;
     bool directed;
+    NodeTable *node_table; ///< Index of the names of nodes, shared between the parser and createGraph.
 } GraphList;
 
 
@@ -18,6 +18,7 @@
 
 /**
  * @brief Creates a Graph object from a GraphList. Does NOT free the source, so it must be destroyed independently.
+ * If the GraphList has a node table, it is used to find the ends of edges in constant time.
  * 
  * @param source the GraphList to reinterpret as a graph.
  * @return Graph the graph corresponding to the source.
@@ -0,0 +1,71 @@
+/**
+ * @file NodeTable.h
+ * @brief  Open-addressing hash table associating the name of a node to its index in a node list. Used during parsing so that finding a node is done in constant time, and by createGraph to number the ends of edges.
+ * @version 1
+ * @date 2026-10-17
+ *
+ * @copyright Creative Commons.
+ *
+ */
+
+#ifndef COCA_NODETABLE_H_
+#define COCA_NODETABLE_H_
+
+#include "NodeList.h"
+
+/**
+ * @brief The NodeTable structure. Indices are given in order of insertion, which is also the order of the cells in the indexed node list.
+ */
+typedef struct
+{
+    char **keys;        ///< The names stored in each slot (NULL if the slot is empty). The names belong to the cells of the node list.
+    int *indices;       ///< The index associated with the name of each slot.
+    int capacity;       ///< The number of slots (always a power of two).
+    int size;           ///< The number of names stored.
+    SNodeList **cells;  ///< The cell of the node list associated with each index.
+    int cells_capacity; ///< The allocated size of cells.
+} NodeTable;
+
+/**
+ * @brief Creates an empty table.
+ *
+ * @return NodeTable* The table, to be freed with node_table_delete.
+ */
+NodeTable *node_table_create(void);
+
+/**
+ * @brief Returns the index of @p name in @p table.
+ *
+ * @param table A table.
+ * @param name The name of a node.
+ * @return int The index of @p name, or -1 if it is not present.
+ */
+int node_table_find(NodeTable *table, const char *name);
+
+/**
+ * @brief If @p name is present in @p table, does nothing. Otherwise, adds a node named @p name at the end of @p list and registers it in @p table.
+ *
+ * @param table The table indexing @p list.
+ * @param name The name of the node.
+ * @param list A pointer to the node list (modified if it is empty).
+ * @return int The index of @p name.
+ */
+int node_table_add_node(NodeTable *table, char *name, SNodeList **list);
+
+/**
+ * @brief Adds the parameter list @p parameters to the node @p name if it is present in @p table.
+ *
+ * @param table The table indexing the node list.
+ * @param name The name of the node.
+ * @param parameters The list of parameters to add to the node.
+ */
+void node_table_add_parameters(NodeTable *table, char *name, parameterList *parameters);
+
+/**
+ * @brief Deletes a table. Does NOT delete the node list it indexes.
+ *
+ * @param table The table.
+ */
+void node_table_delete(NodeTable *table);
+
+#endif /* COCA_NODETABLE_H_ */
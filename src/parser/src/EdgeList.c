@@ -56,26 +56,23 @@ SEdgeList *addEdge(char *n1, char *n2, SEdgeList *list, parameterList *parameter
 
 void printEdgeList(SEdgeList *e)
 {
-    if (e == NULL)
-    {
-        printf("\n");
-        return;
-    }
-    printf("(%s,%s) -- ", e->node1, e->node2);
-    printEdgeList(e->next);
+    for (; e != NULL; e = e->next)
+        printf("(%s,%s) -- ", e->node1, e->node2);
+    printf("\n");
 }
 
 void deleteExpression(SEdgeList *b)
 {
-    if (b == NULL)
-        return;
-
-    deleteExpression(b->next);
+    while (b != NULL)
+    {
+        SEdgeList *next = b->next;
 
-    free(b->node1);
-    free(b->node2);
+        free(b->node1);
+        free(b->node2);
 
-    parameter_list_delete(b->parameters);
+        parameter_list_delete(b->parameters);
 
-    free(b);
+        free(b);
+        b = next;
+    }
 }
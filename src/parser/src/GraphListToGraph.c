@@ -1,6 +1,7 @@
 #include "GraphListToGraph.h"
 #include "EdgeList.h"
 #include "NodeList.h"
+#include "NodeTable.h"
 #include <stdlib.h>
 #include <string.h>
 
@@ -22,6 +23,90 @@ int findNode(char **list, int size, char *target)
 	return -1;
 }
 
+/**
+ * @brief An edge of the source GraphList, once its ends have been translated into node indices.
+ */
+typedef struct
+{
+	int source;				   ///< Index of the source node.
+	int target;				   ///< Index of the target node.
+	int rank;				   ///< Position of the edge in the source list (used to keep the order stable).
+	parameterList *parameters; ///< Parameters of the edge (not copied).
+} indexedEdge;
+
+/**
+ * @brief Comparison function for qsort: orders edges by source, then target, then rank.
+ */
+static int compareIndexedEdges(const void *a, const void *b)
+{
+	const indexedEdge *e1 = (const indexedEdge *)a;
+	const indexedEdge *e2 = (const indexedEdge *)b;
+	if (e1->source != e2->source)
+		return e1->source < e2->source ? -1 : 1;
+	if (e1->target != e2->target)
+		return e1->target < e2->target ? -1 : 1;
+	return (e1->rank > e2->rank) - (e1->rank < e2->rank);
+}
+
+/**
+ * @brief Returns the index of the node @p name in @p res, using the node table of @p source if there is one.
+ */
+static int nodeIndex(Graph *res, GraphList source, char *name)
+{
+	if (source.node_table != NULL)
+		return node_table_find(source.node_table, name);
+	return findNode(res->nodes, res->numNodes, name);
+}
+
+/**
+ * @brief Fills the compressed sparse rows of @p res from the edges of @p source. If an edge appears several times, the parameters of the last one in the list are kept.
+ *
+ * @param res The graph to fill. Its nodes must already be set.
+ * @param source The GraphList whose edges are translated.
+ */
+static void fillEdges(Graph *res, GraphList source)
+{
+	int num_items = 0;
+	for (SEdgeList *explore = source.edges; explore != NULL; explore = explore->next)
+		num_items++;
+
+	int max_arcs = source.directed ? num_items : 2 * num_items;
+	indexedEdge *arcs = (indexedEdge *)malloc((max_arcs + 1) * sizeof(indexedEdge));
+	int num_arcs = 0;
+	int rank = 0;
+	for (SEdgeList *explore = source.edges; explore != NULL; explore = explore->next)
+	{
+		int n1 = nodeIndex(res, source, explore->node1);
+		int n2 = nodeIndex(res, source, explore->node2);
+		arcs[num_arcs++] = (indexedEdge){n1, n2, rank, explore->parameters};
+		if (!source.directed && n1 != n2)
+			arcs[num_arcs++] = (indexedEdge){n2, n1, rank, explore->parameters};
+		rank++;
+		res->numEdges++;
+	}
+
+	qsort(arcs, num_arcs, sizeof(indexedEdge), compareIndexedEdges);
+
+	res->edge_offsets = (int *)calloc(res->numNodes + 1, sizeof(int));
+	res->edge_targets = (int *)malloc((num_arcs + 1) * sizeof(int));
+	res->edge_parameters = (parameterList **)malloc((num_arcs + 1) * sizeof(parameterList *));
+
+	int count = 0;
+	for (int i = 0; i < num_arcs; i++)
+	{
+		if (i + 1 < num_arcs && arcs[i + 1].source == arcs[i].source && arcs[i + 1].target == arcs[i].target)
+			continue;
+		res->edge_targets[count] = arcs[i].target;
+		res->edge_parameters[count] = parameter_list_copy(arcs[i].parameters);
+		res->edge_offsets[arcs[i].source + 1]++;
+		count++;
+	}
+	for (int node = 0; node < res->numNodes; node++)
+		res->edge_offsets[node + 1] += res->edge_offsets[node];
+
+	free(arcs);
+}
+
 Graph createGraph(GraphList source)
 {
 	Graph res;
@@ -40,7 +125,6 @@ Graph createGraph(GraphList source)
 
 	// printf("nodes: %d\n",count);
 
-	res.edges = (bool *)malloc(res.numNodes * res.numNodes * sizeof(bool));
 	res.nodes = (char **)malloc(res.numNodes * sizeof(char *));
 
 	count = 0;
@@ -49,9 +133,6 @@ Graph createGraph(GraphList source)
 	// Paramètres
 
 	res.parameters = (parameterList **)malloc(res.numNodes * sizeof(parameterList *));
-	res.edge_parameters = (parameterList **)malloc(res.numNodes * res.numNodes * sizeof(parameterList *));
-	for (int i = 0; i < res.numNodes * res.numNodes; i++)
-		res.edge_parameters[i] = NULL;
 
 	while (explore != NULL)
 	{
@@ -66,26 +147,11 @@ Graph createGraph(GraphList source)
 		explore = explore->next;
 	}
 
-	for (int i = 0; i < res.numNodes; i++)
-		for (int j = 0; j < res.numNodes; j++)
-			res.edges[i * res.numNodes + j] = false;
+	fillEdges(&res, source);
 
-	SEdgeList *exploreBis = source.edges;
-	while (exploreBis != NULL)
-	{
-		int n1, n2;
-		n1 = findNode(res.nodes, res.numNodes, exploreBis->node1);
-		n2 = findNode(res.nodes, res.numNodes, exploreBis->node2);
-		res.edges[n1 * res.numNodes + n2] = true;
-		res.edge_parameters[n1 * res.numNodes + n2] = parameter_list_copy(exploreBis->parameters);
-		if (!source.directed)
-		{
-			res.edges[n2 * res.numNodes + n1] = true;
-			res.edge_parameters[n2 * res.numNodes + n1] = parameter_list_copy(exploreBis->parameters);
-		}
-		exploreBis = exploreBis->next;
-		res.numEdges++;
-	}
+	res.node_masks = NULL;
+	res.mapping = NULL;
+	res.mapping_size = 0;
 
 	return res;
-}
\ No newline at end of file
+}
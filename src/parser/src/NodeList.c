@@ -58,52 +58,46 @@ void addOrUpdateNode(char *n, SNodeList *list)
         return;
     }
 
-    if (strcmp(list->node, n) != 0)
+    while (strcmp(list->node, n) != 0)
     {
         if (list->next == NULL)
+        {
             list->next = addNode(n, NULL);
-        else
-            addOrUpdateNode(n, list->next);
-        return;
+            return;
+        }
+        list = list->next;
     }
-    return;
 }
 
 void add_parameters_to_node(char *node, parameterList *parameters, SNodeList *list)
 {
+    while (list != NULL && strcmp(node, list->node) != 0)
+        list = list->next;
     if (list == NULL)
         return;
-    if (strcmp(node, list->node) != 0)
-    {
-        add_parameters_to_node(node, parameters, list->next);
-        return;
-    }
     list->parameters = parameter_lists_merge(list->parameters, parameters);
 }
 
 void printNodeList(SNodeList *e)
 {
-    if (e == NULL)
-    {
-        printf("\n");
-        return;
-    }
-    printf("%s\n", e->node);
-    printNodeList(e->next);
+    for (; e != NULL; e = e->next)
+        printf("%s\n", e->node);
+    printf("\n");
 }
 
 void deleteNodeList(SNodeList *b)
 {
-    if (b == NULL)
-        return;
-
-    deleteNodeList(b->next);
+    while (b != NULL)
+    {
+        SNodeList *next = b->next;
 
-    free(b->node);
+        free(b->node);
 
-    parameter_list_delete(b->parameters);
+        parameter_list_delete(b->parameters);
 
-    free(b);
+        free(b);
+        b = next;
+    }
 }
 
 /* Testing main.
@@ -0,0 +1,133 @@
+/**
+ * @file NodeTable.c
+ * @brief  Open-addressing hash table associating the name of a node to its index in a node list.
+ * @version 1
+ * @date 2026-10-17
+ *
+ * @copyright Creative Commons.
+ *
+ */
+
+#include "NodeTable.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define INITIAL_CAPACITY 64
+
+/**
+ * @brief FNV-1a hash of a string.
+ */
+static uint32_t hashName(const char *name)
+{
+    uint32_t hash = 2166136261u;
+    for (const unsigned char *c = (const unsigned char *)name; *c != '\0'; c++)
+    {
+        hash ^= *c;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+/**
+ * @brief Returns the slot containing @p name in @p table, or the empty slot where it should be inserted.
+ */
+static int findSlot(NodeTable *table, const char *name)
+{
+    int mask = table->capacity - 1;
+    int slot = hashName(name) & mask;
+    while (table->keys[slot] != NULL && strcmp(table->keys[slot], name) != 0)
+        slot = (slot + 1) & mask;
+    return slot;
+}
+
+/**
+ * @brief Doubles the number of slots of @p table and reinserts every name.
+ */
+static void grow(NodeTable *table)
+{
+    char **old_keys = table->keys;
+    int *old_indices = table->indices;
+    int old_capacity = table->capacity;
+
+    table->capacity *= 2;
+    table->keys = (char **)calloc(table->capacity, sizeof(char *));
+    table->indices = (int *)malloc(table->capacity * sizeof(int));
+    for (int slot = 0; slot < old_capacity; slot++)
+    {
+        if (old_keys[slot] == NULL)
+            continue;
+        int new_slot = findSlot(table, old_keys[slot]);
+        table->keys[new_slot] = old_keys[slot];
+        table->indices[new_slot] = old_indices[slot];
+    }
+    free(old_keys);
+    free(old_indices);
+}
+
+NodeTable *node_table_create(void)
+{
+    NodeTable *table = (NodeTable *)malloc(sizeof(NodeTable));
+    table->capacity = INITIAL_CAPACITY;
+    table->size = 0;
+    table->keys = (char **)calloc(table->capacity, sizeof(char *));
+    table->indices = (int *)malloc(table->capacity * sizeof(int));
+    table->cells_capacity = INITIAL_CAPACITY;
+    table->cells = (SNodeList **)malloc(table->cells_capacity * sizeof(SNodeList *));
+    return table;
+}
+
+int node_table_find(NodeTable *table, const char *name)
+{
+    int slot = findSlot(table, name);
+    if (table->keys[slot] == NULL)
+        return -1;
+    return table->indices[slot];
+}
+
+int node_table_add_node(NodeTable *table, char *name, SNodeList **list)
+{
+    int slot = findSlot(table, name);
+    if (table->keys[slot] != NULL)
+        return table->indices[slot];
+
+    SNodeList *cell = addNode(name, NULL);
+    if (table->size == 0)
+        *list = cell;
+    else
+        table->cells[table->size - 1]->next = cell;
+
+    if (table->size == table->cells_capacity)
+    {
+        table->cells_capacity *= 2;
+        table->cells = (SNodeList **)realloc(table->cells, table->cells_capacity * sizeof(SNodeList *));
+    }
+    int index = table->size;
+    table->cells[index] = cell;
+    table->keys[slot] = cell->node;
+    table->indices[slot] = index;
+    table->size++;
+
+    if (2 * table->size > table->capacity)
+        grow(table);
+    return index;
+}
+
+void node_table_add_parameters(NodeTable *table, char *name, parameterList *parameters)
+{
+    int index = node_table_find(table, name);
+    if (index == -1)
+        return;
+    SNodeList *cell = table->cells[index];
+    cell->parameters = parameter_lists_merge(cell->parameters, parameters);
+}
+
+void node_table_delete(NodeTable *table)
+{
+    if (table == NULL)
+        return;
+    free(table->keys);
+    free(table->indices);
+    free(table->cells);
+    free(table);
+}
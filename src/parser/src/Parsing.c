@@ -17,8 +17,10 @@ GraphList getGraphList(const char *expr)
     yyscan_t scanner;
     YY_BUFFER_STATE state;
 
+    expression.name = NULL;
     expression.nodes = NULL;
     expression.edges = NULL;
+    expression.node_table = node_table_create();
 
     if (yylex_init(&scanner))
     {
@@ -33,6 +35,8 @@ GraphList getGraphList(const char *expr)
     {
         /* error parsing */
         printf("Error parsing\n");
+        yy_delete_buffer(state, scanner);
+        yylex_destroy(scanner);
         return expression;
     }
 
@@ -55,8 +59,10 @@ GraphList getGraphListFromFile(FILE *toRead)
     yyscan_t scanner;
     YY_BUFFER_STATE state;
 
+    expression.name = NULL;
     expression.nodes = NULL;
     expression.edges = NULL;
+    expression.node_table = node_table_create();
 
     if (yylex_init(&scanner))
     {
@@ -72,6 +78,9 @@ GraphList getGraphListFromFile(FILE *toRead)
     {
         /* error parsing */
         printf("Error parsing\n");
+        yy_delete_buffer(state, scanner);
+        yylex_destroy(scanner);
+        fclose(toRead);
         return expression;
     }
 
@@ -86,6 +95,8 @@ GraphList getGraphListFromFile(FILE *toRead)
 
 Graph get_graph_from_file(char *toRead)
 {
+    if (graph_is_snapshot(toRead))
+        return graph_load_snapshot(toRead);
     FILE *file = fopen(toRead, "r");
     if (file == NULL)
     {
@@ -96,5 +107,6 @@ Graph get_graph_from_file(char *toRead)
     Graph graph = createGraph(e);
     deleteExpression(e.edges);
     deleteNodeList(e.nodes);
+    node_table_delete(e.node_table);
     return graph;
 }